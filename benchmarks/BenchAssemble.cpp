@@ -0,0 +1,286 @@
+/*! \file    BenchAssemble.cpp
+ *  \brief   Micro-benchmarks of FIM assembling on a structured grid
+ *  \author  Shizhe Li
+ *  \date    Oct/16/2026
+ *
+ *-----------------------------------------------------------------------------------
+ *  Copyright (C) 2021--present by the OpenCAEPoroX team. All rights reserved.
+ *  Released under the terms of the GNU Lesser General Public License 3.0 or later.
+ *-----------------------------------------------------------------------------------
+ */
+
+// OpenCAEPoroX header files
+#include "../config/config.hpp"
+#include "BenchKernel.hpp"
+#include "OCPConvection.hpp"
+#include "OCPMatrix.hpp"
+#include "DenseMat.hpp"
+#include "FaspSolver.hpp"
+
+
+/// Bulks with random but consistent properties of np phases and nc components
+class BenchBulk : public Bulk
+{
+public:
+    void Setup(const OCP_USI& nb, const USI& np, const USI& nc, const USI& nz, mt19937& gen)
+    {
+        uniform_real_distribution<OCP_DBL> dist(0, 1);
+
+        const USI ncol   = nc + 1;
+        const USI ncol2  = np * nc + np;
+        vs.nb  = nb;
+        vs.nbI = nb;
+        vs.np  = np;
+        vs.nc  = nc;
+
+        vs.depth.resize(nb);
+        for (OCP_USI n = 0; n < nb; n++) vs.depth[n] = 8000 + 10.0 * (n % nz);
+
+        vs.phaseExist.resize(nb * np);
+        vs.xi.resize(nb * np);
+        vs.kr.resize(nb * np);
+        vs.mu.resize(nb * np);
+        vs.muP.resize(nb * np);
+        vs.xiP.resize(nb * np);
+        vs.rhoP.resize(nb * np);
+        for (OCP_USI n = 0; n < nb * np; n++) {
+            vs.phaseExist[n] = dist(gen) < 0.8;
+            vs.xi[n]         = 0.5 + 3 * dist(gen);
+            vs.kr[n]         = dist(gen);
+            vs.mu[n]         = 0.1 + dist(gen);
+            vs.muP[n]        = 1E-5 * dist(gen);
+            vs.xiP[n]        = 1E-4 * dist(gen);
+            vs.rhoP[n]       = 1E-3 * dist(gen);
+        }
+        vs.xij.resize(nb * np * nc);
+        vs.rhox.resize(nb * np * nc);
+        vs.xix.resize(nb * np * nc);
+        vs.mux.resize(nb * np * nc);
+        for (OCP_USI n = 0; n < nb * np * nc; n++) {
+            vs.xij[n]  = dist(gen) / nc;
+            vs.rhox[n] = dist(gen);
+            vs.xix[n]  = dist(gen);
+            vs.mux[n]  = 0.1 * dist(gen);
+        }
+        vs.dPcdS.resize(nb * np * np);
+        vs.dKrdS.resize(nb * np * np);
+        for (OCP_USI n = 0; n < nb * np * np; n++) {
+            vs.dPcdS[n] = -dist(gen);
+            vs.dKrdS[n] = dist(gen);
+        }
+        vs.dSec_dPri.resize(nb * ncol * ncol2);
+        for (auto& d : vs.dSec_dPri) d = dist(gen) - 0.5;
+    }
+};
+
+
+/// Connection with given transmissibility
+class BenchConnPair : public BulkConnPair
+{
+public:
+    BenchConnPair(const OCP_USI& b, const OCP_USI& e, const ConnDirect& d, const OCP_DBL& t)
+        : BulkConnPair(b, e, d, 1, 1, 1)
+    {
+        trans = t;
+    }
+};
+
+
+/// Domain of interior grids only, used to allocate OCPMatrix
+class BenchDomain : public Domain
+{
+public:
+    void Setup(const OCP_USI& nb, const vector<USI>& neighbor)
+    {
+        numElementLocal = nb;
+        numGridInterior = nb;
+        numGridGhost    = 0;
+        numGridLocal    = nb;
+        numWellLocal    = 0;
+        neighborNum     = neighbor;
+        wellWPB.clear();
+    }
+};
+
+
+#ifdef OCP_USE_FASP
+/// Expose the decoupling of VectorFaspSolver
+class BenchFaspSolver : public VectorFaspSolver
+{
+public:
+    BenchFaspSolver(const OCPMatrix& mat) : VectorFaspSolver("./", "bench.fasp", mat) {}
+    OCP_DBL Decouple(const int& type)
+    {
+        Decoupling(&A, &b, &Asc, &fsc, &order, Dmat.data(), type);
+        return Asc.val[0] + fsc.val[0];
+    }
+};
+#endif
+
+
+/// Kernels of np phases and nc components on a nx * ny * nz grid
+static void BenchAssembleKernels(BenchRunner& runner, const USI& nc)
+{
+    const USI     np = 3;
+    const USI     nz = 10;
+    const USI     nx = OCP_MAX(static_cast<USI>(sqrt(runner.GetParam().numCell / nz)), 1);
+    const USI     ny = nx;
+    const OCP_USI nb = static_cast<OCP_USI>(nx) * ny * nz;
+
+    const USI ncol   = nc + 1;
+    const USI ncol2  = np * nc + np;
+    const USI bsize  = ncol * ncol;
+    const USI bsize2 = ncol * ncol2;
+
+    mt19937                            gen(20231016 + nc);
+    uniform_real_distribution<OCP_DBL> dist(0, 1);
+
+    // grid ordered by z, then x, y; bId < eId for all connections
+    vector<BulkConnPair> conn;
+    vector<USI>          neighbor(nb, 1);
+    for (USI j = 0; j < ny; j++) {
+        for (USI i = 0; i < nx; i++) {
+            for (USI k = 0; k < nz; k++) {
+                const OCP_USI n = (static_cast<OCP_USI>(j) * nx + i) * nz + k;
+                if (k + 1 < nz) conn.push_back(BenchConnPair(n, n + 1, ConnDirect::z, dist(gen)));
+                if (i + 1 < nx) conn.push_back(BenchConnPair(n, n + nz, ConnDirect::x, dist(gen)));
+                if (j + 1 < ny) conn.push_back(BenchConnPair(n, n + nx * nz, ConnDirect::y, dist(gen)));
+            }
+        }
+    }
+    for (const auto& c : conn) {
+        neighbor[c.BId()]++;
+        neighbor[c.EId()]++;
+    }
+    const OCP_USI numConn = conn.size();
+
+    BenchBulk bk;
+    bk.Setup(nb, np, nc, nz, gen);
+    const BulkVarSet& bvs = bk.GetVarSet();
+
+    BulkConnVarSet bcvs;
+    bcvs.numConn = numConn;
+    bcvs.upblock.resize(numConn * np);
+    bcvs.dP.resize(numConn * np);
+    for (OCP_USI c = 0; c < numConn; c++) {
+        for (USI j = 0; j < np; j++) {
+            bcvs.dP[c * np + j]      = 20 * (dist(gen) - 0.5);
+            bcvs.upblock[c * np + j] = bcvs.dP[c * np + j] > 0 ? conn[c].BId() : conn[c].EId();
+        }
+    }
+
+    OCPConvection01 conv(np, nc);
+    FluxVarSet      fvs;
+    fvs.Allocate(np, nc, ncol, ncol2);
+
+    // Flux derivatives
+    runner.Run("OCPConvection01::AssembleMatFIM", nc, nb, [&]() {
+        OCP_DBL sum = 0;
+        for (OCP_USI c = 0; c < numConn; c++) {
+            fvs.SetZeroFIM();
+            conv.AssembleMatFIM(conn[c], c, bcvs, bk, fvs);
+            sum += fvs.dFdXpB[ncol] + fvs.dFdXsE[ncol2];
+        }
+        return sum;
+    });
+
+    // Elimination of secondary variables in both bulks of each connection
+    vector<OCP_DBL> bmat(bsize);
+    runner.Run("DaABpbC", nc, nb, [&]() {
+        OCP_DBL sum = 0;
+        for (OCP_USI c = 0; c < numConn; c++) {
+            bmat = fvs.dFdXpB;
+            DaABpbC(ncol, ncol, ncol2, 1.0, fvs.dFdXsB.data(), &bvs.dSec_dPri[conn[c].BId() * bsize2],
+                    1.0, bmat.data());
+            sum += bmat[ncol];
+            bmat = fvs.dFdXpE;
+            DaABpbC(ncol, ncol, ncol2, 1.0, fvs.dFdXsE.data(), &bvs.dSec_dPri[conn[c].EId() * bsize2],
+                    1.0, bmat.data());
+            sum += bmat[ncol];
+        }
+        return sum;
+    });
+
+    // Insertion of blocks into OCPMatrix
+    BenchDomain domain;
+    domain.Setup(nb, neighbor);
+    OCPMatrix mat;
+    mat.Allocate(domain, ncol);
+
+    vector<OCP_DBL> diag(bsize), offdiag(bsize);
+    for (USI i = 0; i < bsize; i++) {
+        diag[i]    = i % (ncol + 1) == 0 ? 10 + dist(gen) : dist(gen);
+        offdiag[i] = -dist(gen);
+    }
+    runner.Run("OCPMatrix", nc, nb, [&]() {
+        mat.ClearData();
+        mat.AddDim(nb);
+        for (OCP_USI n = 0; n < nb; n++) {
+            mat.NewDiag(n, diag);
+        }
+        for (const auto& c : conn) {
+            mat.AddDiag(c.BId(), offdiag);
+            mat.NewOffDiag(c.EId(), c.BId(), offdiag);
+            mat.NewOffDiag(c.BId(), c.EId(), offdiag);
+            mat.AddDiag(c.EId(), offdiag);
+        }
+        return mat.val[0][0] + mat.val[nb - 1].back();
+    });
+
+    // All above together, as in IsoT_FIM::AssembleMatBulks
+    runner.Run("AssembleMatBulks", nc, nb, [&]() {
+        mat.ClearData();
+        mat.AddDim(nb);
+        for (OCP_USI n = 0; n < nb; n++) {
+            mat.NewDiag(n, diag);
+        }
+        for (OCP_USI c = 0; c < numConn; c++) {
+            const OCP_USI bId = conn[c].BId();
+            const OCP_USI eId = conn[c].EId();
+            fvs.SetZeroFIM();
+            conv.AssembleMatFIM(conn[c], c, bcvs, bk, fvs);
+
+            bmat = fvs.dFdXpB;
+            DaABpbC(ncol, ncol, ncol2, 1.0, fvs.dFdXsB.data(), &bvs.dSec_dPri[bId * bsize2], 1.0,
+                    bmat.data());
+            mat.AddDiag(bId, bmat);
+            Dscalar(bsize, -1, bmat.data());
+            mat.NewOffDiag(eId, bId, bmat);
+
+            bmat = fvs.dFdXpE;
+            DaABpbC(ncol, ncol, ncol2, 1.0, fvs.dFdXsE.data(), &bvs.dSec_dPri[eId * bsize2], 1.0,
+                    bmat.data());
+            mat.NewOffDiag(bId, eId, bmat);
+            Dscalar(bsize, -1, bmat.data());
+            mat.AddDiag(eId, bmat);
+        }
+        return mat.val[0][0] + mat.val[nb - 1].back();
+    });
+
+#ifdef OCP_USE_FASP
+    // Decoupling of the matrix assembled above
+    for (OCP_USI n = 0; n < nb * ncol; n++) mat.b[n] = dist(gen);
+    BenchFaspSolver fasp(mat);
+    fasp.AssembleMat(mat, &domain);
+    for (int type = 1; type <= 10; type++) {
+        runner.Run("Decoupling" + to_string(type), nc, nb, [&]() { return fasp.Decouple(type); });
+    }
+#endif
+}
+
+
+void BenchAssemble(BenchRunner& runner)
+{
+    for (const auto& nc : runner.GetParam().numCom) {
+        BenchAssembleKernels(runner, nc);
+    }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*  Brief Change History of This File                                         */
+/*----------------------------------------------------------------------------*/
+/*  Author              Date             Actions                              */
+/*----------------------------------------------------------------------------*/
+/*  Shizhe Li           Oct/16/2026      Create file                          */
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,227 @@
+/*! \file    BenchKernel.cpp
+ *  \brief   Runner and synthetic inputs of micro-benchmarks
+ *  \author  Shizhe Li
+ *  \date    Oct/16/2026
+ *
+ *-----------------------------------------------------------------------------------
+ *  Copyright (C) 2021--present by the OpenCAEPoroX team. All rights reserved.
+ *  Released under the terms of the GNU Lesser General Public License 3.0 or later.
+ *-----------------------------------------------------------------------------------
+ */
+
+// Standard header files
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+// OpenCAEPoroX header files
+#include "BenchKernel.hpp"
+#include "UtilInput.hpp"
+#include "UtilTiming.hpp"
+
+
+void BenchParam::Input(const int& argc, const char* argv[])
+{
+    for (int n = 1; n < argc; n++) {
+        const string           tmp = argv[n];
+        const string::size_type pos = tmp.find_last_of('=');
+        if (pos == string::npos) OCP_ABORT("Unknown Usage! See -h");
+
+        const string key   = tmp.substr(0, pos);
+        const string value = tmp.substr(pos + 1);
+
+        switch (Map_Str2Int(&key[0], key.size())) {
+            case Map_Str2Int("nb", 2):
+                numCell = stoul(value);
+                break;
+
+            case Map_Str2Int("nc", 2):
+            {
+                numCom.clear();
+                stringstream ss(value);
+                string       s;
+                while (getline(ss, s, ',')) {
+                    numCom.push_back(stoi(s));
+                    if (numCom.back() < 2) OCP_ABORT("At least 2 components are required!");
+                }
+                break;
+            }
+
+            case Map_Str2Int("rep", 3):
+                numRep = OCP_MAX(stoi(value), 1);
+                break;
+
+            case Map_Str2Int("run", 3):
+                filter = value;
+                break;
+
+            case Map_Str2Int("csv", 3):
+                csvFile = value;
+                break;
+
+            default:
+                OCP_ABORT("Unknown param " + key + " in command line!");
+                break;
+        }
+    }
+}
+
+
+BenchRunner::BenchRunner(const BenchParam& pa) : param(pa)
+{
+    if (!param.csvFile.empty()) {
+        csv.open(param.csvFile);
+        if (!csv.is_open()) OCP_ABORT("Can not open " + param.csvFile);
+        csv << "kernel,nc,cells,ns_per_cell,checksum\n";
+    }
+
+    cout << setw(32) << left << "Kernel" << right << setw(6) << "NC" << setw(12) << "Cells"
+         << setw(14) << "ns/cell" << setw(20) << "Checksum" << endl;
+}
+
+
+BenchRunner::~BenchRunner()
+{
+    if (csv.is_open()) csv.close();
+}
+
+
+OCP_BOOL BenchRunner::IfRun(const string& name) const
+{
+    return param.filter.empty() || name.find(param.filter) != string::npos;
+}
+
+
+void BenchRunner::Run(const string& name, const USI& nc, const OCP_USI& ncell,
+                      const function<OCP_DBL()>& kernel)
+{
+    if (!IfRun(name)) return;
+
+    // warm up caches and allocations
+    const OCP_DBL checksum = kernel();
+
+    GetWallTime timer;
+    OCP_DBL     tmin = 1E20;
+    for (USI r = 0; r < param.numRep; r++) {
+        timer.Start();
+        kernel();
+        tmin = OCP_MIN(tmin, timer.Stop());
+    }
+    const OCP_DBL nsPerCell = tmin * 1E9 / ncell;
+
+    cout << setw(32) << left << name << right << setw(6) << nc << setw(12) << ncell
+         << fixed << setprecision(1) << setw(14) << nsPerCell << scientific
+         << setprecision(10) << setw(20) << checksum << defaultfloat << endl;
+
+    if (csv.is_open()) {
+        csv << name << "," << nc << "," << ncell << "," << nsPerCell << ","
+            << setprecision(16) << checksum << setprecision(6) << "\n";
+    }
+}
+
+
+/// Properties of the six components of SPE5: C1, C3, C6, C10, C15, C20
+static const vector<OCP_DBL> SPE5_TC { 343.0, 665.7, 913.4, 1111.8, 1270.0, 1380.0 };
+static const vector<OCP_DBL> SPE5_PC { 667.8, 616.3, 436.9, 304.0, 200.0, 162.0 };
+static const vector<OCP_DBL> SPE5_ZC { 0.290, 0.277, 0.264, 0.257, 0.245, 0.235 };
+static const vector<OCP_DBL> SPE5_MW { 16.04, 44.10, 86.18, 149.29, 206.00, 282.00 };
+static const vector<OCP_DBL> SPE5_ACF{ 0.013, 0.1524, 0.3007, 0.4885, 0.6500, 0.8500 };
+static const vector<OCP_DBL> SPE5_Z  { 0.50, 0.03, 0.07, 0.20, 0.15, 0.05 };
+
+
+/// Linear interpolation in the SPE5 table at s in [0, 5]
+static OCP_DBL InterpSPE5(const vector<OCP_DBL>& tab, const OCP_DBL& s)
+{
+    const USI     i = OCP_MIN(static_cast<USI>(s), 4);
+    const OCP_DBL w = s - i;
+    return (1 - w) * tab[i] + w * tab[i + 1];
+}
+
+
+BenchFluid::BenchFluid(const USI& ncin) : nc(ncin)
+{
+    param.Init();
+    param.NTPVT    = 1;
+    param.numCom   = nc;
+    param.numPhase = 2;
+
+    vector<OCP_DBL> Tc(nc), Pc(nc), Zc(nc), MW(nc), Acf(nc);
+    zRef.resize(nc);
+    OCP_DBL zt = 0;
+    for (USI i = 0; i < nc; i++) {
+        const OCP_DBL s = 5.0 * i / (nc - 1);
+        param.Cname.push_back("C" + to_string(i + 1));
+        Tc[i]   = InterpSPE5(SPE5_TC, s);
+        Pc[i]   = InterpSPE5(SPE5_PC, s);
+        Zc[i]   = InterpSPE5(SPE5_ZC, s);
+        MW[i]   = InterpSPE5(SPE5_MW, s);
+        Acf[i]  = InterpSPE5(SPE5_ACF, s);
+        zRef[i] = InterpSPE5(SPE5_Z, s);
+        zt     += zRef[i];
+    }
+    for (auto& z : zRef) z /= zt;
+
+    param.Tc.activity  = OCP_TRUE;
+    param.Pc.activity  = OCP_TRUE;
+    param.Zc.activity  = OCP_TRUE;
+    param.MW.activity  = OCP_TRUE;
+    param.Acf.activity = OCP_TRUE;
+    param.Tc.data.push_back(Tc);
+    param.Pc.data.push_back(Pc);
+    param.Zc.data.push_back(Zc);
+    param.MW.data.push_back(MW);
+    param.Acf.data.push_back(Acf);
+
+    // lower triangle of BIC, as in SPE5 the light ends interact with the heavy ends
+    vector<OCP_DBL> bic;
+    for (USI i = 1; i < nc; i++) {
+        const OCP_DBL s = 5.0 * i / (nc - 1);
+        for (USI j = 0; j < i; j++) {
+            const OCP_DBL sj = 5.0 * j / (nc - 1);
+            if (s >= 3 && sj < 1)       bic.push_back(0.05 * (1 - sj) + 0.005 * sj);
+            else                        bic.push_back(0.0);
+        }
+    }
+    param.BIC.push_back(bic);
+
+    // the same method params as the SPE5 deck
+    param.RRparam     = { "30", "1e-12" };
+    param.SSMparamSTA = { "100", "1e-12", "1e-8" };
+    param.NRparamSTA  = { "55", "1e-12" };
+    param.SSMparamSP  = { "100", "1e-6" };
+    param.NRparamSP   = { "55", "1e-12" };
+
+    // 160 F
+    T = 160 + 459.67;
+}
+
+
+void BenchStates(const BenchFluid& fluid, const OCP_USI& nb, mt19937& gen,
+                 vector<OCP_DBL>& P, vector<OCP_DBL>& z)
+{
+    const USI                          nc = fluid.nc;
+    uniform_real_distribution<OCP_DBL> distP(1000, 4000);
+    uniform_real_distribution<OCP_DBL> distZ(0.7, 1.3);
+
+    P.resize(nb);
+    z.resize(nb * nc);
+    for (OCP_USI n = 0; n < nb; n++) {
+        P[n]        = distP(gen);
+        OCP_DBL* zn = &z[n * nc];
+        OCP_DBL  zt = 0;
+        for (USI i = 0; i < nc; i++) {
+            zn[i] = fluid.zRef[i] * distZ(gen);
+            zt   += zn[i];
+        }
+        for (USI i = 0; i < nc; i++) zn[i] /= zt;
+    }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*  Brief Change History of This File                                         */
+/*----------------------------------------------------------------------------*/
+/*  Author              Date             Actions                              */
+/*----------------------------------------------------------------------------*/
+/*  Shizhe Li           Oct/16/2026      Create file                          */
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,112 @@
+/*! \file    BenchKernel.hpp
+ *  \brief   Runner and synthetic inputs of micro-benchmarks
+ *  \author  Shizhe Li
+ *  \date    Oct/16/2026
+ *
+ *  \note    Inputs are generated from fixed seeds, so the kernels see the same
+ *           data in every run and the checksums can be compared between builds
+ *
+ *-----------------------------------------------------------------------------------
+ *  Copyright (C) 2021--present by the OpenCAEPoroX team. All rights reserved.
+ *  Released under the terms of the GNU Lesser General Public License 3.0 or later.
+ *-----------------------------------------------------------------------------------
+ */
+
+#ifndef __BENCHKERNEL_HEADER__
+#define __BENCHKERNEL_HEADER__
+
+// Standard header files
+#include <functional>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+// OpenCAEPoroX header files
+#include "OCPConst.hpp"
+#include "ParamReservoir.hpp"
+
+using namespace std;
+
+
+/// Params of micro-benchmarks from command line
+class BenchParam
+{
+public:
+    /// Input params like nb=20000 nc=4,8,12 rep=5 run=EoS csv=bench.csv
+    void Input(const int& argc, const char* argv[]);
+
+public:
+    /// num of cells (or bulks) in each kernel
+    OCP_USI     numCell{ 20000 };
+    /// num of components tested
+    vector<USI> numCom{ 3, 6, 9, 12 };
+    /// num of timed repetitions, the fastest one is reported
+    USI         numRep{ 5 };
+    /// only kernels whose name contains filter are run
+    string      filter;
+    /// csv file of results, empty if not required
+    string      csvFile;
+};
+
+
+/// Time kernels and report ns per cell
+class BenchRunner
+{
+public:
+    BenchRunner(const BenchParam& param);
+    ~BenchRunner();
+    /// Run kernel (once for warm-up, then numRep times), it returns a checksum of its
+    /// results so that it can not be optimized away
+    void Run(const string& name, const USI& nc, const OCP_USI& ncell,
+             const function<OCP_DBL()>& kernel);
+    /// If the kernel is selected by filter
+    OCP_BOOL IfRun(const string& name) const;
+    /// Return params
+    const BenchParam& GetParam() const { return param; }
+
+protected:
+    const BenchParam& param;
+    ofstream          csv;
+};
+
+
+/// A synthetic hydrocarbon fluid with nc components, whose properties are
+/// interpolated from the six components of SPE5
+class BenchFluid
+{
+public:
+    BenchFluid(const USI& nc);
+
+public:
+    /// num of hydrocarbon components
+    USI             nc;
+    /// component params used to set up EoS, flash and viscosity
+    ComponentParam  param;
+    /// reference composition
+    vector<OCP_DBL> zRef;
+    /// reservoir temperature, R
+    OCP_DBL         T;
+};
+
+
+/// nb states (P, z) around the reference composition of fluid
+void BenchStates(const BenchFluid& fluid, const OCP_USI& nb, mt19937& gen,
+                 vector<OCP_DBL>& P, vector<OCP_DBL>& z);
+
+
+/// Kernels of components and phases: EoS, flash, Rachford-Rice, viscosity, table
+void BenchMixture(BenchRunner& runner);
+/// Kernels of assembling: flux derivatives, DaABpbC, OCPMatrix, decoupling
+void BenchAssemble(BenchRunner& runner);
+
+
+#endif /* end if __BENCHKERNEL_HEADER__ */
+
+/*----------------------------------------------------------------------------*/
+/*  Brief Change History of This File                                         */
+/*----------------------------------------------------------------------------*/
+/*  Author              Date             Actions                              */
+/*----------------------------------------------------------------------------*/
+/*  Shizhe Li           Oct/16/2026      Create file                          */
+/*----------------------------------------------------------------------------*/
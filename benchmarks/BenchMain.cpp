@@ -0,0 +1,65 @@
+/*! \file    BenchMain.cpp
+ *  \brief   Micro-benchmarks of physics and assembling kernels
+ *  \author  Shizhe Li
+ *  \date    Oct/16/2026
+ *
+ *-----------------------------------------------------------------------------------
+ *  Copyright (C) 2021--present by the OpenCAEPoroX team. All rights reserved.
+ *  Released under the terms of the GNU Lesser General Public License 3.0 or later.
+ *-----------------------------------------------------------------------------------
+ */
+
+// Standard header files
+#include <cstring>
+#include <iostream>
+#include <mpi.h>
+
+// OpenCAEPoroX header files
+#include "BenchKernel.hpp"
+#include "OCPUnits.hpp"
+#include "UtilOutput.hpp"
+
+using namespace std;
+
+/// Run the kernels on synthetic inputs in a single process and print ns per cell.
+/// Params: nb=20000 nc=3,6,9,12 rep=5 run=<substring of kernel> csv=<file>
+int main(int argc, char* argv[])
+{
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &CURRENT_RANK);
+
+    if (argc > 1 && (!strcmp(argv[1], "-h") || !strcmp(argv[1], "--help"))) {
+        cout << "Usage: " << endl
+             << "  " << argv[0] << " [nb=20000] [nc=3,6,9,12] [rep=5] [run=Kernel] [csv=File]" << endl
+             << "         nb = num of cells in each kernel" << endl
+             << "         nc = num of components tested" << endl
+             << "        rep = num of timed repetitions, the fastest one is reported" << endl
+             << "        run = only kernels whose name contains it are run" << endl
+             << "        csv = results are also written to File" << endl;
+        MPI_Finalize();
+        return OCP_SUCCESS;
+    }
+
+    BenchParam param;
+    param.Input(argc, const_cast<const char**>(argv));
+
+    // Synthetic inputs are in field units
+    SetUnit("FIELD");
+
+    if (CURRENT_RANK == MASTER_PROCESS) {
+        BenchRunner runner(param);
+        BenchMixture(runner);
+        BenchAssemble(runner);
+    }
+
+    MPI_Finalize();
+    return OCP_SUCCESS;
+}
+
+/*----------------------------------------------------------------------------*/
+/*  Brief Change History of This File                                         */
+/*----------------------------------------------------------------------------*/
+/*  Author              Date             Actions                              */
+/*----------------------------------------------------------------------------*/
+/*  Shizhe Li           Oct/16/2026      Create file                          */
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,242 @@
+/*! \file    BenchMixture.cpp
+ *  \brief   Micro-benchmarks of EoS, phase equilibrium, viscosity and tables
+ *  \author  Shizhe Li
+ *  \date    Oct/16/2026
+ *
+ *-----------------------------------------------------------------------------------
+ *  Copyright (C) 2021--present by the OpenCAEPoroX team. All rights reserved.
+ *  Released under the terms of the GNU Lesser General Public License 3.0 or later.
+ *-----------------------------------------------------------------------------------
+ */
+
+// OpenCAEPoroX header files
+#include "BenchKernel.hpp"
+#include "OCPEoS.hpp"
+#include "OCPPhaseEquilibrium.hpp"
+#include "OCPFuncPVT.hpp"
+#include "OCPTable.hpp"
+
+
+/// Expose the stages of OCPPhaseEquilibrium to be timed separately
+class BenchPhaseEquilibrium : public OCPPhaseEquilibrium
+{
+public:
+    /// Stability analysis of single phase
+    OCP_BOOL Stable(const OCP_DBL& Pin, const OCP_DBL& Tin, const OCP_DBL* ziin)
+    {
+        SetInitalValue(Pin, Tin, ziin, 0, 0, nullptr, 0);
+        NP    = 1;
+        nu[0] = 1;
+        x[0]  = zi;
+        CalKwilson();
+        return PhaseStable();
+    }
+    /// Two-phase splitting started from Wilson's K
+    void Split(const OCP_DBL& Pin, const OCP_DBL& Tin, const OCP_DBL* ziin)
+    {
+        SetInitalValue(Pin, Tin, ziin, 2, 0, nullptr, 0);
+        NP = 2;
+        Yt = 1.01;
+        CalKwilson();
+        PhaseSplit();
+    }
+    /// Solve Rachford-Rice equation with given K
+    void RachfordRice(const OCP_DBL* ziin, const OCP_DBL* K)
+    {
+        copy(ziin, ziin + NC, zi.begin());
+        copy(K, K + NC, Ks[0].begin());
+        NP = 2;
+        RachfordRice2();
+        UpdateXRR();
+    }
+};
+
+
+/// LBC viscosity is timed directly, ViscosityMethod02 is timed with coefficients
+/// of heavy oil
+static void BenchViscosity(BenchRunner& runner, const BenchFluid& fluid, const vector<OCP_DBL>& P,
+                           const vector<OCP_DBL>& z, const EoS_PR& eos)
+{
+    const USI     nc = fluid.nc;
+    const OCP_USI nb = P.size();
+    const OCP_DBL T  = fluid.T;
+
+    vector<OCP_DBL> xi(nb);
+    for (OCP_USI n = 0; n < nb; n++) {
+        xi[n] = 1 / eos.CalVm(P[n], T, &z[n * nc]);
+    }
+    vector<OCP_DBL> xix(nc, 0.01);
+    vector<OCP_DBL> mux(nc);
+    const OCP_DBL   xiP = 1E-4, xiT = -1E-4;
+
+    ViscosityMethod03 lbc(fluid.param, 0);
+    runner.Run("ViscosityLBC", nc, nb, [&]() {
+        OCP_DBL sum = 0;
+        for (OCP_USI n = 0; n < nb; n++) {
+            sum += lbc.CalViscosity(ViscosityParams(&P[n], &T, &z[n * nc], &xi[n]));
+        }
+        return sum;
+    });
+    runner.Run("ViscosityLBCDer", nc, nb, [&]() {
+        OCP_DBL sum = 0, muP, muT;
+        for (OCP_USI n = 0; n < nb; n++) {
+            sum += lbc.CalViscosity(ViscosityParams(&P[n], &T, &z[n * nc], &xi[n], &xiP, &xiT, &xix[0]),
+                                    muP, muT, &mux[0]);
+            sum += muP + mux[0];
+        }
+        return sum;
+    });
+
+    vector<OCP_DBL> av(nc), bv(nc);
+    for (USI i = 0; i < nc; i++) {
+        av[i] = 1E-3 * (1 + i);
+        bv[i] = 2000 + 300 * i;
+    }
+    ViscosityMethod02 corr(av, bv);
+    runner.Run("ViscosityCorrDer", nc, nb, [&]() {
+        OCP_DBL sum = 0, muP, muT;
+        for (OCP_USI n = 0; n < nb; n++) {
+            sum += corr.CalViscosity(ViscosityParams(&P[n], &T, &z[n * nc]), muP, muT, &mux[0]);
+            sum += muT;
+        }
+        return sum;
+    });
+}
+
+
+/// Kernels of a fluid with nc components
+static void BenchFluidKernels(BenchRunner& runner, const USI& nc)
+{
+    const OCP_USI nb = runner.GetParam().numCell;
+
+    BenchFluid      fluid(nc);
+    mt19937         gen(20231016 + nc);
+    vector<OCP_DBL> P, z;
+    BenchStates(fluid, nb, gen, P, z);
+    const OCP_DBL T = fluid.T;
+
+    EoS_PR eos(fluid.param, 0);
+    EoSCalculation eosCal;
+    eosCal.Setup(fluid.param, 0);
+
+    // EoS
+    vector<OCP_DBL> fug(nc), phi(nc), lnfugn(nc * nc);
+    runner.Run("EoS_PR::CalFugPhi", nc, nb, [&]() {
+        OCP_DBL sum = 0;
+        for (OCP_USI n = 0; n < nb; n++) {
+            eos.CalFugPhi(P[n], T, &z[n * nc], &fug[0], &phi[0]);
+            sum += phi[0];
+        }
+        return sum;
+    });
+    runner.Run("EoS_PR::CalLnFugN", nc, nb, [&]() {
+        OCP_DBL sum = 0;
+        for (OCP_USI n = 0; n < nb; n++) {
+            eos.CalLnFugN(P[n], T, &z[n * nc], 1.0, &lnfugn[0]);
+            sum += lnfugn[0];
+        }
+        return sum;
+    });
+
+    // Phase equilibrium
+    BenchPhaseEquilibrium pe;
+    pe.Setup(fluid.param, 0, &eosCal);
+
+    runner.Run("PhaseEquilibrium", nc, nb, [&]() {
+        OCP_DBL sum = 0;
+        for (OCP_USI n = 0; n < nb; n++) {
+            pe.PhaseEquilibrium(P[n], T, &z[n * nc]);
+            sum += pe.GetNP() + pe.GetNu(0);
+        }
+        return sum;
+    });
+    runner.Run("PhaseStable", nc, nb, [&]() {
+        OCP_DBL sum = 0;
+        for (OCP_USI n = 0; n < nb; n++) {
+            sum += pe.Stable(P[n], T, &z[n * nc]);
+        }
+        return sum;
+    });
+
+    // Splitting and RR are timed in two-phase states only, K of RR is the converged one
+    vector<OCP_DBL> P2, z2, K2;
+    for (OCP_USI n = 0; n < nb; n++) {
+        pe.PhaseEquilibrium(P[n], T, &z[n * nc]);
+        if (pe.GetNP() != 2) continue;
+        P2.push_back(P[n]);
+        z2.insert(z2.end(), &z[n * nc], &z[n * nc] + nc);
+        for (USI i = 0; i < nc; i++) K2.push_back(pe.GetX(0)[i] / pe.GetX(1)[i]);
+    }
+    const OCP_USI nb2 = P2.size();
+    if (nb2 > 0) {
+        runner.Run("PhaseSplit", nc, nb2, [&]() {
+            OCP_DBL sum = 0;
+            for (OCP_USI n = 0; n < nb2; n++) {
+                pe.Split(P2[n], T, &z2[n * nc]);
+                sum += pe.GetNu(0);
+            }
+            return sum;
+        });
+        runner.Run("RachfordRice2", nc, nb2, [&]() {
+            OCP_DBL sum = 0;
+            for (OCP_USI n = 0; n < nb2; n++) {
+                pe.RachfordRice(&z2[n * nc], &K2[n * nc]);
+                sum += pe.GetNu(0);
+            }
+            return sum;
+        });
+    }
+
+    BenchViscosity(runner, fluid, P, z, eos);
+}
+
+
+/// Kernel of tables: saturation table with 4 columns
+static void BenchTable(BenchRunner& runner)
+{
+    const OCP_USI nb   = runner.GetParam().numCell;
+    const USI     nrow = 50;
+
+    vector<vector<OCP_DBL>> tab(4, vector<OCP_DBL>(nrow));
+    for (USI r = 0; r < nrow; r++) {
+        const OCP_DBL s = 0.2 + 0.6 * r / (nrow - 1);
+        tab[0][r]       = s;
+        tab[1][r]       = pow((s - 0.2) / 0.6, 2);
+        tab[2][r]       = pow((0.8 - s) / 0.6, 2);
+        tab[3][r]       = 4 * (0.8 - s);
+    }
+    OCPTable table(tab);
+
+    mt19937                            gen(20231016);
+    uniform_real_distribution<OCP_DBL> dist(0.15, 0.85);
+    vector<OCP_DBL>                    val(nb);
+    for (auto& v : val) v = dist(gen);
+
+    vector<OCP_DBL> out(4), slope(4);
+    runner.Run("OCPTable::Eval_All", 0, nb, [&]() {
+        OCP_DBL sum = 0;
+        for (OCP_USI n = 0; n < nb; n++) {
+            table.Eval_All(0, val[n], out, slope);
+            sum += out[1] + slope[2];
+        }
+        return sum;
+    });
+}
+
+
+void BenchMixture(BenchRunner& runner)
+{
+    BenchTable(runner);
+    for (const auto& nc : runner.GetParam().numCom) {
+        BenchFluidKernels(runner, nc);
+    }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*  Brief Change History of This File                                         */
+/*----------------------------------------------------------------------------*/
+/*  Author              Date             Actions                              */
+/*----------------------------------------------------------------------------*/
+/*  Shizhe Li           Oct/16/2026      Create file                          */
+/*----------------------------------------------------------------------------*/
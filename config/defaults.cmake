@@ -15,6 +15,23 @@ option(OCP_USE_FASP "Enable FASP usage" OFF)
 option(OCP_USE_FASP4BLKOIL "Enable PETSC_SOLVER usage" OFF)
 
 option(OCP_ENABLE_TESTING "Enable the ctest framework for testing" OFF)
+option(OCP_BUILD_BENCHMARKS "Build micro-benchmarks of kernels" OFF)
+option(OCP_ENABLE_PERF_TESTING "Add performance regression tests of the SPE cases to ctest" OFF)
+
+# Performance regression: decks (relative to data/), num of processes, extra
+# command line params, where baselines are stored, and tolerances of checkOCPPerf.
+# Only the default cases have baselines in data/perfBaseline, others must be
+# recorded once with OCP_PERF_UPDATE.
+set(OCP_PERF_CASES "spe1a/spe1a.data" CACHE STRING "Decks of performance regression tests.")
+set(OCP_PERF_NPROCS "1" CACHE STRING "Num of processes of performance regression tests.")
+option(OCP_PERF_UPDATE "Record the baselines instead of checking against them" OFF)
+option(OCP_PERF_CHECK_TIME "Also check wall time against the baselines, which needs a quiet machine" OFF)
+set(OCP_PERF_ARGS "" CACHE STRING "Extra command line params of performance regression runs.")
+set(OCP_PERF_BASELINE_DIR "${CMAKE_CURRENT_SOURCE_DIR}/data/perfBaseline"
+    CACHE PATH "Path to the baselines of performance regression tests.")
+set(OCP_PERF_TOL_TIME "0.10" CACHE STRING "Relative increase of wall time allowed.")
+set(OCP_PERF_TOL_ITER "0.05" CACHE STRING "Relative increase of iteration counts allowed.")
+set(OCP_PERF_TOL_VALUE "1e-4" CACHE STRING "Relative difference of final values allowed.")
 
 
 set(MPI_ROOT "" CACHE PATH "Path to the MPI library.")
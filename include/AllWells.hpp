@@ -67,6 +67,7 @@ class AllWells
     friend class IsoT_IMPEC;
     friend class IsoT_AIMc;
     friend class IsoT_FIMddm;
+    friend class IsoT_SFI;
     friend class T_FIM;
 
 public:
@@ -107,6 +108,15 @@ public:
     }
     /// Check if unreasonable well pressure or perforation pressure occurs.
     ReservoirState CheckP(const Bulk& bk);
+    /// Get well pressures of a Newton iterate
+    void GetBHP(vector<OCP_DBL>& p) const {
+        p.resize(numWell);
+        for (USI w = 0; w < numWell; w++) p[w] = wells[w]->bhp;
+    }
+    /// Set well pressures of a Newton iterate, p0 is that at last NR step
+    void SetBHP(const vector<OCP_DBL>& p, const vector<OCP_DBL>& p0) {
+        for (USI w = 0; w < numWell; w++) wells[w]->SetBHP(p[w], p0[w]);
+    }
     /// Return the num of wells.
     USI GetWellNum() const { return numWell; }
     /// Return the name of specified well.
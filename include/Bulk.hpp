@@ -85,7 +85,9 @@ class Bulk
     friend class IsoT_FIM;
     friend class IsoT_AIMc;
     friend class IsoT_FIMddm;
+    friend class IsoT_SFI;
     friend class T_FIM;
+    friend class OCPNRsuite;
 
     /////////////////////////////////////////////////////////////////////
     // Input Param and Setup
@@ -154,6 +156,8 @@ public:
 
     /// Output iterations in MixtureUnit
     void OutMixtureIters() const { PVTm.OutputIters(0); }
+    /// Return the flash cost of bulks
+    const FlashCost& GetFlashCost() const { return optMs.GetFlashCost(); }
 
 
     /////////////////////////////////////////////////////////////////////
@@ -203,6 +207,8 @@ public:
 public:
     /// push back an element for wellBulkId
     void AddWellBulkId(const OCP_USI& n) { wellBulkId.push_back(n); }
+    /// clear wellBulkId
+    void ClearWellBulkId() { wellBulkId.clear(); }
 
 protected:
     vector<OCP_USI> wellBulkId; ///< Index of bulks which are penetrated by wells and
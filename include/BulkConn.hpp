@@ -32,6 +32,7 @@ class BulkConn
     friend class IsoT_IMPEC;
     friend class IsoT_AIMc;
     friend class IsoT_FIMddm;
+    friend class IsoT_SFI;
     friend class T_FIM;
 
 public:
@@ -51,6 +52,11 @@ public:
     auto& GetVarSet() const { return vs; }
     /// Get num of connection
     auto GetNumConn() const { return numConn; }
+    /// Sort connections in ascending order of bId, then eId (used after bulks are renumbered)
+    void SortConn() {
+        sort(iteratorConn.begin(), iteratorConn.end(), [](const BulkConnPair& a, const BulkConnPair& b) {
+            return a.BId() < b.BId() || (a.BId() == b.BId() && a.EId() < b.EId()); });
+    }
     /// Calculate flux coefficients
     void CalFluxCoeff(const Bulk& bk) {
         for (OCP_USI c = 0; c < numConn; c++) {
@@ -122,6 +122,8 @@ public:
         dFdXpE.resize(ncol1 * ncol1);
         dFdXsB.resize(ncol1 * ncol2);
         dFdXsE.resize(ncol1 * ncol2);
+        dVdXsB.resize(ncol2);
+        dVdXsE.resize(ncol2);
     }
     void SetZeroFluxNi() {
         fill(flux_ni.begin(), flux_ni.end(), 0.0);
@@ -159,6 +161,10 @@ public:
     vector<OCP_DBL>  dFdXsB;
     /// dF / dXs for eId bulk
     vector<OCP_DBL>  dFdXsE;
+    /// dV / dXs for bId bulk, V is the total volume flow rate, for SFI
+    vector<OCP_DBL>  dVdXsB;
+    /// dV / dXs for eId bulk, V is the total volume flow rate, for SFI
+    vector<OCP_DBL>  dVdXsE;
 
     // for IMPEC
     /// val in b-b, -val in b-e
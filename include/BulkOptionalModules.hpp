@@ -16,6 +16,7 @@
 #include "OCPMiscible.hpp"
 #include "OCPScalePcow.hpp"
 #include "HeatConduct.hpp"
+#include "OCPFlashCost.hpp"
 
 class BulkOptionalModules
 {
@@ -79,6 +80,18 @@ protected:
     MiscibleCurve  misCur;
     /// Scale water-oil capillary pressure
     ScalePcow      scalePcow;
+
+    /////////////////////////////////////////////////////////////////////
+    // Statistics
+    /////////////////////////////////////////////////////////////////////
+
+public:
+    /// Return the flash cost of bulks
+    const FlashCost& GetFlashCost() const { return flashCost; }
+
+protected:
+    /// Flash cost, used for the graph partition
+    FlashCost      flashCost;
 };
 
 #endif /* end if __BulkOptionalFeatures_HEADER__ */
@@ -46,6 +46,16 @@ public:
                                  const OCP_DBL& flag = 1);
 };
 
+/// Intersection of a face and the face of its neighboring block
+class FaceIntersect
+{
+public:
+    OCP_BOOL       flagQuad;
+    OCP_BOOL       upNNC, downNNC;
+    OCP_BOOL       flagJump;
+    HexahedronFace interFace;
+};
+
 /// General connection
 class GeneralConnect
 {
@@ -68,9 +78,11 @@ public:
     OCP_BOOL InputZCORNDATA(const vector<OCP_DBL>& zcorn);
     // New version
     void SetupCornerPoints();
-    void SetAllFlags(const HexahedronFace& oFace, const HexahedronFace& Face);
+    void SetAllFlags(const HexahedronFace& oFace, const HexahedronFace& Face, FaceIntersect& fi) const;
+    /// Return the index of half connection of neighbor paired with halfConn[j] of block n, -1 if none
+    OCP_INT FindPairConn(const vector<ConnGrid>& blockconn, const OCP_ULL& n, const USI& j) const;
     // functions
-    OCP_DBL OCP_SIGN(const OCP_DBL& x) { return x >= 0 ? 1 : -1; }
+    OCP_DBL OCP_SIGN(const OCP_DBL& x) const { return x >= 0 ? 1 : -1; }
 
 private:
     USI           nx;
@@ -91,12 +103,10 @@ private:
     vector<Point3D> center;
 
     vector<GeneralConnect> connect;
+    /// connect[connBegin[n], connBegin[n+1]) begin from grid n
+    vector<OCP_ULL>        connBegin;
 
     // Auxiliary variables
-    OCP_BOOL       flagQuad;
-    OCP_BOOL       upNNC, downNNC;
-    OCP_BOOL       flagJump;
-    HexahedronFace interFace;
     // after the Axes are determined, blocks will be placed along the y+, or along the
     // y-. if y+, then flagForward equals 1.0, else -1.0, this relates to calculation of
     // area normal vector
@@ -53,6 +53,10 @@ class Domain
 
 public:
 	void Setup(const Partition& part, const PreParamGridWell& gridwell);
+	/// Set if interior grids are renumbered by reverse Cuthill-McKee
+	void SetReorderRCM(const OCP_BOOL& flag) { reorderRCM = flag; }
+	/// Return if interior grids are renumbered
+	auto IfReordered() const { return reorderRCM; }
 	auto GetNumGridTotal() const { return numElementTotal - numWellTotal; }
 	auto GetNumGridInterior() const { return numGridInterior; }
 	auto GetWell() const { return well; }
@@ -60,6 +64,8 @@ public:
 
 protected:
 	void InitComm(const Partition& part);
+	/// Renumber interior grids by reverse Cuthill-McKee, adj is the graph of interior grids
+	void ReorderInteriorRCM(const vector<vector<OCP_USI>>& adj, vector<OCP_USI>& old2new);
 
 	// for global communication
 public:
@@ -122,6 +128,8 @@ protected:
 	vector<USI>             neighborNum; 
 	/// initial global index -> local index (interior grid & ghost grid)
 	unordered_map<OCP_ULL, OCP_USI>   init_global_to_local;
+	/// if interior grids are renumbered, the permutation is kept in grid
+	OCP_BOOL                          reorderRCM{ OCP_FALSE };
 
 
 	////////////////////////////////////////
@@ -135,7 +143,10 @@ public:
 	// Tacit Communication (Prefered, Local Index)
 	////////////////////////////////////////
 
-	map<OCP_INT, set<OCP_USI>>    send_element_loc;
+	/// local index of elements to be sent, in ascending order of global index
+	map<OCP_INT, vector<OCP_USI>> send_element_loc;
+	/// local index of elements to be sent, for lookup
+	map<OCP_INT, set<OCP_USI>>    send_element_set;
 	map<OCP_INT, vector<OCP_USI>> recv_element_loc;
 
 	mutable vector<MPI_Request>  send_request;
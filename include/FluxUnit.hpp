@@ -84,6 +84,20 @@ public:
         fluxvs.SetZeroIMPEC();
         convect->AssembleMatIMPEC(bp, c, bcvs, bk, fluxvs);
     }
+    /// Calculate flux of components and phases with total volume flow rate fixed at vT for SFI
+    void CalFluxSFI(const BulkConnPair& bp, const Bulk& bk, const OCP_DBL& vT) const {
+        fluxvs.SetZeroFluxNi();
+        convect->CalFluxSFI(bp, bk, vT, fluxvs);
+        diffusion->CalFlux(bp, bk.GetVarSet(), fluxvs);
+        heatConduct->CalFlux(bp, bk.GetVarSet());
+    }
+    /// Assemble matrix for transport of SFI
+    void AssembleMatSFI(const BulkConnPair& bp, const OCP_USI& c, const BulkConnVarSet& bcvs, const Bulk& bk) const {
+        fluxvs.SetZeroFIM();
+        convect->AssembleMatSFI(bp, c, bcvs, bk, fluxvs);
+        diffusion->AssembleMatFIM(bp, bk.GetVarSet(), fluxvs);
+        heatConduct->AssembleMatFIM(bp, bk.GetVarSet(), fluxvs);
+    }
 
 
     const vector<OCP_USI>& GetConvectUpblock() const { return convect->GetUpblock(); }
@@ -27,6 +27,8 @@ class IsothermalMethod
 public:
     /// Calculate rock
     void CalRock(Bulk& bk) const;
+    /// Calculate rock for bulks in bList
+    void CalRock(Bulk& bk, const vector<OCP_USI>& bList) const;
     /// Get NRsuite
     const OCPNRsuite& GetNRsuite() const { return NR; }
     virtual void ExchangeSolutionP(Reservoir& rs) const;
@@ -83,6 +85,20 @@ private:
     void CalBulkFlux(Reservoir& rs) const;
     /// Update mole composition of each bulk according to mass conservation for IMPEC
     void MassConserve(Reservoir& rs, const OCP_DBL& dt) const;
+    /// Select bulks and connections which take transport sub-steps in multirate IMPEC
+    void SetMultirateBulk(Reservoir& rs);
+    /// Transport in nsub sub-steps, only bulks limited by CFL and their neighbors
+    /// are updated in each sub-step
+    OCP_BOOL TransportMultirate(Reservoir& rs, OCPControl& ctrl, const USI& nsub);
+    /// Perform Flash with Ni for bulks in bList
+    void CalFlash(Bulk& bk, const vector<OCP_USI>& bList);
+    /// Calculate relative permeability and capillary pressure for bulks in bList
+    void CalKrPc(Bulk& bk, const vector<OCP_USI>& bList) const;
+    /// Calculate flux of connections in cList
+    void CalBulkFlux(Reservoir& rs, const vector<OCP_USI>& cList) const;
+    /// Update Ni with flux of connections in cList, and of wells if ifWell
+    void MassConserve(Reservoir& rs, const OCP_DBL& dt, const vector<OCP_USI>& cList,
+                      const OCP_BOOL& ifWell) const;
     /// Assemble linear system for bulks
     void AssembleMatBulks(LinearSystem& ls, const Reservoir& rs, const OCP_DBL& dt) const;
     /// Assemble linear system for wells
@@ -94,6 +110,16 @@ private:
     void ResetToLastTimeStep02(Reservoir& rs, OCPControl& ctrl);
     /// Update values of last step for FIM.
     void UpdateLastTimeStep(Reservoir& rs) const;
+
+private:
+    /// If bulks take transport sub-steps in multirate IMPEC
+    vector<OCP_BOOL> mrSub;
+    /// Bulks which take transport sub-steps
+    vector<OCP_USI>  mrBulk;
+    /// Connections whose flux is updated in each transport sub-step
+    vector<OCP_USI>  mrConnFast;
+    /// Connections whose flux is used for the whole time step
+    vector<OCP_USI>  mrConnSlow;
 };
 
 /// IsoT_FIM is FIM (Fully Implicit Method).
@@ -107,7 +133,7 @@ public:
     /// Init
     void InitReservoir(Reservoir& rs);
     /// Prepare for Assembling matrix.
-    void Prepare(Reservoir& rs, const OCP_DBL& dt);
+    void Prepare(Reservoir& rs, const OCPControl& ctrl);
     /// Assemble Matrix
     void AssembleMat(LinearSystem& ls, const Reservoir& rs, const OCP_DBL& dt) const;
     /// Solve the linear system.
@@ -118,8 +144,8 @@ public:
     OCP_BOOL FinishNR(Reservoir& rs, OCPControl& ctrl);
     /// Finish a time step.
     void FinishStep(Reservoir& rs, OCPControl& ctrl);
-    /// Transfer to FIM method
-    OCP_BOOL TransferToFIM(const OCP_DBL& global_res0, Reservoir& rs, OCPControl& ctrl);
+    /// Transfer to FIM method, iterations are counted from here if initIter
+    OCP_BOOL TransferToFIM(const OCP_DBL& global_res0, Reservoir& rs, OCPControl& ctrl, const OCP_BOOL& initIter);
 
 
 protected:
@@ -141,16 +167,51 @@ protected:
     void ResetToLastTimeStep(Reservoir& rs, OCPControl& ctrl);
     /// Update values of last step for FIM.
     void UpdateLastTimeStep(Reservoir& rs) const;
+    /// Update properties needed by residual only, used by trial iterates of line search
+    void UpdatePropertyRes(Reservoir& rs, const OCP_DBL& dt);
+    /// Perform Flash with Ni without derivatives
+    void CalFlashRes(Bulk& bk);
+    /// Perform Flash with Ni and calculate values needed for FIM
+    void CalFlash(Bulk& bk);
+    /// Update P, Ni, BHP after linear system is solved
+    void GetSolution(Reservoir& rs, vector<OCP_DBL>& u, const ControlNR& ctrlNR);
+
+protected:
+    /// Next time step reduced with the well check, negative if not available
+    OCP_DBL         nextDt{ -1 };
+    /// If small changes of an iteration are accepted as convergence
+    OCP_BOOL        ifConvD{ OCP_TRUE };
+    /// Factor of tolerance of residual in the convergence check
+    OCP_DBL         convFac{ 1.0 };
+    /// Global max relative residual of the last iterate, reduced in FinishNR
+    OCP_DBL         resNR{ 0 };
+    /// If properties of all bulks are updated in next iteration
+    OCP_BOOL        actAll{ OCP_TRUE };
+    /// If properties of some bulks are kept in current iteration
+    OCP_BOOL        actSkip{ OCP_FALSE };
+    /// P of bulks when their properties are calculated last time
+    vector<OCP_DBL> actP;
+    /// Ni of bulks when their properties are calculated last time
+    vector<OCP_DBL> actNi;
+    /// Bulks whose properties are updated in current iteration
+    vector<OCP_USI> actBulk;
+    /// If properties of a bulk are updated in current iteration
+    vector<OCP_BOOL> actFlag;
+    /// Accumulation blocks of bulks and flux blocks of connections (begin and end), those
+    /// between bulks keeping their properties are reused in next assembly
+    mutable vector<OCP_DBL> actAcc, actFluxB, actFluxE;
 
 private:
     /// Perform Flash with Sj and calculate values needed for FIM
     void InitFlash(Bulk& bk);
-    /// Perform Flash with Ni and calculate values needed for FIM
-    void CalFlash(Bulk& bk);
+    /// Perform Flash with Ni for bulks in bList and calculate values needed for FIM
+    void CalFlash(Bulk& bk, const vector<OCP_USI>& bList);
+    /// Calculate relative permeability and capillary pressure for bulks in bList
+    void CalKrPc(Bulk& bk, const vector<OCP_USI>& bList) const;
+    /// Select bulks whose P or Ni change beyond tol since their properties are calculated
+    void SetActiveBulk(const Bulk& bk, const OCP_DBL& tol);
     /// Assemble linear system for bulks
     void AssembleMatBulks(LinearSystem& ls, const Reservoir& rs, const OCP_DBL& dt) const;
-    /// Update P, Ni, BHP after linear system is solved
-    void GetSolution(Reservoir& rs, vector<OCP_DBL>& u, const ControlNR& ctrlNR);
 };
 
 
@@ -181,7 +242,7 @@ protected:
     void AllocateReservoir(Reservoir& rs);
     /// Determine which bulk are treated Implicit
     void SetFIMBulk(Reservoir& rs);
-    // Set K-neighbors
+    /// Set K-neighbors
     void SetKNeighbor(const vector<vector<OCP_USI>>& neighbor, const OCP_USI& p, BulkTypeAIM& tar, OCP_INT k);
     /// Perform flash calculation with Ni for Explicit bulk -- Update partial properties
     void CalFlashEp(Bulk& bk);
@@ -203,6 +264,14 @@ protected:
     void ResetToLastTimeStep(Reservoir& rs, OCPControl& ctrl);
     /// Update values of last step for AIMc.
     void UpdateLastTimeStep(Reservoir& rs) const;
+
+protected:
+    /// Params of selecting implicit bulks
+    ControlAIM       aimParam;
+    /// If bulks are implicit by their own CFL, volume error or wells
+    vector<OCP_BOOL> aimSeed;
+    /// Implicity of bulks determined by local seeds only
+    BulkTypeAIM      aimLocal;
 };
 
 
@@ -226,6 +295,10 @@ public:
     OCP_BOOL FinishNR(Reservoir& rs, OCPControl& ctrl);
     /// Finish a time step.
     void FinishStep(Reservoir& rs, OCPControl& ctrl);
+    /// Transfer from FIM to take subdomain solves again
+    void TransferToFIMddm(Reservoir& rs, const OCPControl& ctrl);
+    /// Predict num of sub-steps of the subdomain for next time step
+    void SetNumSub(const Bulk& bk, const ControlTime& ctrlTime);
 
 protected:
     /// Allocate memory for reservoir
@@ -263,6 +336,12 @@ protected:
     void ResetToLastTimeStep(Reservoir& rs, OCPControl& ctrl);
     /// Update values of last step for AIMc.
     void UpdateLastTimeStep(Reservoir& rs) const;
+    /// If subdomain solves preconditioning FIM take sub-steps
+    OCP_BOOL IfSubStep() const { return preM && maxSub > 1; }
+    /// Time step size of a sub-step
+    OCP_DBL SubDt(const OCP_DBL& dt) const { return dt / numSub; }
+    /// Finish a Newton iteration of subdomain solves with sub-steps
+    OCP_BOOL FinishNRSubStep(Reservoir& rs, OCPControl& ctrl);
 
 protected:
     set<OCP_INT>    rankSetInLS;
@@ -281,6 +360,92 @@ protected:
     // OCP_DBL         dPlim = 1E-2;
     OCP_DBL         dPlim = 5E-3;
     // OCP_DBL         dPlim = 1E-3;
+
+    /// Max num of sub-steps of a subdomain in a time step, 1: off
+    USI             maxSub{ 1 };
+    /// Num of sub-steps of the subdomain in current time step (rate class)
+    USI             numSub{ 1 };
+    /// Index of current sub-step
+    USI             iSub{ 0 };
+    /// Num of Newton iterations before current sub-step
+    USI             iterSub0{ 0 };
+    /// If all sub-steps of the subdomain have converged
+    OCP_BOOL        subDone{ OCP_FALSE };
+    /// If the physical check of the subdomain fails in current iteration
+    OCP_BOOL        subFail{ OCP_FALSE };
+    /// Ni of interior bulks at the beginning of the time step
+    vector<OCP_DBL> lNiStep;
+};
+
+
+/// IsoT_SFI is SFI (Sequential Fully Implicit Method), each outer iteration solves
+/// a pressure system reduced from the Jacobian of FIM, then the transport of components
+/// with pressure and the total volume flow rates of connections fixed by Newton
+/// iterations, where total volume flow rates of perforations are also fixed. The outer
+/// iterations converge to the solution of FIM, the time step is cut once they diverge or
+/// can not converge within the max num of iterations at their current rate, and it is
+/// restarted by FIM only if this happens at the min time step (optional).
+class IsoT_SFI : public IsoT_FIM
+{
+    friend class IsothermalSolver;
+
+public:
+    /// Setup SFI
+    void Setup(Reservoir& rs, const OCPControl& ctrl);
+    /// Set work LS of pressure, transport and FIM
+    void SetWorkLS(const USI& wp, const USI& wt, const USI& wf, const USI& i);
+    /// Prepare for Assembling matrix.
+    void Prepare(Reservoir& rs, const OCPControl& ctrl);
+    /// Assemble pressure system, or the system of FIM after the switch
+    void AssembleMat(LinearSystem& ls, const Reservoir& rs, const OCP_DBL& dt) const;
+    /// Solve pressure system, then the transport
+    OCP_BOOL SolveLinearSystem(LinearSystem& ls, Reservoir& rs, OCPControl& ctrl);
+    /// Update residual, properties have been updated in the transport
+    OCP_BOOL UpdateProperty(Reservoir& rs, OCPControl& ctrl);
+    /// Finish an outer iteration, cut the time step or switch to FIM if they fail
+    OCP_BOOL FinishNR(Reservoir& rs, OCPControl& ctrl);
+
+protected:
+    /// Solve the reduced system and update reservoir, return the status of linear solver
+    OCP_INT SolveStage(LinearSystem& ls, Reservoir& rs, const ControlNR& ctrlNR, const OCP_BOOL& ifP);
+    /// Newton iterations of transport, return false if the physical check fails,
+    /// status of linear solver and its iterations are passed out
+    OCP_BOOL SolveTransport(LinearSystem& ls, Reservoir& rs, OCPControl& ctrl, OCP_INT& status, USI& lsIter);
+    /// Assemble transport system, P and BHP are not reduced yet
+    void AssembleMatTransport(LinearSystem& ls, const Reservoir& rs, const OCP_DBL& dt) const;
+    /// Calculate residual of transport
+    void CalResTransport(Reservoir& rs, const OCP_DBL& dt);
+    /// Calculate local max relative residual of components
+    OCP_DBL CalMaxRelResTransport(const Reservoir& rs) const;
+
+protected:
+    /// Index of linear solver of transport
+    USI             wlsT;
+    /// Index of linear solver of FIM
+    USI             wlsF;
+    /// Solution of pressure or transport system in the layout of FIM
+    vector<OCP_DBL> uFIM;
+    /// Total volume flow rates of connections from the pressure stage
+    vector<OCP_DBL> vT;
+    /// Max num of Newton iterations of transport in an outer iteration
+    USI             maxIterT{ 5 };
+    /// Newton iterations of transport stop once the residual is reduced by this factor,
+    /// or is below this factor times the tolerance of outer iterations
+    OCP_DBL         redT{ 1E-2 };
+    /// Outer iterations converge linearly and stop right below the tolerance, whose error
+    /// accumulates over time steps, so their tolerance is this factor times the one of FIM
+    OCP_DBL         tolFac{ 0.1 };
+    /// If a time step is restarted by FIM once outer iterations fail at min time step
+    OCP_BOOL        ifSwitch{ OCP_TRUE };
+    /// If the outer iterations of current time step have been switched to FIM
+    OCP_BOOL        ifFIM{ OCP_FALSE };
+    /// Global max relative residual of last outer iteration
+    OCP_DBL         lastRes{ 0 };
+    /// Max ratio of residuals of two successive outer iterations in current time step
+    OCP_DBL         maxRate{ 0 };
+    /// Ideal max ratio of residuals of two successive outer iterations, which limits
+    /// the next time step
+    OCP_DBL         rateT{ 0.3 };
 };
 
 
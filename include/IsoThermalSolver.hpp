@@ -54,6 +54,13 @@ private:
     IsoT_FIM     fim;
     IsoT_AIMc    aimc;
     IsoT_FIMddm  fim_ddm;
+    IsoT_SFI     sfi;
+    /// Num of global Newton iterations of FIM between two rounds of subdomain solves of FIMddm
+    USI          ddmCycle{ 0 };
+    /// Global Newton iterations after which subdomain solves are taken again
+    USI          ddmNextIter{ 0 };
+    /// Num of time step cuts when the subdomain solves begin, a cut is detected by its change
+    OCP_USI      ddmNumCut{ 0 };
 };
 
 #endif /* end if __ISOTHERMALSOLVER_HEADER__ */
@@ -41,6 +41,12 @@ public:
     USI Setup(const OCPModel& model, const string& dir, const string& file, const Domain& d, const USI& nb);
     /// Set work LS
     void SetWorkLS(const USI& i);
+    /// Set block dim of a system which is reduced to work LS before solved
+    void SetAssembleDim(const USI& nb) { mat.Allocate(*domain, nb); }
+    /// Reduce to the system of the first variable and set work LS i
+    void ReduceToFirst(const USI& i, const OCP_USI& nr) { mat.ReduceToFirst(nr); SetWorkLS(i); }
+    /// Reduce to the system of other variables and set work LS i
+    void ReduceToOthers(const USI& i, const OCP_USI& nr, const OCP_USI& nd) { mat.ReduceToOthers(nr, nd); SetWorkLS(i); }
     /// Clear the internal matrix data for scalar-value problems.
     void ClearData() { mat.ClearData(); }
     /// Assemble Mat for Linear Solver.
@@ -118,6 +118,8 @@ protected:
     /// Miscible Factor
     MiscibleFactor* misFac;
     USI             mfMethodIndex;
+    /// Flash cost
+    FlashCost*      flashCost;
 };
 
 #endif /* end if __MIXTURE_HEADER__ */
@@ -59,11 +59,36 @@ public:
              << endl;
 
         cout << "You can pass optional cmd arguments after the input file:" << endl
-             << "     method = solution method to use " << endl
+             << "     method = FIM, IMPEC, AIMc or SFI, solution method to use " << endl
              << "     dtInit = initial time stepsize  " << endl
              << "      dtMax = maximum time stepsize  " << endl
              << "      dtMin = minimum time stepsize  " << endl
              << "    verbose = print level on screen  " << endl
+             << "     gridIn = master or dist, grid input by master or all processes" << endl
+             << "      wgtIn = file of vertex weights used in partition" << endl
+             << "      order = natural or rcm, numbering of local grids" << endl
+             << "   ptnCache = directory of cached partitions" << endl
+             << "      ptnIn = file of external partition, one process id per active grid" << endl
+             << "     wgtOut = file of vertex weights written at each TSTEP" << endl
+             << "     vtkFmt = legacy or vtu, vtk files merged by master or vtu pieces by each process" << endl
+             << "   vtkMerge = num of processes merging legacy vtk files" << endl
+             << "    asyncIO = on or off, vtk files at TSTEP written in background" << endl
+             << "     sumBin = on or off, binary summary SUMMARY.bin written at each step" << endl
+             << "    perfLog = off, csv or jsonl, performance record of each time step in PerfLog.*" << endl
+             << "    hwCount = on or off, hardware counters of main kernels in HWCounter.out (Linux)" << endl
+             << "    profile = off, on or trace, table (and Chrome trace) of timed regions by each process" << endl
+             << "   nrGlobal = off, ls or tr, line search or trust region for Newton iterations of FIM" << endl
+             << "     dtCtrl = rule or pid, selection of time step size" << endl
+             << "    nrGuess = off, lin or quad, extrapolated initial guess for Newton iterations of FIM" << endl
+             << "   subCycle = max num of CFL-limited transport sub-steps in a pressure step of IMPEC" << endl
+             << "      mrate = on or off, only bulks limited by CFL take the sub-steps of subCycle" << endl
+             << "     sfiFIM = on or off, time step of SFI restarted by FIM if outer iterations fail at dtMin" << endl
+             << "     aimCFL = on[,off], CFL making a bulk implicit (and explicit again) in AIMc" << endl
+             << "      aimVe = relative volume error making a bulk implicit in AIMc" << endl
+             << "   aimLayer = num of neighbor layers of implicit bulks in AIMc" << endl
+             << "   ddmCycle = num of global Newton iterations between subdomain solves of FIMddm, 0: once a step" << endl
+             << " ddmSubStep = max num of sub-steps of a subdomain solve of FIMddm preconditioning FIM" << endl
+             << "     actTol = relative change of P and Ni below which bulk properties are kept in FIM, 0: off" << endl
              << endl;
 
         cout << "Attention: " << endl
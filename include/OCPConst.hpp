@@ -77,7 +77,40 @@ enum class OCPNLMethod : USI
     IMPEC,
     FIM,
     AIMc,
-    FIMddm
+    FIMddm,
+    SFI
+};
+
+
+/// globalization of Newton iterations
+enum class OCPNRGlobal : USI
+{
+    /// full step with chopping of each variable
+    none,
+    /// residual-based backtracking line search
+    lineSearch,
+    /// Appleyard damping in an adaptive trust region
+    trustRegion
+};
+
+/// initial guess of Newton iterations at each time step
+enum class OCPNRGuess : USI
+{
+    /// converged state of last time step
+    last,
+    /// linear extrapolation of the last two converged states
+    linear,
+    /// quadratic extrapolation of the last three converged states
+    quadratic
+};
+
+/// selection of time step size
+enum class OCPDtCtrl : USI
+{
+    /// ratio of ideal changes to changes, and rules of Newton iterations
+    rule,
+    /// PID controller on the history of changes and Newton iterations
+    PID
 };
 
 
@@ -54,6 +54,18 @@ public:
 public:
     /// Print level
     USI            printLevel{0};
+    /// File of vertex weights (flash cost) to be written at each TSTEP
+    string         vwgtOutFile;
+    /// If each process outputs its own vtu piece
+    OCP_BOOL       vtuOutput{ OCP_FALSE };
+    /// Num of processes used to merge the legacy vtk files
+    OCP_INT        vtkMergeProc{ 1 };
+    /// If files at TSTEP are written in a background thread
+    OCP_BOOL       asyncOutput{ OCP_FALSE };
+    /// If binary summary is written at each time step
+    OCP_BOOL       summaryBin{ OCP_FALSE };
+    /// Format of performance log of each time step, csv or jsonl, none if empty
+    string         perfLogFmt;
     /// Time control 
     ControlTime    time;
     /// NR control    
@@ -56,11 +56,15 @@ public:
                 else if (value == "AIMc") {
                     method = OCPNLMethod::AIMc;
                 }
+                else if (value == "SFI") {
+                    method = OCPNLMethod::SFI;
+                }
                 else {
                     OCP_ABORT("Wrong method param in command line!");
                 }
                 ifUse = OCP_TRUE;
-                if (method == OCPNLMethod::FIM || method == OCPNLMethod::AIMc) {
+                if (method == OCPNLMethod::FIM || method == OCPNLMethod::AIMc ||
+                    method == OCPNLMethod::SFI) {
                     if (timeInit <= 0) timeInit = 1;
                     if (timeMax <= 0) timeMax = 10.0;
                     if (timeMin <= 0) timeMin = 0.1;
@@ -88,6 +92,229 @@ public:
                 printLevel = OCP_MIN(OCP_MAX(stoi(value), PRINT_NONE), PRINT_ALL);
                 break;
 
+            case Map_Str2Int("gridIn", 6):
+                if (value == "dist") {
+                    distGridInput = OCP_TRUE;
+                }
+                else if (value == "master") {
+                    distGridInput = OCP_FALSE;
+                }
+                else {
+                    OCP_ABORT("Wrong gridIn param in command line!");
+                }
+                break;
+
+            case Map_Str2Int("order", 5):
+                if (value == "rcm") {
+                    reorderRCM = OCP_TRUE;
+                }
+                else if (value == "natural") {
+                    reorderRCM = OCP_FALSE;
+                }
+                else {
+                    OCP_ABORT("Wrong order param in command line!");
+                }
+                break;
+
+            case Map_Str2Int("ptnCache", 8):
+                ptnCacheDir = value;
+                break;
+
+            case Map_Str2Int("ptnIn", 5):
+                ptnInFile = value;
+                break;
+
+            case Map_Str2Int("wgtIn", 5):
+                vwgtInFile = value;
+                break;
+
+            case Map_Str2Int("wgtOut", 6):
+                vwgtOutFile = value;
+                break;
+
+            case Map_Str2Int("vtkFmt", 6):
+                if (value == "vtu") {
+                    vtuOutput = OCP_TRUE;
+                }
+                else if (value == "legacy") {
+                    vtuOutput = OCP_FALSE;
+                }
+                else {
+                    OCP_ABORT("Wrong vtkFmt param in command line!");
+                }
+                break;
+
+            case Map_Str2Int("vtkMerge", 8):
+                vtkMergeProc = OCP_MAX(stoi(value), 1);
+                break;
+
+            case Map_Str2Int("asyncIO", 7):
+                if (value == "on") {
+                    asyncOutput = OCP_TRUE;
+                }
+                else if (value == "off") {
+                    asyncOutput = OCP_FALSE;
+                }
+                else {
+                    OCP_ABORT("Wrong asyncIO param in command line!");
+                }
+                break;
+
+            case Map_Str2Int("sumBin", 6):
+                if (value == "on") {
+                    summaryBin = OCP_TRUE;
+                }
+                else if (value == "off") {
+                    summaryBin = OCP_FALSE;
+                }
+                else {
+                    OCP_ABORT("Wrong sumBin param in command line!");
+                }
+                break;
+
+            case Map_Str2Int("perfLog", 7):
+                if (value == "csv" || value == "jsonl") {
+                    perfLogFmt = value;
+                }
+                else if (value == "off") {
+                    perfLogFmt.clear();
+                }
+                else {
+                    OCP_ABORT("Wrong perfLog param in command line!");
+                }
+                break;
+
+            case Map_Str2Int("hwCount", 7):
+                if (value == "on") {
+                    hwCounter = OCP_TRUE;
+                }
+                else if (value == "off") {
+                    hwCounter = OCP_FALSE;
+                }
+                else {
+                    OCP_ABORT("Wrong hwCount param in command line!");
+                }
+                break;
+
+            case Map_Str2Int("profile", 7):
+                if (value == "on") {
+                    profile      = OCP_TRUE;
+                    profileTrace = OCP_FALSE;
+                }
+                else if (value == "trace") {
+                    profile      = OCP_TRUE;
+                    profileTrace = OCP_TRUE;
+                }
+                else if (value == "off") {
+                    profile      = OCP_FALSE;
+                    profileTrace = OCP_FALSE;
+                }
+                else {
+                    OCP_ABORT("Wrong profile param in command line!");
+                }
+                break;
+
+            case Map_Str2Int("nrGlobal", 8):
+                if (value == "ls") {
+                    nrGlobal = OCPNRGlobal::lineSearch;
+                }
+                else if (value == "tr") {
+                    nrGlobal = OCPNRGlobal::trustRegion;
+                }
+                else if (value == "off") {
+                    nrGlobal = OCPNRGlobal::none;
+                }
+                else {
+                    OCP_ABORT("Wrong nrGlobal param in command line!");
+                }
+                break;
+
+            case Map_Str2Int("nrGuess", 7):
+                if (value == "lin") {
+                    nrGuess = OCPNRGuess::linear;
+                }
+                else if (value == "quad") {
+                    nrGuess = OCPNRGuess::quadratic;
+                }
+                else if (value == "off") {
+                    nrGuess = OCPNRGuess::last;
+                }
+                else {
+                    OCP_ABORT("Wrong nrGuess param in command line!");
+                }
+                break;
+
+            case Map_Str2Int("dtCtrl", 6):
+                if (value == "pid") {
+                    dtCtrl = OCPDtCtrl::PID;
+                }
+                else if (value == "rule") {
+                    dtCtrl = OCPDtCtrl::rule;
+                }
+                else {
+                    OCP_ABORT("Wrong dtCtrl param in command line!");
+                }
+                break;
+
+            case Map_Str2Int("subCycle", 8):
+                subCycle = OCP_MAX(stoi(value), 1);
+                break;
+
+            case Map_Str2Int("mrate", 5):
+                if (value == "on") {
+                    multirate = OCP_TRUE;
+                }
+                else if (value == "off") {
+                    multirate = OCP_FALSE;
+                }
+                else {
+                    OCP_ABORT("Wrong mrate param in command line!");
+                }
+                break;
+
+            case Map_Str2Int("sfiFIM", 6):
+                if (value == "on") {
+                    sfiSwitch = OCP_TRUE;
+                }
+                else if (value == "off") {
+                    sfiSwitch = OCP_FALSE;
+                }
+                else {
+                    OCP_ABORT("Wrong sfiFIM param in command line!");
+                }
+                break;
+
+            case Map_Str2Int("aimCFL", 6):
+            {
+                const string::size_type p = value.find(',');
+                aimCFLOn  = stod(value.substr(0, p));
+                aimCFLOff = p == string::npos ? aimCFLOn : stod(value.substr(p + 1));
+                if (aimCFLOff > aimCFLOn || aimCFLOff < 0) {
+                    OCP_ABORT("Wrong aimCFL param in command line!");
+                }
+                break;
+            }
+
+            case Map_Str2Int("aimVe", 5):
+                aimVe = stod(value);
+                break;
+
+            case Map_Str2Int("aimLayer", 8):
+                aimLayer = OCP_MAX(stoi(value), 0);
+                break;
+
+            case Map_Str2Int("ddmCycle", 8):
+                ddmCycle = OCP_MAX(stoi(value), 0);
+                break;
+
+            case Map_Str2Int("ddmSubStep", 10):
+                ddmSubStep = OCP_MAX(stoi(value), 1);
+                break;
+
+            case Map_Str2Int("actTol", 6):
+                actTol = OCP_MAX(stod(value), 0.0);
+                break;
+
             default:
                 OCP_ABORT("Unknown Options: " + key + "   See -h");
                 break;
@@ -111,6 +338,60 @@ public:
     OCP_DBL     timeMin;
     /// Print level
     USI         printLevel{ 0 };
+    /// If grid is input and set up by all processes
+    OCP_BOOL    distGridInput{ OCP_FALSE };
+    /// If local grids are renumbered by reverse Cuthill-McKee
+    OCP_BOOL    reorderRCM{ OCP_FALSE };
+    /// Directory of cached partitions
+    string      ptnCacheDir;
+    /// File of external partition
+    string      ptnInFile;
+    /// File of vertex weights (flash cost) used in partition
+    string      vwgtInFile;
+    /// File of vertex weights (flash cost) to be written at each TSTEP
+    string      vwgtOutFile;
+    /// If each process outputs its own vtu piece
+    OCP_BOOL    vtuOutput{ OCP_FALSE };
+    /// Num of processes used to merge the legacy vtk files
+    OCP_INT     vtkMergeProc{ 1 };
+    /// If files at TSTEP are written in a background thread
+    OCP_BOOL    asyncOutput{ OCP_FALSE };
+    /// If binary summary is written at each time step
+    OCP_BOOL    summaryBin{ OCP_FALSE };
+    /// Format of performance log of each time step, csv or jsonl, none if empty
+    string      perfLogFmt;
+    /// If regions are profiled
+    OCP_BOOL    profile{ OCP_FALSE };
+    /// If the trace of regions is written
+    OCP_BOOL    profileTrace{ OCP_FALSE };
+    /// If hardware counters of main kernels are read
+    OCP_BOOL    hwCounter{ OCP_FALSE };
+    /// Globalization of Newton iterations
+    OCPNRGlobal nrGlobal{ OCPNRGlobal::none };
+    /// Selection of time step size
+    OCPDtCtrl   dtCtrl{ OCPDtCtrl::rule };
+    /// Initial guess of Newton iterations
+    OCPNRGuess  nrGuess{ OCPNRGuess::last };
+    /// Max num of transport sub-steps in a pressure step of IMPEC
+    USI         subCycle{ 1 };
+    /// If only bulks limited by CFL take transport sub-steps of IMPEC
+    OCP_BOOL    multirate{ OCP_FALSE };
+    /// If a time step of SFI is restarted by FIM once outer iterations fail at min time step
+    OCP_BOOL    sfiSwitch{ OCP_TRUE };
+    /// CFL above which a bulk becomes implicit in AIMc, negative if not set
+    OCP_DBL     aimCFLOn{ -1 };
+    /// CFL below which an implicit bulk becomes explicit in AIMc, negative if not set
+    OCP_DBL     aimCFLOff{ -1 };
+    /// Relative volume error above which a bulk becomes implicit in AIMc, negative if not set
+    OCP_DBL     aimVe{ -1 };
+    /// Num of neighbor layers of implicit bulks in AIMc, negative if not set
+    OCP_INT     aimLayer{ -1 };
+    /// Num of global Newton iterations between two rounds of subdomain solves of FIMddm
+    USI         ddmCycle{ 0 };
+    /// Max num of sub-steps of a subdomain in a time step of FIMddm preconditioning FIM
+    USI         ddmSubStep{ 1 };
+    /// Relative change of P and Ni below which bulk properties are kept in FIM
+    OCP_DBL     actTol{ 0 };
 };
 
 
@@ -24,6 +24,21 @@
 using namespace std;
 
 
+/// Params of selecting implicit bulks in AIMc
+class ControlAIM
+{
+public:
+    /// An explicit bulk becomes implicit if its CFL exceeds cflOn
+    OCP_DBL cflOn{ 0.8 };
+    /// An implicit bulk becomes explicit if its CFL falls below cflOff (<= cflOn)
+    OCP_DBL cflOff{ 0.8 };
+    /// A bulk becomes implicit if its relative volume error exceeds ve
+    OCP_DBL ve{ 1E-3 };
+    /// Num of neighbor layers of implicit bulks which are also implicit
+    USI     nlayer{ 2 };
+};
+
+
 /// control the usage of solver method
 class ControlMethod
 {
@@ -33,6 +48,14 @@ public:
     void SetCtrlParam(const ParamControl& CtrlParam);
     /// Set fast control
     void SetFastControl(const FastControl& fCtrl);
+    /// Set params of AIMc set in fast control, which override those in METHOD
+    void SetAIMParam(const FastControl& fCtrl);
+    /// Set num of global Newton iterations between two rounds of subdomain solves
+    void SetDDMCycle(const USI& n) { ddmCycle = n; }
+    /// Set max num of sub-steps of a subdomain solve of FIMddm preconditioning FIM
+    void SetDDMSubStep(const USI& n) { ddmSubStep = OCP_MAX(n, 1); }
+    /// Set if a time step of SFI is restarted by FIM once outer iterations fail at min time step
+    void SetSFISwitch(const OCP_BOOL& flag) { sfiSwitch = flag; }
     /// Initialize calling sequence of methods
     OCPNLMethod InitMethod() const;
     /// Switch to main method
@@ -45,8 +68,18 @@ public:
     auto GetMethod() const { return method; }
     /// Get ith ls file
     auto GetLsFile(const USI& i) const { return lsFile[i]; }
+    /// Get ls file of the transport stage of SFI, also used after SFI switches to FIM
+    auto GetLsFileT() const { return lsFileT.empty() ? lsFile[0] : lsFileT; }
     /// Get work dir name.
     auto GetWorkDir() const { return workDir; }
+    /// Get params of AIMc
+    const auto& GetAIMParam() const { return aim; }
+    /// Get num of global Newton iterations between two rounds of subdomain solves
+    auto GetDDMCycle() const { return ddmCycle; }
+    /// Get max num of sub-steps of a subdomain solve of FIMddm preconditioning FIM
+    auto GetDDMSubStep() const { return ddmSubStep; }
+    /// Get if a time step of SFI is restarted by FIM once outer iterations fail at min time step
+    auto GetSFISwitch() const { return sfiSwitch; }
 
 protected:
     /// work directory
@@ -60,6 +93,18 @@ protected:
     vector<OCPNLMethod> method;
     /// File name of linear Solver
     vector<string>      lsFile;
+    /// File name of linear Solver for the transport stage of SFI
+    string              lsFileT;
+    /// Params of selecting implicit bulks in AIMc
+    ControlAIM          aim;
+    /// Num of global Newton iterations of FIM between two rounds of subdomain solves of
+    /// FIMddm, 0 means subdomain solves are only taken at the beginning of a time step
+    USI                 ddmCycle{ 0 };
+    /// Max num of sub-steps of a subdomain solve of FIMddm preconditioning FIM in a time
+    /// step, 1 means the subdomains take the whole time step
+    USI                 ddmSubStep{ 1 };
+    /// If a time step of SFI is restarted by FIM once outer iterations fail at min time step
+    OCP_BOOL            sfiSwitch{ OCP_TRUE };
 };
 
 #endif /* end if __OCPControlMethod_HEADER__ */
@@ -70,8 +70,34 @@ public:
     auto DSmax() const { return wp->dSmax; }
     /// Get dPmax
     auto DPmax() const { return wp->dPmax; }
+    /// Get max num of Newton iterations in a time step
+    auto MaxIter() const { return wp->maxIter; }
+    /// Get tolerance of residual of Newton iterations
+    auto Tol() const { return wp->tol; }
+    /// Set globalization of Newton iterations
+    void SetGlobal(const OCPNRGlobal& g) { global = g; }
+    /// Get globalization of Newton iterations
+    auto GetGlobal() const { return global; }
+    /// Get max num of step cuts in line search
+    auto LSmaxCut() const { return lsMaxCut; }
+    /// Get sufficient decrease factor of line search
+    auto LSdecrease() const { return lsDecrease; }
+    /// Get min radius of trust region
+    auto TRminRadius() const { return trMinRadius; }
+    /// Set initial guess of Newton iterations
+    void SetGuess(const OCPNRGuess& g) { guess = g; }
+    /// Get initial guess of Newton iterations
+    auto GetGuess() const { return guess; }
+    /// Set relative change of P and Ni below which properties of a bulk are kept
+    void SetActiveTol(const OCP_DBL& tol) { actTol = tol; }
+    /// Get relative change of P and Ni below which properties of a bulk are kept
+    auto GetActiveTol() const { return actTol; }
     /// If NR iterations converge
     OCPNRStateC CheckConverge(const OCPNRsuite& NRs, const initializer_list<string>& il, const OCP_DBL& tmpfac) const;
+    /// If NR iterations converge locally, the max over processes is the global flag
+    OCPNRStateC CheckConvergeLoc(const OCPNRsuite& NRs, const initializer_list<string>& il, const OCP_DBL& tmpfac) const;
+    /// State of NR iterations from the global flag
+    OCPNRStateC CheckConvergeGlobal(const OCPNRsuite& NRs, const OCPNRStateC& conflag) const;
 
 protected:
     MPI_Comm         myComm{ MPI_COMM_NULL };
@@ -82,6 +108,19 @@ protected:
     vector<ControlNRParam> ps;
     /// current param
     const ControlNRParam* wp;
+    /// globalization of Newton iterations
+    OCPNRGlobal           global{ OCPNRGlobal::none };
+    /// max num of step cuts in line search
+    USI                   lsMaxCut{ 4 };
+    /// sufficient decrease factor of residual in line search
+    OCP_DBL               lsDecrease{ 1E-4 };
+    /// min radius of trust region, as a fraction of dPmax and dSmax
+    OCP_DBL               trMinRadius{ 0.0625 };
+    /// initial guess of Newton iterations
+    OCPNRGuess            guess{ OCPNRGuess::last };
+    /// relative change of P and Ni below which properties of a bulk are not updated
+    /// in Newton iterations of FIM, 0 means properties of all bulks are updated
+    OCP_DBL               actTol{ 0 };
 };
 
 #endif /* end if __OCPControlNR_HEADER__ */
@@ -99,15 +99,61 @@ public:
     void CalInitTimeStep4TSTEP(const OCP_BOOL& wellOptChange_loc);
     /// Calculate next time step
     void CalNextTimeStep(const OCPNRsuite& NRs, const initializer_list<string>& il);
+    /// Calculate local candidate of next time step, whose min over processes is used
+    OCP_DBL CalNextTimeStepLoc(const OCPNRsuite& NRs, const initializer_list<string>& il);
+    /// Finish current time step and set next one with the global candidate
+    void SetNextTimeStep(const OCP_DBL& dt);
     /// Get total simulation time
     auto GetTotalTime() const { return ps.back().end_time; }
     /// Get number of TSTEP interval
     auto GetNumTstepInterval() const { return ps.size(); }
+    /// Set selection of time step size
+    void SetDtCtrl(const OCPDtCtrl& c) { dtCtrl = c; }
+    /// Return the time when wells changed last
+    auto GetWellChangeTime() const { return wellChangeTime; }
+    /// Set max num of transport sub-steps in a pressure step of IMPEC
+    void SetSubCycle(const USI& n) { subCycle = OCP_MAX(n, 1); }
+    /// Return max num of transport sub-steps in a pressure step of IMPEC
+    auto GetSubCycle() const { return subCycle; }
+    /// Set if only bulks limited by CFL take transport sub-steps
+    void SetMultirate(const OCP_BOOL& flag) { multirate = flag; }
+    /// Return if only bulks limited by CFL take transport sub-steps
+    auto IfMultirate() const { return multirate; }
+    /// Return num of time step cuts so far
+    auto GetNumCut() const { return numCut; }
 
 protected:
     MPI_Comm         myComm{ MPI_COMM_NULL };
     OCP_INT          numproc, myrank;
 
+protected:
+    /// Calculate factor of next time step with PID controller
+    OCP_DBL CalFactorPID(const OCPNRsuite& NRs, const initializer_list<string>& il);
+    /// Record a failed time step, growth beyond it is penalized for following steps
+    void RecordCut(const OCP_DBL& dt);
+
+protected:
+    /// selection of time step size
+    OCPDtCtrl dtCtrl{ OCPDtCtrl::rule };
+    /// proportional, integral and derivative gains of PID controller, PI by default
+    OCP_DBL   kP{ 0.2 }, kI{ 1.0 }, kD{ 0 };
+    /// ideal num of Newton iterations in a time step
+    OCP_DBL   iterTarget{ 6 };
+    /// normalized error of current time step (candidate), last one and the one before last
+    OCP_DBL   errC{ 1 }, err1{ 1 }, err2{ 1 };
+    /// last failed time step, 0 if no failure needs to be considered
+    OCP_DBL   failDt{ 0 };
+    /// allowed ratio of next time step to failDt
+    OCP_DBL   failFac{ 0 };
+    /// failFac right after a failure and its growth after each successful time step
+    OCP_DBL   failFac0{ 0.75 }, failFacGrow{ 1.2 };
+    /// max num of transport sub-steps in a pressure step of IMPEC
+    USI       subCycle{ 1 };
+    /// if only bulks limited by CFL take transport sub-steps (multirate)
+    OCP_BOOL  multirate{ OCP_FALSE };
+    /// num of time step cuts so far
+    OCP_USI   numCut{ 0 };
+
 public:
     /// Set current time
     void SetStartTime(const OCP_DBL& startT) { current_time = startT; }
@@ -121,6 +167,10 @@ public:
     auto IfEndTSTEP() { return ((wp->end_time - current_time) < TINY); }
     /// Return max timestep
     auto GetMaxTime() const { return wp->timeMax; }
+    /// Return min timestep
+    auto GetMinTime() const { return wp->timeMin; }
+    /// Return ideal max saturation change
+    auto GetDSlim() const { return wp->dSlim; }
 
 protected:
     /// control param set
@@ -135,6 +185,8 @@ protected:
     OCP_DBL                  last_dt{ 0 };
     /// current time
     OCP_DBL                  current_time{ 0 };
+    /// time when wells changed last
+    OCP_DBL                  wellChangeTime{ 0 };
 };
 
 
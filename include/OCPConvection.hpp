@@ -36,6 +36,10 @@ public:
     virtual void AssembleMatAIM(const BulkConnPair& bp, const OCP_USI& c, const BulkConnVarSet& bcvs, const Bulk& bk, FluxVarSet& fvs) = 0;
     /// Assemble matrix for IMPEC
     virtual void AssembleMatIMPEC(const BulkConnPair& bp, const OCP_USI& c, const BulkConnVarSet& bcvs, const Bulk& bk, FluxVarSet& fvs) = 0;
+    /// Calculate flux of components and phases with total volume flow rate fixed at vT for SFI
+    virtual void CalFluxSFI(const BulkConnPair& bp, const Bulk& bk, const OCP_DBL& vT, FluxVarSet& fvs) = 0;
+    /// Assemble matrix for transport of SFI, the total volume flow rate is fixed
+    virtual void AssembleMatSFI(const BulkConnPair& bp, const OCP_USI& c, const BulkConnVarSet& bcvs, const Bulk& bk, FluxVarSet& fvs) = 0;
 
     
     const vector<OCP_USI>& GetUpblock() const { return upblock; }
@@ -92,6 +96,8 @@ public:
     void AssembleMatFIM(const BulkConnPair& bp, const OCP_USI& c, const BulkConnVarSet& bcvs, const Bulk& bk, FluxVarSet& fvs) override;
     void AssembleMatAIM(const BulkConnPair& bp, const OCP_USI& c, const BulkConnVarSet& bcvs, const Bulk& bk, FluxVarSet& fvs) override;
     void AssembleMatIMPEC(const BulkConnPair& bp, const OCP_USI& c, const BulkConnVarSet& bcvs, const Bulk& bk, FluxVarSet& fvs) override;
+    void CalFluxSFI(const BulkConnPair& bp, const Bulk& bk, const OCP_DBL& vT, FluxVarSet& fvs) override;
+    void AssembleMatSFI(const BulkConnPair& bp, const OCP_USI& c, const BulkConnVarSet& bcvs, const Bulk& bk, FluxVarSet& fvs) override;
 };
 
 
@@ -105,6 +111,8 @@ public:
     void AssembleMatFIM(const BulkConnPair& bp, const OCP_USI& c, const BulkConnVarSet& bcvs, const Bulk& bk, FluxVarSet& fvs) override;
     void AssembleMatAIM(const BulkConnPair& bp, const OCP_USI& c, const BulkConnVarSet& bcvs, const Bulk& bk, FluxVarSet& fvs) override { OCP_ABORT("NOT USED!"); }
     void AssembleMatIMPEC(const BulkConnPair& bp, const OCP_USI& c, const BulkConnVarSet& bcvs, const Bulk& bk, FluxVarSet& fvs) override { OCP_ABORT("NOT USED!"); }
+    void CalFluxSFI(const BulkConnPair& bp, const Bulk& bk, const OCP_DBL& vT, FluxVarSet& fvs) override { OCP_ABORT("NOT USED!"); }
+    void AssembleMatSFI(const BulkConnPair& bp, const OCP_USI& c, const BulkConnVarSet& bcvs, const Bulk& bk, FluxVarSet& fvs) override { OCP_ABORT("NOT USED!"); }
 };
 
 
@@ -121,6 +129,8 @@ public:
     void AssembleMatFIM(const BulkConnPair& bp, const OCP_USI& c, const BulkConnVarSet& bcvs, const Bulk& bk, FluxVarSet& fvs) override;
     void AssembleMatAIM(const BulkConnPair& bp, const OCP_USI& c, const BulkConnVarSet& bcvs, const Bulk& bk, FluxVarSet& fvs) override{}
     void AssembleMatIMPEC(const BulkConnPair& bp, const OCP_USI& c, const BulkConnVarSet& bcvs, const Bulk& bk, FluxVarSet& fvs) override{}
+    void CalFluxSFI(const BulkConnPair& bp, const Bulk& bk, const OCP_DBL& vT, FluxVarSet& fvs) override { OCP_ABORT("NOT USED!"); }
+    void AssembleMatSFI(const BulkConnPair& bp, const OCP_USI& c, const BulkConnVarSet& bcvs, const Bulk& bk, FluxVarSet& fvs) override { OCP_ABORT("NOT USED!"); }
 };
 
 
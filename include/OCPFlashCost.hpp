@@ -0,0 +1,66 @@
+/*! \file    OCPFlashCost.hpp
+ *  \brief   OCPFlashCost class declaration
+ *  \author  Shizhe Li
+ *  \date    Oct/16/2026
+ *
+ *-----------------------------------------------------------------------------------
+ *  Copyright (C) 2021--present by the OpenCAEPoroX team. All rights reserved.
+ *  Released under the terms of the GNU Lesser General Public License 3.0 or later.
+ *-----------------------------------------------------------------------------------
+ */
+
+#ifndef __OCPFLASHCOST_HEADER__
+#define __OCPFLASHCOST_HEADER__
+
+#include "OCPConst.hpp"
+
+#include <vector>
+#include <string>
+
+using namespace std;
+
+class Domain;
+
+
+/////////////////////////////////////////////////////////////////////
+// Flash Cost
+/////////////////////////////////////////////////////////////////////
+
+/// Record the flash work spent in each bulk, which is used as the vertex weights
+/// of the graph partition in the next run.
+class FlashCost
+{
+public:
+    /// Allocate memory
+    void Setup(const OCP_USI& nbin) { nb = nbin; cost.resize(nb, 0); }
+    /// Add the cost of one flash: one unit + iterations in PE + existing phases
+    void Add(const OCP_USI& n, const OCP_ULL& iters, const USI& np) { cost[n] += 1 + iters + np; }
+    /// Return total cost of interior bulks
+    OCP_DBL GetLocalCost(const OCP_USI& nbI) const;
+    /// Gather costs of interior bulks and write vertex weights by master process,
+    /// weights are stored in global active order
+    void PrintVertexWeight(const string& file, const Domain& domain) const;
+
+protected:
+    /// num of bulks
+    OCP_USI         nb{ 0 };
+    /// accumulative cost of flash in each bulk
+    vector<OCP_ULL> cost;
+};
+
+
+/// Read vertex weights written by FlashCost, the weights of [begin, end) in global
+/// active order are returned, and OCP_FALSE is returned if file is not matched
+OCP_BOOL ReadVertexWeight(const string& file, const OCP_ULL& numGrid, const OCP_ULL& begin,
+                          const OCP_ULL& end, vector<OCP_INT>& wgt);
+
+
+#endif /* end if __OCPFLASHCOST_HEADER__ */
+
+/*----------------------------------------------------------------------------*/
+/*  Brief Change History of This File                                         */
+/*----------------------------------------------------------------------------*/
+/*  Author              Date             Actions                              */
+/*----------------------------------------------------------------------------*/
+/*  Shizhe Li           Oct/16/2026      Create file                          */
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,134 @@
+/*! \file    OCPHWCounter.hpp
+ *  \brief   OCPHWCounter class declaration
+ *  \author  Shizhe Li
+ *  \date    Oct/16/2026
+ *
+ *  \note    Hardware counters of main kernels read by perf_event_open on Linux,
+ *           which tell if a kernel is bounded by compute or memory
+ *
+ *-----------------------------------------------------------------------------------
+ *  Copyright (C) 2021--present by the OpenCAEPoroX team. All rights reserved.
+ *  Released under the terms of the GNU Lesser General Public License 3.0 or later.
+ *-----------------------------------------------------------------------------------
+ */
+
+#ifndef __OCPHWCOUNTER_HEADER__
+#define __OCPHWCOUNTER_HEADER__
+
+#include "OCPConst.hpp"
+
+#include <mpi.h>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+
+/// Kernels measured by hardware counters
+enum class HWKernel : USI
+{
+    /// Flash of bulks
+    flash,
+    /// Flux and residual
+    flux,
+    /// Assembling of bulks
+    assembleBulk,
+    /// Assembling of wells
+    assembleWell,
+    /// Linear solver
+    linearSolve,
+    /// num of kernels
+    num
+};
+
+
+/////////////////////////////////////////////////////////////////////
+// Hardware Counter
+/////////////////////////////////////////////////////////////////////
+
+
+/// Counters are free-running after Enable, the increments between Begin and End
+/// are accumulated to the kernel, so kernels may be nested.
+class OCPHWCounter
+{
+public:
+    /// Open counters, it is disabled if counters are not available
+    void Enable();
+    /// If counters are used
+    OCP_BOOL IfEnabled() const { return enabled; }
+    /// Begin to measure a kernel
+    void Begin(const HWKernel& k);
+    /// End to measure a kernel
+    void End(const HWKernel& k);
+    /// Gather counters of all processes and write them to dir/HWCounter.out
+    void Output(const string& dir, const MPI_Comm& comm) const;
+
+protected:
+    /// Read all events to val
+    void Read(vector<uint64_t>& val) const;
+    /// Open a group of events, return OCP_FALSE if the leader is not available
+    OCP_BOOL OpenGroup(const vector<uint64_t>& type, const vector<uint64_t>& config);
+
+protected:
+    /// Events read by counters
+    enum Event : USI { cycles, instructions, cacheRef, cacheMiss, fpScalar, fp128, fp256, fp512, numEvent };
+
+    /// If counters are requested, then Output is called by all processes
+    OCP_BOOL                 requested{ OCP_FALSE };
+    OCP_BOOL                 enabled{ OCP_FALSE };
+    /// If floating point events are available
+    OCP_BOOL                 ifFP{ OCP_FALSE };
+    /// file descriptor of leaders and num of events in each group
+    vector<OCP_INT>          leader;
+    vector<USI>              groupSize;
+    /// counts at Begin of each kernel
+    vector<vector<uint64_t>> beginVal;
+    /// counts at End
+    vector<uint64_t>         endVal;
+    /// accumulated counts and calls of each kernel
+    vector<vector<uint64_t>> sumVal;
+    vector<OCP_ULL>          calls;
+    /// buffer for reading
+    mutable vector<uint64_t> readBuf;
+};
+
+
+/// Hardware counters of current process
+extern OCPHWCounter OCP_HWCOUNTER;
+
+
+/// Measure the enclosing scope as a kernel of OCP_HWCOUNTER
+class OCPHWCounterScope
+{
+public:
+    OCPHWCounterScope(const HWKernel& k) : kernel(k), active(OCP_HWCOUNTER.IfEnabled())
+    {
+        if (active) OCP_HWCOUNTER.Begin(kernel);
+    }
+    ~OCPHWCounterScope()
+    {
+        if (active) OCP_HWCOUNTER.End(kernel);
+    }
+
+protected:
+    const HWKernel kernel;
+    const OCP_BOOL active;
+};
+
+
+#define OCP_HWCOUNT_NAME_(a, b) a##b
+#define OCP_HWCOUNT_NAME(a, b)  OCP_HWCOUNT_NAME_(a, b)
+/// Measure the enclosing scope as a kernel
+#define OCP_HWCOUNT(kernel) OCPHWCounterScope OCP_HWCOUNT_NAME(ocpHWCounterScope, __LINE__)(HWKernel::kernel)
+
+
+#endif /* end if __OCPHWCOUNTER_HEADER__ */
+
+/*----------------------------------------------------------------------------*/
+/*  Brief Change History of This File                                         */
+/*----------------------------------------------------------------------------*/
+/*  Author              Date             Actions                              */
+/*----------------------------------------------------------------------------*/
+/*  Shizhe Li           Oct/16/2026      Create file                          */
+/*----------------------------------------------------------------------------*/
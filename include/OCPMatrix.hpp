@@ -62,6 +62,15 @@ public:
     /// return the solution
     auto& GetSolution() { return u; }
 
+public:
+    /// Reduce to the scalar system of the first variable, the equations of rows
+    /// in [0, nr) are combined with weights which decouple the first variable in
+    /// diagonal blocks, only the first equation is kept for other rows
+    void ReduceToFirst(const OCP_USI& nr);
+    /// Reduce to the block system of other variables in rows [0, nr), columns in
+    /// [nr, nr + nd) are dropped and the following ones are shifted by nd
+    void ReduceToOthers(const OCP_USI& nr, const OCP_USI& nd);
+
 public:
     /// output A and b to files
     void OutputLinearSystem(const Domain* domain, const string& dir, const string& fileA, const string& fileb) const;
@@ -39,6 +39,7 @@ public:
     virtual OCP_DBL CalXi(const OCP_DBL& P, const OCP_DBL& Pb, const OCP_DBL& T, const OCP_DBL* z, const PhaseType& pt) = 0;
     virtual OCP_DBL CalRho(const OCP_DBL& P, const OCP_DBL& Pb, const OCP_DBL& T, const OCP_DBL* z, const PhaseType& pt) = 0;
     virtual void OutputIters() const = 0;
+    virtual OCP_ULL GetIters() const = 0;
     virtual OCP_DBL CalEnthalpy(const OCP_DBL& T, const OCP_DBL* zi) const = 0;
     virtual OCP_BOOL IfWellFriend() const = 0;
 
@@ -103,6 +104,7 @@ public:
     }
     OCP_DBL CalEnthalpy(const OCP_DBL& T, const OCP_DBL* zi) const override { OCP_ABORT("Not Used!"); }
     void OutputIters() const override { pmMethod->OutIters(); }
+    OCP_ULL GetIters() const override { return pmMethod->GetIters(); }
     OCP_BOOL IfWellFriend() const override { return pmMethod->IfWellFriend(); }
 
 protected:
@@ -159,6 +161,7 @@ public:
     }
     OCP_DBL CalEnthalpy(const OCP_DBL& T, const OCP_DBL* zi) const override { return pmMethod->CalEnthalpy(T, zi); }
     void OutputIters() const override { return pmMethod->OutIters(); }
+    OCP_ULL GetIters() const override { return pmMethod->GetIters(); }
     OCP_BOOL IfWellFriend() const override { return pmMethod->IfWellFriend(); }
 
 
@@ -61,6 +61,8 @@ public:
     virtual OCP_DBL CalRho(const OCP_DBL& P, const OCP_DBL& T, const OCP_DBL* z, const PhaseType& pt) = 0;
     /// OutPut total flash iterations during the simulation
     virtual void OutIters() const { PE.OutMixtureIters(); }
+    /// Return total flash iterations during the simulation
+    virtual OCP_ULL GetIters() const { return PE.GetTotalIters(); }
     /// if current mixture is friendly to well
     virtual OCP_BOOL IfWellFriend() const = 0;
     /// Input total number of existing phase, return the number of existing phase in PEC
@@ -56,6 +56,8 @@ public:
     virtual OCP_DBL CalRho(const OCP_DBL& P, const OCP_DBL& Pb, const OCP_DBL& T, const OCP_DBL* z, const PhaseType& pt) = 0;
     /// Output iterations
     virtual void OutIters() const { }
+    /// Return iterations
+    virtual OCP_ULL GetIters() const { return 0; }
     /// If current method is friendly to well
     virtual OCP_BOOL IfWellFriend() const = 0;
     /// Calculate Enthalpy
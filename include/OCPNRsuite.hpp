@@ -44,6 +44,45 @@ enum class OCPNRStateC : USI
 };
 
 
+/// Values of several global checks packed into one MPI_MAX reduction, values to be
+/// minimized are packed with negative sign. The reduction can be started early and
+/// completed when its results are needed.
+class OCPNRreduce
+{
+public:
+    /// Setup communicator
+    void Setup(const MPI_Comm& comm) { myComm = comm; }
+    /// Remove packed values, a pending reduction is completed first
+    void Clear();
+    /// Pack a value whose max over processes is needed, return its position
+    USI PackMax(const OCP_DBL& v);
+    /// Pack a value whose min over processes is needed, return its position
+    USI PackMin(const OCP_DBL& v);
+    /// Start the reduction of packed values
+    void Start();
+    /// Complete the reduction
+    void Wait();
+    /// Reduce packed values
+    void Reduce() { Start(); Wait(); }
+    /// If a reduction is started but not completed
+    OCP_BOOL IfPending() const { return request != MPI_REQUEST_NULL; }
+    /// Get the global max of value at i
+    OCP_DBL GetMax(const USI& i) const { return global[i]; }
+    /// Get the global min of value at i
+    OCP_DBL GetMin(const USI& i) const { return -global[i]; }
+
+protected:
+    /// Communicator
+    MPI_Comm        myComm{ MPI_COMM_NULL };
+    /// packed local values
+    vector<OCP_DBL> local;
+    /// reduced values
+    vector<OCP_DBL> global;
+    /// request of non-blocking reduction
+    MPI_Request     request{ MPI_REQUEST_NULL };
+};
+
+
 /// NR dataset for nonlinear solution
 class OCPNRsuite
 {
@@ -70,6 +109,20 @@ protected:
 public:
     /// residual
     OCPNRresidual   res;
+    /// Start the reduction of initial residual, which is completed by WaitRes0
+    void StartRes0();
+    /// Complete the reduction of initial residual
+    void WaitRes0();
+    /// If the reduction of initial residual is not completed
+    OCP_BOOL IfRes0Pending() const { return res0Reduce.IfPending(); }
+    /// Set the merit of globalization with the current residual
+    void InitMerit0();
+
+protected:
+    /// Reduction of initial residual
+    OCPNRreduce     res0Reduce;
+    /// global max of residual of the last accepted iterate, the merit of globalization
+    OCP_DBL         merit0{ 0 };
 
 
     // between NR-step
@@ -173,6 +226,10 @@ protected:
 public:
     /// Calculate CFL number
     void CalCFL(const Reservoir& rs, const OCP_DBL& dt, const OCP_BOOL& ifComm);
+    /// Calculate CFL number of multirate transport, bulks with ifSub take sub-steps of
+    /// dt, the others take nsub * dt in one step
+    void CalCFL(const Reservoir& rs, const OCP_DBL& dt, const vector<OCP_BOOL>& ifSub,
+                const USI& nsub, const OCP_BOOL& ifComm);
     /// Get maxCFL
     OCP_DBL GetMaxCFL() const { return maxCFL; }
     /// Get CFL
@@ -191,11 +248,79 @@ protected:
 
     // Check
 public:
-    OCP_BOOL CheckPhysical(Reservoir& rs, const initializer_list<string>& il, const OCP_DBL& dt) const;
+    /// Check physical quantities over all processes, CFL is reduced together if checked
+    OCP_BOOL CheckPhysical(Reservoir& rs, const initializer_list<string>& il, const OCP_DBL& dt);
+    /// Check physical quantities locally, the state is reduced with other checks by
+    /// PackWorkState and UnpackWorkState
+    OCP_BOOL CheckPhysicalLoc(Reservoir& rs, const initializer_list<string>& il, const OCP_DBL& dt);
+    /// Pack the state of physical check, return its position
+    USI PackWorkState(OCPNRreduce& red) const { return red.PackMax(static_cast<OCP_DBL>(workState)); }
+    /// Unpack the global state of physical check, return if it passes
+    OCP_BOOL UnpackWorkState(const OCPNRreduce& red, const USI& i);
     auto GetWorkState() const { return workState; }
+    /// Get reduction of global checks
+    OCPNRreduce& GetReduce() { return reduce; }
+
+protected:
+    OCPNRStateP workState;
+    /// Reduction of global checks
+    OCPNRreduce reduce;
+
+
+    // Globalization
+public:
+    /// Save the iterate before Newton update for line search
+    void SaveIterate(const Reservoir& rs);
+    /// Save the Newton update, trial iterates are the saved one plus a part of update
+    void SaveUpdate(const Reservoir& rs);
+    /// Set a trial iterate with a cut step if the physical check fails or merit does not
+    /// decrease sufficiently, return if the step is cut
+    OCP_BOOL CutStep(Reservoir& rs, const OCP_BOOL& pass, const OCP_BOOL& converge,
+                     const OCP_DBL& merit, const USI& maxCut, const OCP_DBL& c);
+    /// Get step length of current iterate
+    OCP_DBL GetStepLength() const { return alpha; }
+    /// Get num of step cuts within a time step
+    USI GetNumCut() const { return numCut; }
+    /// Update radius of trust region with merit of new iterate
+    void UpdateTrustRegion(const OCP_DBL& merit, const OCP_DBL& rmin);
+    /// Get radius of trust region
+    OCP_DBL GetTRradius() const { return trRadius; }
+
+protected:
+    /// Set the saved iterate plus alpha times the update
+    void SetIterate(Reservoir& rs);
+
+protected:
+    /// P, Ni, S, xij and well pressure of the saved iterate
+    vector<OCP_DBL> x0P, x0N, x0S, x0X, x0W;
+    /// Newton update of P, Ni, S, xij and well pressure
+    vector<OCP_DBL> dxP, dxN, dxS, dxX, dxW;
+    /// step length of current iterate
+    OCP_DBL         alpha{ 1 };
+    /// num of step cuts in current Newton iteration
+    USI             numCutNR{ 0 };
+    /// num of step cuts within a time step
+    USI             numCut{ 0 };
+    /// radius of trust region, as a fraction of dPmax and dSmax
+    OCP_DBL         trRadius{ 1 };
+
+
+    // Initial guess
+public:
+    /// Save the converged state at time t as the newest history, history before tw is dropped
+    void SaveHistory(const Reservoir& rs, const OCP_DBL& t, const OCP_DBL& tw);
+    /// Extrapolate P, Ni, T and well pressure at the end of dt from history with given
+    /// order, changes are scaled by one factor so that dP <= dPmax and Ni is not
+    /// reduced by more than 30%, return if the state is changed
+    OCP_BOOL Extrapolate(Reservoir& rs, const OCP_DBL& dt, const USI& order, const OCP_DBL& dPmax) const;
 
 protected:
-    mutable OCPNRStateP workState;
+    /// max num of states in history
+    static const USI        numHis{ 3 };
+    /// times of history, the newest first
+    vector<OCP_DBL>         hisTime;
+    /// P, Ni, T and well pressure of history, the newest first
+    vector<vector<OCP_DBL>> hisP, hisN, hisT, hisW;
 
 
     // Iterations
@@ -16,9 +16,11 @@
 #include <iomanip>
 #include <iostream>
 #include <cstdio>
+#include <functional>
 
 // OpenCAEPoroX header files
 #include "OCPControl.hpp"
+#include "OCPSummaryBin.hpp"
 #include "Output4Vtk.hpp"
 #include "ParamOutput.hpp"
 #include "Reservoir.hpp"
@@ -157,12 +159,44 @@ public:
     /// Combine all files into 1 by Master process
     void PostProcess(const string& dir, const string& filename, const OCP_INT& numproc) const;
 
+    /// Setup binary summary, which is written by master process at each time step
+    void SetupBinary(const string& dir, const MPI_Comm& comm);
+
+    /// Start gathering values of current time step for binary summary, the
+    /// gather is completed in the next time step
+    void PrintBinary();
+
+    /// Complete the pending gather and append the record to binary summary
+    void FinishBinary();
+
 protected:
     void SetupOutputTerm(const OutputSummary& summary_param);
+    /// If the item is owned by all processes, otherwise it is a well item
+    static OCP_BOOL IfCommonItem(const string& item);
 
 protected:
     vector<SumItem> Sumdata; ///< Contains all information to be printed.
 
+    /// If binary summary is used
+    OCP_BOOL         useBinary{ OCP_FALSE };
+    MPI_Comm         binComm{ MPI_COMM_NULL };
+    OCP_INT          binNumproc, binRank;
+    /// num of common items, which are in the front of Sumdata
+    USI              numCommon;
+    /// length and displacement of row of each process (master process)
+    vector<OCP_INT>  binLen, binDispls;
+    /// column in binary summary of each value in gathered rows, -1 for repeated
+    /// items (master process)
+    vector<OCP_INT>  binCol;
+    /// gathered rows and the record to be written (master process)
+    vector<OCP_DBL>  binRecv, binRecord;
+    /// local row
+    vector<OCP_DBL>  binRow;
+    /// request of the pending gather
+    MPI_Request      binReq{ MPI_REQUEST_NULL };
+    /// writer of binary summary (master process)
+    SummaryBinWriter binWriter;
+
     OCP_BOOL FPR{OCP_FALSE};  ///< Field average Pressure.
     OCP_BOOL FTR{OCP_FALSE};  ///< Field average Temperature.
     OCP_BOOL FOPR{OCP_FALSE}; ///< Field oil production rate.
@@ -215,6 +249,37 @@ private:
     vector<SumItem> Sumdata;
 };
 
+
+/// Performance record of each time step, appended to PerfLog.csv or PerfLog.jsonl
+/// by master process for automatic analysis.
+class PerfLog
+{
+public:
+    /// Setup file and communicator, fmt is csv or jsonl
+    void Setup(const string& dir, const string& fmt, const MPI_Comm& comm);
+    /// Record current time step, wallTime is the wall time since the beginning
+    void SetVal(const OCPControl& ctrl, const OCPNRsuite& NRs, const ItersInfo& iters, const OCP_DBL& wallTime);
+
+protected:
+    /// If performance log is used
+    OCP_BOOL        useLog{ OCP_FALSE };
+    /// If JSON lines are written, otherwise CSV
+    OCP_BOOL        jsonl{ OCP_FALSE };
+    MPI_Comm        myComm{ MPI_COMM_NULL };
+    OCP_INT         numproc, myrank;
+    /// accumulated timers and wall time at last time step
+    vector<OCP_DBL> lastVal;
+    /// accumulated num of fallbacks at last time step
+    OCP_USI         lastFallback{ 0 };
+    /// values of current time step of current process
+    vector<OCP_DBL> localVal;
+    /// values of current time step of all processes (master process)
+    vector<OCP_DBL> allVal;
+    /// PerfLog file (master process)
+    ofstream        outF;
+};
+
+
 /// ToDo
 class OutGridVar
 {
@@ -301,7 +366,7 @@ class Out4VTK
 {
 public:
     /// Input Params about vtk output
-    void Setup(const OutputVTKParam& VTKParam, const string& dir, const Reservoir& rs);
+    void Setup(const OutputVTKParam& VTKParam, const OCPControl& ctrl, const string& dir, const Reservoir& rs);
     /// Output info with the vtk format
     void PrintVTK(const Reservoir& rs, const OCPControl& ctrl) const;
     /// Combine all files into 1 by Master process
@@ -309,8 +374,15 @@ public:
 
 protected:
     void Initialize(const string& dir, const Reservoir& rs);
+    /// Pass each grid variable of current domain to op(name, data type, values)
+    void CollectGridVal(const Reservoir& rs, const OCPControl& ctrl,
+                        const function<void(const string&, const string&, const vector<OCP_DBL>&)>& op) const;
+    /// Each process outputs its own piece of vtu, master process outputs the index
+    void PrintVTU(const Reservoir& rs, const OCPControl& ctrl) const;
     void PostProcessP(const string& dir, const string& filename, const OCP_INT& numproc) const;
     void PostProcessS(const string& dir, const string& filename) const;
+    /// Output values of all variables in one time step, each of which has numGrid values
+    void OutputCellData(ofstream& dest, const vector<OCP_DBL>& gridVal) const;
 
 protected:
     OCP_BOOL          useVTK{OCP_FALSE}; ///< If use vtk
@@ -323,6 +395,21 @@ protected:
 
     /// total number of grids
     mutable OCP_ULL   numGrid;
+    /// num of processes used to merge the temporary files
+    OCP_INT           numMergeProc{ 1 };
+
+    /// If each process outputs its own vtu piece instead of merging by master
+    OCP_BOOL          useVTU{ OCP_FALSE };
+    /// work dir
+    string            workDir;
+    /// Geometry of grids in current process
+    VtuPiece          piece;
+    /// (time, pvtu file) of each printed time step, used by master process
+    mutable vector<pair<OCP_DBL, string>> vtuSeries;
+    /// Writer of files in background
+    mutable OCPAsyncWriter writer;
+    MPI_Comm          myComm{ MPI_COMM_NULL };
+    OCP_INT           numproc, myrank;
 };
 
 /// The OCPOutput class manages different kinds of ways to output information.
@@ -364,6 +451,7 @@ protected:
     ItersInfo    iters;
     Summary      summary;
     CriticalInfo crtInfo;
+    PerfLog      perfLog;
     Out4VTK      out4VTK;
     // Out4RPT      out4RPT;
 };
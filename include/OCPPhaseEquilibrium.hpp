@@ -308,6 +308,8 @@ protected:
 public:
     /// Print the number of iterations used in PE in total
     void OutMixtureIters() const;
+    /// Return the number of iterations used in PE in total
+    OCP_ULL GetTotalIters() const { return itersSSMSTA + itersNRSTA + itersSSMSP + itersNRSP + itersRR; }
 
 protected:
     /// total iterations for SSMSTA
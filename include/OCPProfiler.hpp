@@ -0,0 +1,133 @@
+/*! \file    OCPProfiler.hpp
+ *  \brief   OCPProfiler class declaration
+ *  \author  Shizhe Li
+ *  \date    Oct/16/2026
+ *
+ *  \note    Nested named regions timed in each process, summarized in a table and
+ *           exported as a Chrome trace (chrome://tracing, ui.perfetto.dev)
+ *
+ *-----------------------------------------------------------------------------------
+ *  Copyright (C) 2021--present by the OpenCAEPoroX team. All rights reserved.
+ *  Released under the terms of the GNU Lesser General Public License 3.0 or later.
+ *-----------------------------------------------------------------------------------
+ */
+
+#ifndef __OCPPROFILER_HEADER__
+#define __OCPPROFILER_HEADER__
+
+#include "OCPConst.hpp"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+
+/////////////////////////////////////////////////////////////////////
+// Profiler
+/////////////////////////////////////////////////////////////////////
+
+
+/// Region based profiler, regions are nested by the calling order and are timed
+/// only if the profiler is enabled. It is used by the main thread only.
+class OCPProfiler
+{
+    using Clock = std::chrono::steady_clock;
+
+public:
+    /// Enable profiler, trace events are recorded if ifTrace is true
+    void Enable(const OCP_BOOL& ifTrace);
+    /// If profiler is enabled
+    OCP_BOOL IfEnabled() const { return enabled; }
+    /// Enter a region nested in the current region, name must be a literal
+    void Begin(const char* name);
+    /// Leave the current region
+    void End();
+    /// Write the region table and the trace of current process to dir
+    void Output(const string& dir, const OCP_INT& rank) const;
+
+protected:
+    /// Return the child of the current region with the name, create it if not found
+    USI  GetChild(const char* name);
+    /// Write the region table
+    void OutputTable(const string& file) const;
+    /// Write the Chrome trace
+    void OutputTrace(const string& file, const OCP_INT& rank) const;
+
+protected:
+    /// Accumulated info of a region in the calling tree
+    class Region
+    {
+    public:
+        Region(const char* n, const USI& p) : name(n), parent(p) {};
+        const char* name;
+        USI         parent;
+        vector<USI> child;
+        OCP_ULL     count{ 0 };
+        OCP_DBL     total{ 0 };  ///< unit: second
+        OCP_DBL     minT{ 0 };
+        OCP_DBL     maxT{ 0 };
+    };
+    /// A complete region call in the trace
+    class Event
+    {
+    public:
+        Event(const USI& r, const OCP_DBL& b, const OCP_DBL& d) : region(r), begin(b), dur(d) {};
+        USI     region;
+        OCP_DBL begin;  ///< unit: microsecond
+        OCP_DBL dur;    ///< unit: microsecond
+    };
+
+    OCP_BOOL                  enabled{ OCP_FALSE };
+    OCP_BOOL                  trace{ OCP_FALSE };
+    /// regions[0] is the root
+    vector<Region>            regions;
+    /// current regions and their begin time
+    vector<USI>               stack;
+    vector<Clock::time_point> beginTime;
+    /// begin of profiling
+    Clock::time_point         startTime;
+    vector<Event>             events;
+    /// events beyond the limit are dropped to bound the memory
+    static const OCP_ULL      maxEvents = 1 << 22;
+};
+
+
+/// Profiler of current process
+extern OCPProfiler OCP_PROFILER;
+
+
+/// Time the enclosing scope as a region of OCP_PROFILER
+class OCPProfileScope
+{
+public:
+    OCPProfileScope(const char* name) : active(OCP_PROFILER.IfEnabled())
+    {
+        if (active) OCP_PROFILER.Begin(name);
+    }
+    ~OCPProfileScope()
+    {
+        if (active) OCP_PROFILER.End();
+    }
+
+protected:
+    const OCP_BOOL active;
+};
+
+
+#define OCP_PROFILE_NAME_(a, b) a##b
+#define OCP_PROFILE_NAME(a, b)  OCP_PROFILE_NAME_(a, b)
+/// Time the enclosing scope as a named region
+#define OCP_PROFILE(name) OCPProfileScope OCP_PROFILE_NAME(ocpProfileScope, __LINE__)(name)
+
+
+#endif /* end if __OCPPROFILER_HEADER__ */
+
+/*----------------------------------------------------------------------------*/
+/*  Brief Change History of This File                                         */
+/*----------------------------------------------------------------------------*/
+/*  Author              Date             Actions                              */
+/*----------------------------------------------------------------------------*/
+/*  Shizhe Li           Oct/16/2026      Create file                          */
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,103 @@
+/*! \file    OCPSummaryBin.hpp
+ *  \brief   OCPSummaryBin class declaration
+ *  \author  Shizhe Li
+ *  \date    Oct/16/2026
+ *
+ *-----------------------------------------------------------------------------------
+ *  Copyright (C) 2021--present by the OpenCAEPoroX team. All rights reserved.
+ *  Released under the terms of the GNU Lesser General Public License 3.0 or later.
+ *-----------------------------------------------------------------------------------
+ */
+
+#ifndef __OCPSUMMARYBIN_HEADER__
+#define __OCPSUMMARYBIN_HEADER__
+
+#include "OCPConst.hpp"
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+
+/////////////////////////////////////////////////////////////////////
+// Binary Summary
+/////////////////////////////////////////////////////////////////////
+
+//  File layout:
+//    "OCPSUMB1"                          8 chars
+//    numItem                             uint32
+//    Item, Obj, Unit of each item        uint32 length + chars
+//    records                             numItem doubles per time step
+//  Records are appended and flushed at each time step, an incomplete record at
+//  the end of file is ignored by the reader.
+
+/// Descriptor of an item in binary summary
+class SumBinItem
+{
+public:
+    SumBinItem() = default;
+    SumBinItem(const string& item, const string& obj, const string& unit)
+        : Item(item)
+        , Obj(obj)
+        , Unit(unit){};
+    string Item;
+    string Obj;
+    string Unit;
+};
+
+
+/// Append records of summary to a binary file
+class SummaryBinWriter
+{
+public:
+    /// Create file and write the header
+    void Open(const string& file, const vector<SumBinItem>& items);
+    /// Append the values of one time step
+    void Write(const vector<OCP_DBL>& record);
+    /// If file is open
+    OCP_BOOL IfOpen() const { return outF.is_open(); }
+
+protected:
+    ofstream outF;
+    USI      numItem{ 0 };
+};
+
+
+/// Read selected items from a binary summary file
+class SummaryBinReader
+{
+public:
+    /// Read the header, return OCP_FALSE if file is not a binary summary
+    OCP_BOOL Open(const string& file);
+    /// Return descriptors of all items
+    const auto& GetItems() const { return items; }
+    /// Return num of complete records
+    auto GetNumRecord() const { return numRecord; }
+    /// Return index of item, -1 if not found; obj is ignored if it is empty
+    OCP_INT FindItem(const string& item, const string& obj) const;
+    /// Read values of selected items at all time steps, only the selected values
+    /// are read from each record
+    void ReadColumns(const vector<USI>& cols, vector<vector<OCP_DBL>>& vals);
+
+protected:
+    ifstream           inF;
+    vector<SumBinItem> items;
+    /// position of the first record
+    streamoff          headLen{ 0 };
+    /// num of complete records
+    uint64_t           numRecord{ 0 };
+};
+
+
+#endif /* end if __OCPSUMMARYBIN_HEADER__ */
+
+/*----------------------------------------------------------------------------*/
+/*  Brief Change History of This File                                         */
+/*----------------------------------------------------------------------------*/
+/*  Author              Date             Actions                              */
+/*----------------------------------------------------------------------------*/
+/*  Shizhe Li           Oct/16/2026      Create file                          */
+/*----------------------------------------------------------------------------*/
@@ -15,6 +15,8 @@
 #define __OCPTIMERECORD_HEADER__
 
 #include "OCPConst.hpp"
+#include "OCPProfiler.hpp"
+#include "OCPHWCounter.hpp"
 
 // unit : second
 extern OCP_DBL OCPTIME_TOTAL;				///< Time for Total Simulation
@@ -39,6 +41,7 @@ extern OCP_DBL OCPTIME_LSOLVER_DDM;         ///< Time for Linear Solver of DDM
 extern OCP_USI OCPITER_NR_DDM;              ///< Total iters for NR of DDM
 extern OCP_USI OCPITER_NRW_DDM;             ///< Total wasted iters for NR of DDM
 extern OCP_USI OCPITER_LS_DDM;              ///< Total iters for LS of DDM
+extern OCP_USI OCPITER_SFI_FIM;             ///< Total time steps of SFI restarted by FIM
 
 #endif
 
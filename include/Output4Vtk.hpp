@@ -15,6 +15,8 @@
 #include <fstream>
 #include <string>
 #include <vector>
+#include <utility>
+#include <mpi.h>
 
 using namespace std;
 
@@ -54,6 +56,27 @@ const string VTK_UNSIGNED_INT = "unsigned_int";
 const string VTK_INT          = "int";
 
 
+/// Geometry of grids owned by a process, points are numbered locally
+class VtuPiece
+{
+public:
+    vector<OCP_SIN> points;       ///< x,y,z coordinates
+    vector<OCP_ULL> connectivity; ///< points index of cells
+    vector<OCP_ULL> offsets;      ///< end of each cell in connectivity
+    vector<USI>     types;        ///< type of cells
+};
+
+
+/// Cell data in a vtu file
+class VtuArray
+{
+public:
+    string          name;         ///< name of data
+    string          type;         ///< data type in XML format, such as Float64
+    vector<char>    data;         ///< raw data
+};
+
+
 template <typename T>
 void SwapEnd(T* var, const OCP_ULL len)
 {
@@ -85,6 +108,21 @@ public:
     static void OutputGridInfo(const string& dir, const OCP_ULL& nG, const vector<OCP_SIN>& points_xyz,
                                const vector<OCP_ULL>& cell_points, const vector<USI>& cell_type);
 
+public:
+    /// Send the geometry of grids to the process which owns them, gIndex contains
+    /// the global index of grids of current process
+    void ScatterGridInfo(const string& dir, const vector<OCP_ULL>& gIndex, const OCP_ULL& nG,
+                         const MPI_Comm& comm, VtuPiece& piece) const;
+    /// Convert cell values to the data type and append them to cellData
+    void AddCellArray(vector<VtuArray>& cellData, const string& dataName, string dataType,
+                      const vector<OCP_DBL>& tmpV, const OCP_ULL& nb) const;
+    /// Output a piece in XML format with appended raw binary data
+    static void OutputVTU(const string& myFile, const VtuPiece& piece, const vector<VtuArray>& cellData);
+    /// Output the index of pieces
+    static void OutputPVTU(const string& myFile, const vector<string>& pieces, const vector<VtuArray>& cellData);
+    /// Output the collection of time steps, each item is (time, file)
+    static void OutputPVD(const string& myFile, const vector<pair<OCP_DBL, string>>& series);
+
 protected:
     OCP_ULL InitASCII(const string& dir, const string& myFile, const string& shortInfo) const;
     OCP_ULL InitBINARY(const string& dir, const string& myFile, const string& shortInfo) const;
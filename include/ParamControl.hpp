@@ -55,6 +55,14 @@ public:
     vector<string>     method{ "FIM" };
     /// linear solver input file for methods
     vector<string>     lsFile{ "bsr.fasp" };
+    /// linear solver input file for the transport stage of SFI, the first one is used if empty
+    string             lsFileT;
+    /// CFL making a bulk implicit and explicit again in AIMc
+    vector<OCP_DBL>    aimCFL{ 0.8, 0.8 };
+    /// Relative volume error making a bulk implicit in AIMc
+    OCP_DBL            aimVe{ 1E-3 };
+    /// Num of neighbor layers of implicit bulks in AIMc
+    USI                aimLayer{ 2 };
     /// Tuning set.
     vector<TuningPair> tuning_T;  
     /// Tuning.
@@ -20,6 +20,7 @@
 #include "PreParamGridWell.hpp"
 #include "UtilTiming.hpp"
 #include "OCPTimeRecord.hpp"
+#include "OCPFlashCost.hpp"
 
 // ParMetis
 #define rabs fabsf     // conflict with fasp
@@ -30,6 +31,9 @@
 #include <algorithm>
 #include <set>
 #include <map>
+#include <sstream>
+#include <iomanip>
+#include <cstdint>
 
 using namespace std;
 
@@ -45,10 +49,16 @@ class Partition
 public:
 
 	void InitMPI(MPI_Comm comm);
+	/// Set the file of vertex weights, which is written by FlashCost in previous run
+	void SetVertexWeightFile(const string& file) { vwgtFile = file; }
+	/// Set the directory of cached partitions and the file of external partition
+	void SetPartitionFile(const string& cacheDir, const string& inFile) { ptnCacheDir = cacheDir; ptnInFile = inFile; }
 	void SetPartition(const PreParamGridWell& grid);
 	void SetDistribution();
 	
 protected:
+	/// Setup the initial graph from the slab of each process (distributed input)
+	void SetInitGraphDist(const PreParamGridWell& grid);
 	void CalPartition(const PreParamGridWell& grid);
 	/// Conduct orthogonal partitioning of the structural reservoir grid in the x-y plane, 
 	/// ensuring that the wells are vertical.
@@ -56,6 +66,16 @@ protected:
 	/// using parMetis
 	void CalPartitionParMetis();
 	void InitParam();
+	/// Read vertex weights of local vertices, wells have unit weight
+	void SetVertexWeight();
+	/// Calculate the hash of the distributed graph (vertex weights are included)
+	uint64_t CalGraphHash() const;
+	/// Read partition from the cache file, return OCP_FALSE if it does not match
+	OCP_BOOL ReadCachedPartition(const string& file, const uint64_t& key);
+	/// Write partition to the cache file
+	void WriteCachedPartition(const string& file, const uint64_t& key) const;
+	/// Read external partition of active grids, wells follow their first perforated grids
+	void ReadExternalPartition();
 
 	MPI_Comm    myComm{ MPI_COMM_NULL };
 	OCP_INT     numproc, myrank;
@@ -87,6 +107,14 @@ protected:
 	idx_t      edgecut;
 	idx_t*     part;
 
+	/// file of vertex weights
+	string     vwgtFile;
+	/// vertex weights of local vertices
+	vector<idx_t> vwgtLocal;
+	/// directory of cached partitions
+	string     ptnCacheDir;
+	/// file of external partition
+	string     ptnInFile;
 
 	// mutable vector<vector<idx_t>> elementCSR;
 	mutable map<OCP_INT, vector<idx_t>> elementCSR;
@@ -18,7 +18,9 @@
 // Standard header files
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <string>
+#include <mpi.h>
 
 // OpenCAEPoroX header files
 #include "OCPConst.hpp"
@@ -61,6 +63,11 @@ class ActiveGridCheck
 public:
     OCP_ULL CheckActivity(const OCPModel& Model, const OCP_DBL& ev, const OCP_DBL& ep,
                           const vector<OCP_DBL>& v, const vector<OCP_DBL>& poro);
+    /// Check the activity of grids stored in current process, [bId, eId) is the slab
+    /// owned by current process, the rest are the neighboring layers of other process.
+    OCP_ULL CheckActivitySlab(const OCPModel& Model, const OCP_DBL& ev, const OCP_DBL& ep,
+                              const vector<OCP_DBL>& v, const vector<OCP_DBL>& poro,
+                              const OCP_ULL& bId, const OCP_ULL& eId, MPI_Comm comm);
     OCP_BOOL IfFluid(const OCP_ULL& n, const OCP_DBL& poro);
     void FreeAll2Act();
 
@@ -79,6 +86,10 @@ public:
     vector<OCP_ULL> map_Act2All;
     /// Mapping from grid to active all grid
     vector<OCP_SLL> map_All2Act;
+    /// global index of the first active grid in slab (distributed input only)
+    OCP_ULL         activeGridBegin{ 0 };
+    /// number of active grid in slab (distributed input only)
+    OCP_ULL         activeGridLocal{ 0 };
 
 protected:
     /// model for check
@@ -91,6 +102,7 @@ protected:
 protected:
     void CheckActivityIsoT(const vector<OCP_DBL>& v, const vector<OCP_DBL>& poro);
     void CheckActivityT(const vector<OCP_DBL>& v, const vector<OCP_DBL>& poro);
+    OCP_BOOL IfActive(const OCP_ULL& n, const vector<OCP_DBL>& v, const vector<OCP_DBL>& poro) const;
 };
 
 
@@ -229,6 +241,10 @@ class PreParamGridWell
 public:
     /// Input params files
     void InputFile(const string& myFile, const string& myWorkdir);
+    /// Input params files by all processes, each process stores its own slab only
+    void InputFileDist(const string& myFile, const string& myWorkdir, MPI_Comm comm);
+    /// If grid is input and set up by all processes
+    OCP_BOOL IfDistInput() const { return distInput; }
 
 protected:
     void Input(const string& myFilename);
@@ -273,13 +289,20 @@ protected:
     vector<USI>* FindPtr(const string& varName, const USI&);
     /// It's used in InputEQUALS, assigning values in batches.
     template <typename T>
-    void setVal(vector<T>& obj, const T& val, const vector<USI>& index);
+    void setVal(vector<T>& obj, const T& val, const vector<USI>& index,
+                const OCP_ULL& bId, const OCP_ULL& eId);
     /// It's used in InputCOPY, copying the value of one variable to another.
     template <typename T>
-    void CopyVal(vector<T>& obj, const vector<T>& src, const vector<USI>& index);
+    void CopyVal(vector<T>& obj, const vector<T>& src, const vector<USI>& index,
+                 const OCP_ULL& bId, const OCP_ULL& eId);
     /// It's used in InputMULTIPLY, multipling the value of a certain range of a
     /// variable by a coefficient.
-    void MultiplyVal(vector<OCP_DBL>& obj, const OCP_DBL& val, const vector<USI>& index);
+    void MultiplyVal(vector<OCP_DBL>& obj, const OCP_DBL& val, const vector<USI>& index,
+                     const OCP_ULL& bId, const OCP_ULL& eId);
+    /// Return the range [bId, eId) of grid index stored for varName in current process
+    void GetStoredRange(const string& varName, OCP_ULL& bId, OCP_ULL& eId) const;
+    /// Return the num of grids stored in current process
+    OCP_ULL NumGridStored() const { return distInput ? winEnd - winBegin : numGrid; }
 
 
 protected:
@@ -372,6 +395,8 @@ protected:
 
 public:
     void Setup();
+    /// Setup grids and wells in slab owned by current process
+    void SetupDist();
 
 protected:
     /// Setup grids
@@ -425,6 +450,14 @@ protected:
     /// Setup Transmissibility multipliers
     void SetupTransMult();
 
+    // For distributed input (orthogonal grid only)
+    /// Calculate the depth and volume of slab for orthogonal grid.
+    void CalDepthVOrthogonalGridDist();
+    /// Setup the neighboring info of slab for an orthogonal grid.
+    void SetupActiveConnOrthogonalGridDist();
+    /// Setup Transmissibility multipliers of slab
+    void SetupTransMultDist();
+
 
 protected:
     /// Volume of cells
@@ -439,6 +472,24 @@ protected:
     /// Num of active grid.
     OCP_ULL                  activeGridNum;
 
+    /////////////////////////////////////////////////////////////////////
+    // Distributed input
+    /////////////////////////////////////////////////////////////////////
+
+protected:
+    /// If grid is input and set up by all processes, each one owns a slab of grid
+    OCP_BOOL        distInput{ OCP_FALSE };
+    /// communicator for distributed input
+    MPI_Comm        distComm{ MPI_COMM_NULL };
+    /// the first grid(natural index) of slab owned by current process
+    OCP_ULL         slabBegin{ 0 };
+    /// the last grid(natural index, excluded) of slab owned by current process
+    OCP_ULL         slabEnd{ 0 };
+    /// the first grid stored in current process: slab and one layer above it
+    OCP_ULL         winBegin{ 0 };
+    /// the last grid(excluded) stored in current process: slab and one layer below it
+    OCP_ULL         winEnd{ 0 };
+
     /////////////////////////////////////////////////////////////////////
     // Dual Porosity Option
     /////////////////////////////////////////////////////////////////////
@@ -460,6 +511,8 @@ protected:
 protected:
     /// Setup connections between wells and active grids
     void SetupConnWellGrid();
+    /// Setup connections between wells and active grids in slab
+    void SetupConnWellGridDist();
     /// Return the index of bulk perforated by well
     OCP_ULL GetPerfLocation(const WellParam& well, const USI& p);
 
@@ -17,6 +17,7 @@
 #include "PreParamGridWell.hpp"
 #include "Partition.hpp"
 #include "Domain.hpp"
+#include "OCPControlFast.hpp"
 #include "UtilTiming.hpp"
 #include "OCPTimeRecord.hpp"
 
@@ -31,7 +32,7 @@ class PreProcess
 
 public:
 
-	PreProcess(const string& myFile);
+	PreProcess(const USI& argc, const char* argv[]);
 
 protected:
 
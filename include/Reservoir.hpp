@@ -73,6 +73,7 @@ class Reservoir
     friend class IsoT_FIM;
     friend class IsoT_AIMc;
     friend class IsoT_FIMddm;
+    friend class IsoT_SFI;
     friend class T_FIM;
     friend class Solver;
 
@@ -91,6 +92,8 @@ protected:
     void SetupDomain(Domain& myDomain) { swap(domain, myDomain); }
     /// Grid-based, Conn-based
     void SetupDistParamGrid(PreParamGridWell& prepro);
+    /// Grid-based, Conn-based, get them from the processes owning the slabs
+    void SetupDistParamGridSlab(PreParamGridWell& prepro, const VarInfoGrid& varInfo);
     /// Well-based
     void SetupDistParamOthers(const ParamRead& param);
 
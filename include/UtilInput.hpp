@@ -30,11 +30,12 @@ using namespace std;
               << __FILE__;
 
 /// Map_str2int is used to map string to integer, which used to match the keyword
-/// efficiently in input file in the switch structure.
-constexpr inline long long Map_Str2Int(const char* mystr, const USI& len)
+/// efficiently in input file in the switch structure. It wraps around for strings
+/// longer than 8 characters.
+constexpr inline unsigned long long Map_Str2Int(const char* mystr, const USI& len)
 {
-    long long res = 0;
-    long long t   = 100;
+    unsigned long long res = 0;
+    unsigned long long t   = 100;
     for (USI i = 0; i < len; i++) {
         res += (int)mystr[len - 1 - i] * t;
         t *= 100;
@@ -18,6 +18,8 @@
 #include <sstream>
 #include <string>
 #include <vector>
+#include <functional>
+#include <future>
 
 // OpenCAEPoroX header files
 #include "OCPConst.hpp"
@@ -43,6 +45,26 @@ string GetIJKformat(const string& i, const string& j, const string& k, const USI
 
 string GetIJKformat(const USI& i, const USI& j, const USI& k, const USI& s);
 
+
+/// Run output tasks in a background thread one after another. A new task waits for
+/// the previous one, so only one staging buffer is alive. Tasks must own the data to
+/// be written and must not call MPI.
+class OCPAsyncWriter
+{
+public:
+    ~OCPAsyncWriter() { Wait(); }
+    /// Set if tasks are run in background
+    void SetAsync(const OCP_BOOL& flag) { ifAsync = flag; }
+    /// Run task in background if async, otherwise run it directly
+    void Launch(function<void()> task);
+    /// Wait for the running task
+    void Wait();
+
+protected:
+    OCP_BOOL     ifAsync{ OCP_FALSE };
+    future<void> running;
+};
+
 #endif /* end if __UTILOUTPUT_HEADER__ */
 
 /*----------------------------------------------------------------------------*/
@@ -80,6 +80,8 @@ public:
     virtual OCP_DBL CalMaxChangeTime() const = 0;
     /// Calculate max change of well pressure between two NR step
     virtual OCP_DBL CalMaxChangeNR() = 0;
+    /// Set well pressure and that at last NR step within a time step
+    virtual void SetBHP(const OCP_DBL& p, const OCP_DBL& NRp) = 0;
     /// Reset to last time step
     virtual void ResetToLastTimeStep(const Bulk& bk) = 0;
     /// Update last time step
@@ -193,6 +195,10 @@ public:
     virtual void AssembleMatFIM(LinearSystem& ls, const Bulk& bk, const OCP_DBL& dt) const = 0;
     /// Get solution for FIM method
     virtual void GetSolutionFIM(const vector<OCP_DBL>& u, OCP_USI& wId) = 0;
+    /// Calculate flux for transport of SFI, total volume rates of perforations are fixed
+    virtual void CalFluxSFI(const Bulk& bk) = 0;
+    /// Assemble matrix of bulks for transport of SFI, well pressure is fixed
+    virtual void AssembleMatSFI(LinearSystem& ls, const Bulk& bk, const OCP_DBL& dt) const = 0;
     /// Assemble matrix for IMPEC method
     virtual void AssembleMatIMPEC(LinearSystem& ls, const Bulk& bk, const OCP_DBL& dt) const = 0;
     /// Get solution for IMPEC method
@@ -48,6 +48,8 @@ public:
 	OCP_DBL CalMaxChangeTime() const override;
 	/// Calculate max change of well pressure between two NR step
 	OCP_DBL CalMaxChangeNR() override;
+	/// Set well pressure and that at last NR step within a time step
+	void SetBHP(const OCP_DBL& p, const OCP_DBL& NRp) override;
 	/// Reset to last time step
 	void ResetToLastTimeStep(const Bulk& bk) override;
 	/// Update last time step
@@ -103,6 +105,10 @@ protected:
 	void AssembleMatInjFIM(LinearSystem& ls, const Bulk& bk, const OCP_DBL& dt) const;
 	void AssembleMatProdFIM(LinearSystem& ls, const Bulk& bk, const OCP_DBL& dt) const;
 
+public:
+	void CalFluxSFI(const Bulk& bk) override;
+	void AssembleMatSFI(LinearSystem& ls, const Bulk& bk, const OCP_DBL& dt) const override;
+
 public:
 	void GetSolutionIMPEC(const vector<OCP_DBL>& u, OCP_USI& wId) override;
 	void AssembleMatIMPEC(LinearSystem& ls, const Bulk& bk, const OCP_DBL& dt) const override;
@@ -123,6 +129,10 @@ protected:
 	void AssembleMatInjFIM(LinearSystem& ls, const Bulk& bk, const OCP_DBL& dt) const;
 	void AssembleMatProdFIM(LinearSystem& ls, const Bulk& bk, const OCP_DBL& dt) const;
 
+public:
+	void CalFluxSFI(const Bulk& bk) override { OCP_ABORT("NOT USED!"); }
+	void AssembleMatSFI(LinearSystem& ls, const Bulk& bk, const OCP_DBL& dt) const override { OCP_ABORT("NOT USED!"); }
+
 public:
 	void GetSolutionIMPEC(const vector<OCP_DBL>& u, OCP_USI& wId) override { OCP_ABORT("NOT USED!"); }
 	void AssembleMatIMPEC(LinearSystem& ls, const Bulk& bk, const OCP_DBL& dt) const override { OCP_ABORT("NOT USED!"); }
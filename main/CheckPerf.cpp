@@ -0,0 +1,371 @@
+/*! \file    CheckPerf.cpp
+ *  \brief   Compare the performance and final state of a run with a baseline
+ *  \author  Shizhe Li
+ *  \date    Oct/16/2026
+ *
+ *-----------------------------------------------------------------------------------
+ *  Copyright (C) 2021--present by the OpenCAEPoroX team. All rights reserved.
+ *  Released under the terms of the GNU Lesser General Public License 3.0 or later.
+ *-----------------------------------------------------------------------------------
+ */
+
+// Standard header files
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// OpenCAEPoroX header files
+#include "OCPSummaryBin.hpp"
+#include "UtilInput.hpp"
+
+using namespace std;
+
+
+/// Items of binary summary which are not part of the final state
+static const vector<string> SUMBIN_SKIP{ "TimeStep", "NRiter",  "NRiterW", "NRiter(DDM)",
+                                         "NRiterW(DDM)", "LSiter", "LS/NR",   "Runtime" };
+
+
+/// Name and value of a recorded quantity
+class PerfEntry
+{
+public:
+    PerfEntry() = default;
+    PerfEntry(const string& n, const OCP_DBL& v)
+        : name(n)
+        , val(v){};
+    string  name;
+    OCP_DBL val;
+};
+
+
+/// Iteration counts and timing (totals of PerfLog.csv), final state (last record
+/// of SUMMARY.bin) of a run
+class PerfRecord
+{
+public:
+    /// Read the outputs of a run in dir
+    OCP_BOOL ReadRun(const string& dir);
+    /// Read a baseline written by WriteBaseline
+    OCP_BOOL ReadBaseline(const string& file);
+    /// Write as a baseline
+    void WriteBaseline(const string& file, const string& title) const;
+    /// Return value of name in list, NAN if not found
+    static OCP_DBL Find(const vector<PerfEntry>& list, const string& name);
+
+public:
+    /// steps, total NR (LS) iterations, wasted NR (LS) iterations, fallbacks of SFI
+    vector<PerfEntry> iters;
+    /// wall time of time steps and its breakdown, s
+    vector<PerfEntry> times;
+    /// values of summary items at the final step
+    vector<PerfEntry> finals;
+};
+
+
+OCP_BOOL PerfRecord::ReadRun(const string& dir)
+{
+    // PerfLog.csv: columns are increments of each time step
+    const string file = dir + "/PerfLog.csv";
+    ifstream     inF(file);
+    if (!inF.is_open()) {
+        OCP_WARNING("Can not open " + file + ", run with perfLog=csv");
+        return OCP_FALSE;
+    }
+    string         line, s;
+    vector<string> head;
+    getline(inF, line);
+    stringstream hs(line);
+    while (getline(hs, s, ',')) head.push_back(s);
+
+    vector<OCP_DBL> sum(head.size(), 0);
+    OCP_USI         nstep = 0;
+    while (getline(inF, line)) {
+        if (line.empty()) continue;
+        stringstream ls(line);
+        for (USI i = 0; i < head.size() && getline(ls, s, ','); i++) sum[i] += stod(s);
+        nstep++;
+    }
+    if (nstep == 0) {
+        OCP_WARNING("No time step is recorded in " + file);
+        return OCP_FALSE;
+    }
+    auto col = [&](const string& name) {
+        for (USI i = 0; i < head.size(); i++) {
+            if (head[i] == name) return sum[i];
+        }
+        OCP_ABORT("Column " + name + " is not found in " + file);
+    };
+
+    iters = { { "steps", static_cast<OCP_DBL>(nstep) },
+              { "NR", col("NR") + col("NRw") },
+              { "LS", col("LS") + col("LSw") },
+              { "NRw", col("NRw") },
+              { "LSw", col("LSw") },
+              { "fallback", col("fallback") } };
+    times = { { "wall", col("wall") },       { "update", col("update") },
+              { "assemble", col("assemble") }, { "convert", col("convert") },
+              { "solve", col("solve") },     { "comm", col("comm") } };
+
+    // SUMMARY.bin: the final record
+    SummaryBinReader reader;
+    if (!reader.Open(dir + "/SUMMARY.bin")) {
+        OCP_WARNING("Can not read " + dir + "/SUMMARY.bin, run with sumBin=on");
+        return OCP_FALSE;
+    }
+    const auto& items = reader.GetItems();
+    vector<USI> cols;
+    for (USI i = 0; i < items.size(); i++) {
+        if (find(SUMBIN_SKIP.begin(), SUMBIN_SKIP.end(), items[i].Item) == SUMBIN_SKIP.end())
+            cols.push_back(i);
+    }
+    vector<vector<OCP_DBL>> vals;
+    reader.ReadColumns(cols, vals);
+    finals.clear();
+    for (USI c = 0; c < cols.size(); c++) {
+        const auto& it = items[cols[c]];
+        finals.push_back({ it.Item + (it.Obj == "-" ? "" : ":" + it.Obj), vals[c].back() });
+    }
+    return OCP_TRUE;
+}
+
+
+OCP_BOOL PerfRecord::ReadBaseline(const string& file)
+{
+    ifstream inF(file);
+    if (!inF.is_open()) return OCP_FALSE;
+
+    string line, kind, name;
+    while (getline(inF, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        stringstream ss(line);
+        OCP_DBL      val;
+        ss >> kind >> name >> val;
+        if (kind == "ITER")       iters.push_back({ name, val });
+        else if (kind == "TIME")  times.push_back({ name, val });
+        else if (kind == "FINAL") finals.push_back({ name, val });
+        else OCP_ABORT("Unknown entry " + kind + " in " + file);
+    }
+    return OCP_TRUE;
+}
+
+
+void PerfRecord::WriteBaseline(const string& file, const string& title) const
+{
+    ofstream outF(file);
+    if (!outF.is_open()) OCP_ABORT("Can not open " + file);
+
+    outF << "# Performance baseline of OpenCAEPoroX: " << title << "\n"
+         << "# ITER: counts, TIME: seconds, FINAL: values at the final step\n"
+         << setprecision(16);
+    for (const auto& e : iters)  outF << "ITER   " << setw(24) << left << e.name << e.val << "\n";
+    for (const auto& e : times)  outF << "TIME   " << setw(24) << left << e.name << e.val << "\n";
+    for (const auto& e : finals) outF << "FINAL  " << setw(24) << left << e.name << e.val << "\n";
+}
+
+
+OCP_DBL PerfRecord::Find(const vector<PerfEntry>& list, const string& name)
+{
+    for (const auto& e : list) {
+        if (e.name == name) return e.val;
+    }
+    return NAN;
+}
+
+
+/// Tolerances of comparison
+class PerfTolerance
+{
+public:
+    /// relative increase of wall time allowed
+    OCP_DBL time{ 0.10 };
+    /// absolute increase of wall time allowed, s, which absorbs timer noise of short runs
+    OCP_DBL timeAbs{ 0.5 };
+    /// relative increase of iteration counts allowed
+    OCP_DBL iter{ 0.05 };
+    /// relative difference of final values allowed
+    OCP_DBL value{ 1E-4 };
+};
+
+
+static void PrintRow(const string& kind, const string& name, const OCP_DBL& base,
+                     const OCP_DBL& cur, const string& status)
+{
+    const OCP_DBL change = base != 0 && !std::isnan(base) ? 100 * (cur - base) / fabs(base) : 0.0;
+    cout << setw(7) << left << kind << setw(24) << name << right << setw(16)
+         << setprecision(8) << base << setw(16) << cur << fixed << setw(10) << setprecision(2)
+         << change << defaultfloat << "%  " << status << endl;
+}
+
+
+/// Compare the outputs of a run with the baseline, or record them as the baseline.
+/// Iteration counts and final values are checked by default, only the wall time is
+/// checked with time, since it depends on the machine and its load. Only final values
+/// are checked with final, for a baseline recorded by another method. Only the final
+/// values of items are checked if they are given, e.g. items=FPR,FOPT,WBHP:PROD1.
+/// Iteration counts of the run are bounded in any case if maxIter is given, e.g.
+/// maxIter=fallback:0,NR:1500.
+/// Params: tTime=0.10 tTimeAbs=0.5 tIter=0.05 tVal=1e-4 items maxIter update time final
+int main(int argc, char* argv[])
+{
+    if (argc < 3) {
+        cout << "Usage: " << endl
+             << "  " << argv[0] << " <RunDir> <Baseline> [update] [time] [final] [tTime=0.10]"
+             << " [tTimeAbs=0.5] [tIter=0.05] [tVal=1e-4] [items=FPR,FOPT] [maxIter=fallback:0]" << endl
+             << "RunDir contains PerfLog.csv and SUMMARY.bin of the run, the run is recorded "
+             << "as Baseline if update is given" << endl
+             << "Iteration counts and final values are checked, or only the wall time if "
+             << "time is given, or only final values if final is given" << endl
+             << "Iteration counts are bounded by maxIter in any case" << endl;
+        return OCP_ERROR_NUM_INPUT;
+    }
+
+    const string  dir      = argv[1];
+    const string  baseFile = argv[2];
+    OCP_BOOL      update   = OCP_FALSE;
+    OCP_BOOL      ifTime   = OCP_FALSE;
+    OCP_BOOL      ifFinal  = OCP_FALSE;
+    PerfTolerance tol;
+    // final values to be checked, all if empty
+    vector<string>    items;
+    // upper bounds of iteration counts of the run
+    vector<PerfEntry> bounds;
+    for (OCP_INT n = 3; n < argc; n++) {
+        const string            tmp = argv[n];
+        const string::size_type pos = tmp.find('=');
+        if (pos == string::npos) {
+            if (tmp == "update")    update = OCP_TRUE;
+            else if (tmp == "time") ifTime = OCP_TRUE;
+            else if (tmp == "final") ifFinal = OCP_TRUE;
+            else OCP_ABORT("Unknown param " + tmp + " in command line!");
+            continue;
+        }
+        const string key   = tmp.substr(0, pos);
+        const string value = tmp.substr(pos + 1);
+        switch (Map_Str2Int(&key[0], key.size())) {
+            case Map_Str2Int("tTime", 5):
+                tol.time = stod(value);
+                break;
+            case Map_Str2Int("tTimeAbs", 8):
+                tol.timeAbs = stod(value);
+                break;
+            case Map_Str2Int("tIter", 5):
+                tol.iter = stod(value);
+                break;
+            case Map_Str2Int("tVal", 4):
+                tol.value = stod(value);
+                break;
+            case Map_Str2Int("items", 5): {
+                stringstream ss(value);
+                string       item;
+                while (getline(ss, item, ',')) items.push_back(item);
+                break;
+            }
+            case Map_Str2Int("maxIter", 7): {
+                stringstream ss(value);
+                string       item;
+                while (getline(ss, item, ',')) {
+                    const string::size_type p = item.find(':');
+                    if (p == string::npos) OCP_ABORT("Wrong maxIter param " + item + " in command line!");
+                    bounds.push_back({ item.substr(0, p), stod(item.substr(p + 1)) });
+                }
+                break;
+            }
+            default:
+                OCP_ABORT("Unknown param " + key + " in command line!");
+                break;
+        }
+    }
+
+    PerfRecord cur;
+    if (!cur.ReadRun(dir)) return OCP_ERROR;
+
+    if (update) {
+        const string::size_type pos = dir.find_last_not_of('/');
+        const string            title = dir.substr(0, pos + 1);
+        cur.WriteBaseline(baseFile, title.substr(title.find_last_of('/') + 1));
+        OCP_INFO("Baseline is recorded in " + baseFile);
+        return OCP_SUCCESS;
+    }
+    // A missing baseline is a failure, otherwise nothing would ever be compared
+    PerfRecord base;
+    if (!base.ReadBaseline(baseFile)) {
+        OCP_WARNING("Can not open baseline " + baseFile + ", record it with update");
+        return OCP_ERROR;
+    }
+
+    cout << setw(7) << left << "Kind" << setw(24) << "Name" << right << setw(16) << "Baseline"
+         << setw(16) << "Current" << setw(11) << "Change" << "  Status" << endl;
+
+    USI numFail = 0;
+    // Iteration counts are deterministic for a given build and num of processes,
+    // any increase beyond tolerance is a regression
+    for (const auto& e : cur.iters) {
+        const OCP_DBL b = PerfRecord::Find(base.iters, e.name);
+        string        status;
+        if (std::isnan(b))                               status = "NEW";
+        else if (ifTime || ifFinal)                      status = "-";
+        else if (e.name == "NRw" || e.name == "LSw" || e.name == "fallback")
+                                                         status = "-";
+        else if (e.val > b * (1 + tol.iter))             status = "REGRESSED";
+        else if (e.val < b * (1 - tol.iter))             status = "IMPROVED";
+        else                                             status = "OK";
+        if (status == "REGRESSED") numFail++;
+        PrintRow("ITER", e.name, b, e.val, status);
+    }
+    // Bounds hold whatever the baseline is
+    for (const auto& e : bounds) {
+        const OCP_DBL c = PerfRecord::Find(cur.iters, e.name);
+        string        status;
+        if (std::isnan(c))      status = "MISSING";
+        else if (c > e.val)     status = "EXCEEDED";
+        else                    status = "OK";
+        if (status != "OK") numFail++;
+        PrintRow("MAX", e.name, e.val, c, status);
+    }
+    // Only the wall time is checked, the breakdown shows where it changes
+    for (const auto& e : cur.times) {
+        const OCP_DBL b = PerfRecord::Find(base.times, e.name);
+        string        status;
+        if (std::isnan(b))                                       status = "NEW";
+        else if (!ifTime || e.name != "wall")                    status = "-";
+        else if (e.val > b * (1 + tol.time) + tol.timeAbs)       status = "REGRESSED";
+        else if (e.val < b * (1 - tol.time) - tol.timeAbs)       status = "IMPROVED";
+        else                                                     status = "OK";
+        if (status == "REGRESSED") numFail++;
+        PrintRow("TIME", e.name, b, e.val, status);
+    }
+    // Final state must be unchanged
+    for (const auto& e : base.finals) {
+        if (ifTime) break;
+        const OCP_DBL c = PerfRecord::Find(cur.finals, e.name);
+        string        status;
+        if (!items.empty() && find(items.begin(), items.end(), e.name) == items.end())
+                                                                         status = "-";
+        else if (std::isnan(c))                                          status = "MISSING";
+        else if (fabs(c - e.val) > tol.value * OCP_MAX(fabs(e.val), 1.0)) status = "CHANGED";
+        else                                                             status = "OK";
+        if (status == "MISSING" || status == "CHANGED") numFail++;
+        PrintRow("FINAL", e.name, e.val, c, status);
+    }
+
+    if (numFail > 0) {
+        OCP_WARNING(to_string(numFail) + " entries differ from baseline " + baseFile);
+        return OCP_ERROR;
+    }
+    OCP_INFO("No regression against baseline " + baseFile);
+    return OCP_SUCCESS;
+}
+
+/*----------------------------------------------------------------------------*/
+/*  Brief Change History of This File                                         */
+/*----------------------------------------------------------------------------*/
+/*  Author              Date             Actions                              */
+/*----------------------------------------------------------------------------*/
+/*  Shizhe Li           Oct/16/2026      Create file                          */
+/*----------------------------------------------------------------------------*/
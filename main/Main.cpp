@@ -48,7 +48,7 @@ int main(int argc, char* argv[])
 
     {
         // Step 1. Input and generate Grid infomation and partition
-        PreProcess preProcess(argv[1]);
+        PreProcess preProcess(argc, const_cast<const char**>(argv));
 
         // Step 2. Input reservoir information and distribute
         simulator.SetupDistParam(argc, const_cast<const char**>(argv), preProcess);
@@ -0,0 +1,84 @@
+/*! \file    ReadSummary.cpp
+ *  \brief   Extract selected items from a binary summary file
+ *  \author  Shizhe Li
+ *  \date    Oct/16/2026
+ *
+ *-----------------------------------------------------------------------------------
+ *  Copyright (C) 2021--present by the OpenCAEPoroX team. All rights reserved.
+ *  Released under the terms of the GNU Lesser General Public License 3.0 or later.
+ *-----------------------------------------------------------------------------------
+ */
+
+// Standard header files
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+// OpenCAEPoroX header files
+#include "OCPSummaryBin.hpp"
+
+using namespace std;
+
+/// List items of a binary summary, or print the selected items at all time steps.
+/// Items are selected by Item or Item:Obj, such as FOPR WBHP:PROD1
+int main(int argc, char* argv[])
+{
+    if (argc < 2) {
+        cout << "Usage: " << endl
+             << "  " << argv[0] << " <SUMMARY.bin> [Item[:Obj] ...]" << endl
+             << "Items are listed if none is selected" << endl;
+        return OCP_ERROR_NUM_INPUT;
+    }
+
+    SummaryBinReader reader;
+    if (!reader.Open(argv[1])) return OCP_ERROR;
+
+    const auto& items = reader.GetItems();
+    if (argc == 2) {
+        cout << reader.GetNumRecord() << " time steps" << endl;
+        for (USI i = 0; i < items.size(); i++) {
+            cout << setw(6) << i << "  " << setw(14) << left << items[i].Item << setw(20)
+                 << items[i].Obj << items[i].Unit << right << endl;
+        }
+        return OCP_SUCCESS;
+    }
+
+    // TIME is always the first column
+    vector<USI> cols{ 0 };
+    for (OCP_INT n = 2; n < argc; n++) {
+        const string           key = argv[n];
+        const string::size_type pos = key.find(':');
+        const OCP_INT          col = pos == string::npos
+                                         ? reader.FindItem(key, "")
+                                         : reader.FindItem(key.substr(0, pos), key.substr(pos + 1));
+        if (col < 0) {
+            OCP_WARNING("Item " + key + " is not found");
+            continue;
+        }
+        cols.push_back(col);
+    }
+
+    vector<vector<OCP_DBL>> vals;
+    reader.ReadColumns(cols, vals);
+
+    for (const auto& c : cols) {
+        cout << setw(16) << items[c].Item + (items[c].Obj == "-" ? "" : ":" + items[c].Obj);
+    }
+    cout << endl;
+    for (OCP_ULL r = 0; r < reader.GetNumRecord(); r++) {
+        for (USI c = 0; c < cols.size(); c++) {
+            cout << setw(16) << setprecision(8) << vals[c][r];
+        }
+        cout << endl;
+    }
+
+    return OCP_SUCCESS;
+}
+
+/*----------------------------------------------------------------------------*/
+/*  Brief Change History of This File                                         */
+/*----------------------------------------------------------------------------*/
+/*  Author              Date             Actions                              */
+/*----------------------------------------------------------------------------*/
+/*  Shizhe Li           Oct/16/2026      Create file                          */
+/*----------------------------------------------------------------------------*/
@@ -137,6 +137,7 @@ void AllWells::SetupWellGroup(const Bulk& bk)
 
 void AllWells::SetupWellBulk(Bulk& bk) const
 {
+    bk.ClearWellBulkId();
     for (auto& w : wells) {
         if (w->IsOpen()) {
             for (auto& p : w->perf) {
@@ -178,6 +179,7 @@ void AllWells::PrepareWell(const Bulk& bk)
 
 void AllWells::CalFlux(const Bulk& bk)
 {
+    OCP_PROFILE("WellFlux");
     OCP_FUNCNAME;
 
     for (USI w = 0; w < numWell; w++) {
@@ -170,16 +170,16 @@ OCP_BOOL OCP_COORD::InputZCORNDATA(const vector<OCP_DBL>& zcorn)
     return flag;
 }
 
-void OCP_COORD::SetAllFlags(const HexahedronFace& oFace, const HexahedronFace& Face)
+void OCP_COORD::SetAllFlags(const HexahedronFace& oFace, const HexahedronFace& Face, FaceIntersect& fi) const
 {
-    upNNC   = OCP_FALSE;
-    downNNC = OCP_FALSE;
+    fi.upNNC   = OCP_FALSE;
+    fi.downNNC = OCP_FALSE;
 
     // if the face reduce to a line
     if (sqrt((Face.p0 - Face.p1) * (Face.p0 - Face.p1)) <= TEENY && 
         sqrt((Face.p3 - Face.p2) * (Face.p3 - Face.p2)) <= TEENY) {
-        interFace = Face;
-        flagJump  = OCP_TRUE;     
+        fi.interFace = Face;
+        fi.flagJump  = OCP_TRUE;     
     }
     else {
         // if the i th point of oFace is deeper than the one of Face, then flagpi = 1;
@@ -187,35 +187,35 @@ void OCP_COORD::SetAllFlags(const HexahedronFace& oFace, const HexahedronFace& F
         // if the i th point of oFace is very close to the one of Face, then flagpi = 0;
         OCP_INT flagp0, flagp1, flagp2, flagp3;
 
-        interFace = Face;
+        fi.interFace = Face;
         if (oFace.p0.z > Face.p0.z + TEENY) {
-            interFace.p0 = oFace.p0;
+            fi.interFace.p0 = oFace.p0;
             flagp0       = 1;
-            upNNC        = OCP_TRUE;
+            fi.upNNC        = OCP_TRUE;
         }
         else if (oFace.p0.z < Face.p0.z - TEENY)  flagp0 = -1;
         else                                      flagp0 = 0;
     
         if (oFace.p1.z < Face.p1.z - TEENY) {
-            interFace.p1 = oFace.p1;
+            fi.interFace.p1 = oFace.p1;
             flagp1       = -1;
-            downNNC      = OCP_TRUE;
+            fi.downNNC      = OCP_TRUE;
         }
         else if (oFace.p1.z > Face.p1.z + TEENY)  flagp1 = 1;
         else                                      flagp1 = 0;
        
         if (oFace.p2.z < Face.p2.z - TEENY) {
-            interFace.p2 = oFace.p2;
+            fi.interFace.p2 = oFace.p2;
             flagp2       = -1;
-            downNNC      = OCP_TRUE;
+            fi.downNNC      = OCP_TRUE;
         }
         else if (oFace.p2.z > Face.p2.z + TEENY)  flagp2 = 1;
         else                                      flagp2 = 0;
 
         if (oFace.p3.z > Face.p3.z + TEENY) {
-            interFace.p3 = oFace.p3;
+            fi.interFace.p3 = oFace.p3;
             flagp3       = 1;
-            upNNC        = OCP_TRUE;
+            fi.upNNC        = OCP_TRUE;
         }
         else if (oFace.p3.z < Face.p3.z - TEENY)  flagp3 = -1;
         else                                      flagp3 = 0;
@@ -226,17 +226,17 @@ void OCP_COORD::SetAllFlags(const HexahedronFace& oFace, const HexahedronFace& F
 
         if (((oFace.p1.z <= Face.p0.z) && (oFace.p2.z <= Face.p3.z)) ||
             ((oFace.p0.z >= Face.p1.z) && (oFace.p3.z >= Face.p2.z))) {
-            flagJump = OCP_TRUE;
+            fi.flagJump = OCP_TRUE;
         }
         else {
-            flagJump = OCP_FALSE;
+            fi.flagJump = OCP_FALSE;
             if ((flagp0 * flagp3 >= 0) && (oFace.p0.z <= Face.p1.z) &&
                 (oFace.p3.z <= Face.p2.z) && (flagp1 * flagp2 >= 0) &&
                 (oFace.p1.z >= Face.p0.z) && (oFace.p2.z >= Face.p3.z)) {
-                flagQuad = OCP_TRUE;
+                fi.flagQuad = OCP_TRUE;
             }
             else {
-                flagQuad = OCP_FALSE;
+                fi.flagQuad = OCP_FALSE;
             }
         }
     }
@@ -249,15 +249,24 @@ void OCP_COORD::SetupCornerPoints()
 
     // allocate memoery for connections
     vector<ConnGrid> blockconn(numGrid);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
     for (OCP_ULL iloop = 0; iloop < numGrid; iloop++) {
         blockconn[iloop].Allocate(10);
     }
 
+    // Blocks are independent of each other, so pillars(columns of blocks) are 
+    // processed in parallel, each block only writes its own entries
+
     // setup each block including coordinates of points, center, depth, and volume
     OCP_DBL xtop, ytop, ztop, xbottom, ybottom, zbottom, xvalue, yvalue, zvalue;
-    for (USI k = 0; k < nz; k++) {
-        for (USI j = 0; j < ny; j++) {
-            for (USI i = 0; i < nx; i++) {
+#ifdef _OPENMP
+#pragma omp parallel for collapse(2) schedule(static) private(cindex, xtop, ytop, ztop, xbottom, ybottom, zbottom, xvalue, yvalue, zvalue)
+#endif
+    for (USI j = 0; j < ny; j++) {
+        for (USI i = 0; i < nx; i++) {
+            for (USI k = 0; k < nz; k++) {
                 //
                 // corner point 0 and 4
                 //
@@ -394,6 +403,7 @@ void OCP_COORD::SetupCornerPoints()
     OCP_DBL        areaP;         // area of projection of interface
     OCP_INT        iznnc;
     Point3D        dxpoint, dypoint, dzpoint;
+    FaceIntersect  fi;            // intersection of face and the other face
 
     /////////////////////////////////////////////////////////////////////
     // Attention that The coordinate axis follows the right-hand rule ! //
@@ -417,9 +427,15 @@ void OCP_COORD::SetupCornerPoints()
 
     ConnDirect direction;
 
-    for (USI k = 0; k < nz; k++) {
-        for (USI j = 0; j < ny; j++) {
-            for (USI i = 0; i < nx; i++) {
+    // half connections of each block are found in parallel, they are stored in the 
+    // block itself, so the result is independent of the num of threads
+#ifdef _OPENMP
+#pragma omp parallel for collapse(2) schedule(dynamic, 64) reduction(+ : num_conn) \
+    private(cindex, oindex, Pcenter, Pface, Pc2f, Face, oFace, FaceP, oFaceP, areaV, areaP, iznnc, dxpoint, dypoint, dzpoint, fi, direction)
+#endif
+    for (USI j = 0; j < ny; j++) {
+        for (USI i = 0; i < nx; i++) {
+            for (USI k = 0; k < nz; k++) {
                 // begin from each block
                 const Hexahedron& block = cornerPoints[i][j][k];
                 cindex                  = k * nxny + j * nx + i;
@@ -452,14 +468,14 @@ void OCP_COORD::SetupCornerPoints()
                     oFace.p2 = leftblock.p6;
                     oFace.p3 = leftblock.p2;
 
-                    SetAllFlags(oFace, Face);
+                    SetAllFlags(oFace, Face, fi);
 
                     // calculate the interface of two face
-                    if (flagJump) {
+                    if (fi.flagJump) {
                         // nothing to do
                     } else {
-                        if (flagQuad) {
-                            areaV = interFace.CalAreaVector();
+                        if (fi.flagQuad) {
+                            areaV = fi.interFace.CalAreaVector();
                         } else {
                             FaceP.p0  = Point3D(Face.p3.y, Face.p3.z, 0);
                             FaceP.p1  = Point3D(Face.p0.y, Face.p0.z, 0);
@@ -487,12 +503,12 @@ void OCP_COORD::SetupCornerPoints()
                     }
 
                     // then find all NNC for current block
-                    // check if upNNC and downNNC exist
+                    // check if fi.upNNC and fi.downNNC exist
 
                     direction = ConnDirect::x;
 
                     iznnc = -1;
-                    while (upNNC) {
+                    while (fi.upNNC) {
                         // if (-iznnc > k) break;
                         if (-iznnc - static_cast<OCP_INT>(k) > 0) break;
                         // find object block
@@ -503,14 +519,14 @@ void OCP_COORD::SetupCornerPoints()
                         oFace.p2 = leftblock.p6;
                         oFace.p3 = leftblock.p2;
 
-                        SetAllFlags(oFace, Face);
+                        SetAllFlags(oFace, Face, fi);
 
                         // calculate the interface of two face
-                        if (flagJump) {
+                        if (fi.flagJump) {
                             // nothing to do
                         } else {
-                            if (flagQuad) {
-                                areaV = interFace.CalAreaVector();
+                            if (fi.flagQuad) {
+                                areaV = fi.interFace.CalAreaVector();
                             } else {
                                 FaceP.p0  = Point3D(Face.p3.y, Face.p3.z, 0);
                                 FaceP.p1  = Point3D(Face.p0.y, Face.p0.z, 0);
@@ -540,7 +556,7 @@ void OCP_COORD::SetupCornerPoints()
                     }
 
                     iznnc = 1;
-                    while (downNNC) {
+                    while (fi.downNNC) {
                         if (k + iznnc > nz - 1) break;
                         // find object block
                         const Hexahedron& leftblock = cornerPoints[i - 1][j][k + iznnc];
@@ -550,14 +566,14 @@ void OCP_COORD::SetupCornerPoints()
                         oFace.p2 = leftblock.p6;
                         oFace.p3 = leftblock.p2;
 
-                        SetAllFlags(oFace, Face);
+                        SetAllFlags(oFace, Face, fi);
 
                         // calculate the interface of two face
-                        if (flagJump) {
+                        if (fi.flagJump) {
                             // nothing to do
                         } else {
-                            if (flagQuad) {
-                                areaV = interFace.CalAreaVector();
+                            if (fi.flagQuad) {
+                                areaV = fi.interFace.CalAreaVector();
                             } else {
                                 FaceP.p0  = Point3D(Face.p3.y, Face.p3.z, 0);
                                 FaceP.p1  = Point3D(Face.p0.y, Face.p0.z, 0);
@@ -612,14 +628,14 @@ void OCP_COORD::SetupCornerPoints()
                     oFace.p2 = rightblock.p4;
                     oFace.p3 = rightblock.p0;
 
-                    SetAllFlags(oFace, Face);
+                    SetAllFlags(oFace, Face, fi);
 
                     // calculate the interface of two face
-                    if (flagJump) {
+                    if (fi.flagJump) {
                         // nothing to do
                     } else {
-                        if (flagQuad) {
-                            areaV = interFace.CalAreaVector();
+                        if (fi.flagQuad) {
+                            areaV = fi.interFace.CalAreaVector();
                         } else {
                             FaceP.p0  = Point3D(Face.p3.y, Face.p3.z, 0);
                             FaceP.p1  = Point3D(Face.p0.y, Face.p0.z, 0);
@@ -650,7 +666,7 @@ void OCP_COORD::SetupCornerPoints()
                     direction = ConnDirect::x;
 
                     iznnc = -1;
-                    while (upNNC) {
+                    while (fi.upNNC) {
                         // if (-iznnc > k) break;
                         if (-iznnc - static_cast<OCP_INT>(k) > 0) break;
                         // find object block
@@ -662,14 +678,14 @@ void OCP_COORD::SetupCornerPoints()
                         oFace.p2 = rightblock.p4;
                         oFace.p3 = rightblock.p0;
 
-                        SetAllFlags(oFace, Face);
+                        SetAllFlags(oFace, Face, fi);
 
                         // calculate the interface of two face
-                        if (flagJump) {
+                        if (fi.flagJump) {
                             // nothing to do
                         } else {
-                            if (flagQuad) {
-                                areaV = interFace.CalAreaVector();
+                            if (fi.flagQuad) {
+                                areaV = fi.interFace.CalAreaVector();
                             } else {
                                 FaceP.p0  = Point3D(Face.p3.y, Face.p3.z, 0);
                                 FaceP.p1  = Point3D(Face.p0.y, Face.p0.z, 0);
@@ -699,7 +715,7 @@ void OCP_COORD::SetupCornerPoints()
                     }
 
                     iznnc = 1;
-                    while (downNNC) {
+                    while (fi.downNNC) {
                         if (k + iznnc > nz - 1) break;
                         // find object block
                         const Hexahedron& rightblock =
@@ -710,14 +726,14 @@ void OCP_COORD::SetupCornerPoints()
                         oFace.p2 = rightblock.p4;
                         oFace.p3 = rightblock.p0;
 
-                        SetAllFlags(oFace, Face);
+                        SetAllFlags(oFace, Face, fi);
 
                         // calculate the interface of two face
-                        if (flagJump) {
+                        if (fi.flagJump) {
                             // nothing to do
                         } else {
-                            if (flagQuad) {
-                                areaV = interFace.CalAreaVector();
+                            if (fi.flagQuad) {
+                                areaV = fi.interFace.CalAreaVector();
                             } else {
                                 FaceP.p0  = Point3D(Face.p3.y, Face.p3.z, 0);
                                 FaceP.p1  = Point3D(Face.p0.y, Face.p0.z, 0);
@@ -772,14 +788,14 @@ void OCP_COORD::SetupCornerPoints()
                     oFace.p2 = backblock.p7;
                     oFace.p3 = backblock.p3;
 
-                    SetAllFlags(oFace, Face);
+                    SetAllFlags(oFace, Face, fi);
 
                     // calculate the interface of two face
-                    if (flagJump) {
+                    if (fi.flagJump) {
                         // nothing to do
                     } else {
-                        if (flagQuad) {
-                            areaV = interFace.CalAreaVector();
+                        if (fi.flagQuad) {
+                            areaV = fi.interFace.CalAreaVector();
                         } else {
                             FaceP.p0  = Point3D(Face.p0.x, Face.p0.z, 0);
                             FaceP.p1  = Point3D(Face.p3.x, Face.p3.z, 0);
@@ -810,7 +826,7 @@ void OCP_COORD::SetupCornerPoints()
                     direction = ConnDirect::y;
 
                     iznnc = -1;
-                    while (upNNC) {
+                    while (fi.upNNC) {
                         // if (-iznnc > k) break;
                         if (-iznnc - static_cast<OCP_INT>(k) > 0) break;
                         // find object block
@@ -821,14 +837,14 @@ void OCP_COORD::SetupCornerPoints()
                         oFace.p2 = backblock.p7;
                         oFace.p3 = backblock.p3;
 
-                        SetAllFlags(oFace, Face);
+                        SetAllFlags(oFace, Face, fi);
 
                         // calculate the interface of two face
-                        if (flagJump) {
+                        if (fi.flagJump) {
                             // nothing to do
                         } else {
-                            if (flagQuad) {
-                                areaV = interFace.CalAreaVector();
+                            if (fi.flagQuad) {
+                                areaV = fi.interFace.CalAreaVector();
                             } else {
                                 FaceP.p0  = Point3D(Face.p0.x, Face.p0.z, 0);
                                 FaceP.p1  = Point3D(Face.p3.x, Face.p3.z, 0);
@@ -858,7 +874,7 @@ void OCP_COORD::SetupCornerPoints()
                     }
 
                     iznnc = 1;
-                    while (downNNC) {
+                    while (fi.downNNC) {
                         if (k + iznnc > nz - 1) break;
                         // find object block
                         const Hexahedron& backblock = cornerPoints[i][j - 1][k + iznnc];
@@ -868,14 +884,14 @@ void OCP_COORD::SetupCornerPoints()
                         oFace.p2 = backblock.p7;
                         oFace.p3 = backblock.p3;
 
-                        SetAllFlags(oFace, Face);
+                        SetAllFlags(oFace, Face, fi);
 
                         // calculate the interface of two face
-                        if (flagJump) {
+                        if (fi.flagJump) {
                             // nothing to do
                         } else {
-                            if (flagQuad) {
-                                areaV = interFace.CalAreaVector();
+                            if (fi.flagQuad) {
+                                areaV = fi.interFace.CalAreaVector();
                             } else {
                                 FaceP.p0  = Point3D(Face.p0.x, Face.p0.z, 0);
                                 FaceP.p1  = Point3D(Face.p3.x, Face.p3.z, 0);
@@ -930,14 +946,14 @@ void OCP_COORD::SetupCornerPoints()
                     oFace.p2 = frontblock.p5;
                     oFace.p3 = frontblock.p1;
 
-                    SetAllFlags(oFace, Face);
+                    SetAllFlags(oFace, Face, fi);
 
                     // calculate the interface of two face
-                    if (flagJump) {
+                    if (fi.flagJump) {
                         // nothing to do
                     } else {
-                        if (flagQuad) {
-                            areaV = interFace.CalAreaVector();
+                        if (fi.flagQuad) {
+                            areaV = fi.interFace.CalAreaVector();
                         } else {
                             FaceP.p0  = Point3D(Face.p0.x, Face.p0.z, 0);
                             FaceP.p1  = Point3D(Face.p3.x, Face.p3.z, 0);
@@ -968,7 +984,7 @@ void OCP_COORD::SetupCornerPoints()
                     direction = ConnDirect::y;
 
                     iznnc = -1;
-                    while (upNNC) {
+                    while (fi.upNNC) {
                         // if (-iznnc > k) break;
                         if (-iznnc - static_cast<OCP_INT>(k) > 0) break;
                         // find object block
@@ -980,14 +996,14 @@ void OCP_COORD::SetupCornerPoints()
                         oFace.p2 = frontblock.p5;
                         oFace.p3 = frontblock.p1;
 
-                        SetAllFlags(oFace, Face);
+                        SetAllFlags(oFace, Face, fi);
 
                         // calculate the interface of two face
-                        if (flagJump) {
+                        if (fi.flagJump) {
                             // nothing to do
                         } else {
-                            if (flagQuad) {
-                                areaV = interFace.CalAreaVector();
+                            if (fi.flagQuad) {
+                                areaV = fi.interFace.CalAreaVector();
                             } else {
                                 FaceP.p0  = Point3D(Face.p0.x, Face.p0.z, 0);
                                 FaceP.p1  = Point3D(Face.p3.x, Face.p3.z, 0);
@@ -1017,7 +1033,7 @@ void OCP_COORD::SetupCornerPoints()
                     }
 
                     iznnc = 1;
-                    while (downNNC) {
+                    while (fi.downNNC) {
                         if (k + iznnc > nz - 1) break;
                         // find object block
                         const Hexahedron& frontblock =
@@ -1028,14 +1044,14 @@ void OCP_COORD::SetupCornerPoints()
                         oFace.p2 = frontblock.p5;
                         oFace.p3 = frontblock.p1;
 
-                        SetAllFlags(oFace, Face);
+                        SetAllFlags(oFace, Face, fi);
 
                         // calculate the interface of two face
-                        if (flagJump) {
+                        if (fi.flagJump) {
                             // nothing to do
                         } else {
-                            if (flagQuad) {
-                                areaV = interFace.CalAreaVector();
+                            if (fi.flagQuad) {
+                                areaV = fi.interFace.CalAreaVector();
                             } else {
                                 FaceP.p0  = Point3D(Face.p0.x, Face.p0.z, 0);
                                 FaceP.p1  = Point3D(Face.p3.x, Face.p3.z, 0);
@@ -1083,8 +1099,8 @@ void OCP_COORD::SetupCornerPoints()
                     // upblock
                     oindex = (k - 1) * nxny + j * nx + i;
 
-                    interFace = Face;
-                    areaV   = interFace.CalAreaVector();
+                    fi.interFace = Face;
+                    areaV   = fi.interFace.CalAreaVector();
                     blockconn[cindex].AddHalfConn(oindex, areaV, Pc2f, direction, flagForward);
                     num_conn++;                   
                 }
@@ -1108,8 +1124,8 @@ void OCP_COORD::SetupCornerPoints()
                     // downblock
                     oindex = (k + 1) * nxny + j * nx + i;
 
-                    interFace = Face;
-                    areaV   = interFace.CalAreaVector();
+                    fi.interFace = Face;
+                    areaV   = fi.interFace.CalAreaVector();
                     blockconn[cindex].AddHalfConn(oindex, areaV, Pc2f, direction, flagForward);
                     num_conn++;
                 }
@@ -1132,30 +1148,39 @@ void OCP_COORD::SetupCornerPoints()
 
     OCP_ASSERT(num_conn % 2 == 0, "Wrong Conn!");
     numConnMax = num_conn;
-    connect.resize(numConnMax);
     //
     //    calculate the x,y,z direction transmissibilities of each block and save them
     //
-    // make the connections
-    OCP_ULL iter_conn = 0;
+    // make the connections, the pairs are counted first, then they are filled in
+    // the order of blocks, which is the same as the serial one
+    connBegin.assign(numGrid + 1, 0);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
     for (OCP_ULL n = 0; n < numGrid; n++) {
         for (USI j = 0; j < blockconn[n].nConn; j++) {
-            OCP_ULL nn = blockconn[n].halfConn[j].neigh;
-            USI jj;
-            for (jj = 0; jj < blockconn[nn].nConn; jj++) {
-                if (blockconn[nn].halfConn[jj].neigh == n) {
-                    break;
-                }
-            }
-            if (jj == blockconn[nn].nConn) {
-                continue;
+            if (FindPairConn(blockconn, n, j) >= 0) {
+                connBegin[n + 1]++;
             }
+        }
+    }
+    for (OCP_ULL n = 0; n < numGrid; n++) {
+        connBegin[n + 1] += connBegin[n];
+    }
+    numConn = connBegin[numGrid];
+    connect.resize(numConn);
 
-            if (blockconn[n].halfConn[j].Ad_dd <= 0 ||
-                blockconn[nn].halfConn[jj].Ad_dd <= 0) {
-                // false connection
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+    for (OCP_ULL n = 0; n < numGrid; n++) {
+        OCP_ULL iter_conn = connBegin[n];
+        for (USI j = 0; j < blockconn[n].nConn; j++) {
+            const OCP_INT jj = FindPairConn(blockconn, n, j);
+            if (jj < 0) {
                 continue;
             }
+            const OCP_ULL nn = blockconn[n].halfConn[j].neigh;
 
             //
             // now, blockconn[n].halfConn[j]
@@ -1170,7 +1195,28 @@ void OCP_COORD::SetupCornerPoints()
             iter_conn++;
         }
     }
-    numConn = iter_conn;
+}
+
+
+OCP_INT OCP_COORD::FindPairConn(const vector<ConnGrid>& blockconn, const OCP_ULL& n, const USI& j) const
+{
+    const OCP_ULL nn = blockconn[n].halfConn[j].neigh;
+    USI jj;
+    for (jj = 0; jj < blockconn[nn].nConn; jj++) {
+        if (blockconn[nn].halfConn[jj].neigh == n) {
+            break;
+        }
+    }
+    if (jj == blockconn[nn].nConn) {
+        return -1;
+    }
+
+    if (blockconn[n].halfConn[j].Ad_dd <= 0 ||
+        blockconn[nn].halfConn[jj].Ad_dd <= 0) {
+        // false connection
+        return -1;
+    }
+    return jj;
 }
 
 /*----------------------------------------------------------------------------*/
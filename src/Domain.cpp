@@ -28,6 +28,16 @@ void Domain::Setup(const Partition& part, const PreParamGridWell& gridwell)
 			grid[n] = n;
 			init_global_to_local.insert(make_pair(n, n));
 		}
+		if (reorderRCM) {
+			vector<vector<OCP_USI>> adj(numGridInterior);
+			for (OCP_USI n = 0; n < numGridInterior; n++) {
+				for (const auto& gn : gridwell.gNeighbor[n]) {
+					if (gn.ID() < numGridInterior)  adj[n].push_back(gn.ID());
+				}
+			}
+			vector<OCP_USI> old2new;
+			ReorderInteriorRCM(adj, old2new);
+		}
 		well.resize(numWellTotal);
 		for (OCP_USI w = 0; w < numWellTotal; w++) {
 			well[w] = w;
@@ -73,7 +83,7 @@ void Domain::Setup(const Partition& part, const PreParamGridWell& gridwell)
 				const OCP_INT proc = my_edge_proc[j];
 				if (proc != global_rank) {
 					// current interior grid is also ghost grid of other process
-					send_element_loc[proc].insert(localIndex);
+					send_element_set[proc].insert(localIndex);
 					ghostElement[proc].insert(my_edge[j]);
 				}
 			}
@@ -85,6 +95,39 @@ void Domain::Setup(const Partition& part, const PreParamGridWell& gridwell)
 	numWellLocal    = well.size();
 	OCP_ASSERT(numGridInterior == numElementLocal - numWellLocal, "");
 
+	vector<OCP_USI> old2new;
+	if (reorderRCM) {
+		// graph of interior grids
+		vector<vector<OCP_USI>> adj(numGridInterior);
+		for (const auto& e : elementCSR) {
+			const auto&  ev      = e.second;
+			const idx_t* my_vtx  = &ev[2];
+			const idx_t* my_xadj = &ev[2 + ev[0]];
+			const idx_t* my_edge = &ev[2 + ev[0] + (ev[0] + 1)];
+			for (USI i = 0; i < ev[0]; i++) {
+				if (my_vtx[i] >= global_well_start)  continue;
+				const OCP_USI bId = init_global_to_local.at(my_vtx[i]);
+				for (USI j = my_xadj[i]; j < my_xadj[i + 1]; j++) {
+					const auto iter = init_global_to_local.find(my_edge[j]);
+					if (iter != init_global_to_local.end())  adj[bId].push_back(iter->second);
+				}
+			}
+		}
+		ReorderInteriorRCM(adj, old2new);
+	}
+
+	// elements to be sent are in the same order as ghost grids of the receiver
+	for (auto& s : send_element_set) {
+		if (reorderRCM) {
+			set<OCP_USI> tmp;
+			for (const auto& s1 : s.second)  tmp.insert(old2new[s1]);
+			s.second.swap(tmp);
+		}
+		auto& sv = send_element_loc[s.first];
+		sv.assign(s.second.begin(), s.second.end());
+		sort(sv.begin(), sv.end(), [this](const OCP_USI& a, const OCP_USI& b) { return grid[a] < grid[b]; });
+	}
+
 	numGridGhost = 0;
 	localIndex   = init_global_to_local.size();
 
@@ -271,7 +314,7 @@ void Domain::SetCS01(const unordered_map<OCP_USI, OCP_DBL>& bk_info, unordered_m
 	cs_group_global_rank.clear();
 	for (const auto& b : bk_info) {
 		if (b.first < numGridInterior) {
-			for (const auto& s : send_element_loc) {
+			for (const auto& s : send_element_set) {
 				const auto& sv = s.second;
 				if (sv.count(b.first)) {
 					cs_group_global_rank.insert(s.first);
@@ -351,7 +394,7 @@ void Domain::SetCS02(const unordered_map<OCP_USI, OCP_DBL>& bk_info, unordered_m
 	cs_group_global_rank.clear();
 	for (const auto& b : bk_info) {
 		if (b.first < numGridInterior) {
-			for (const auto& s : send_element_loc) {
+			for (const auto& s : send_element_set) {
 				const auto& sv = s.second;
 				if (sv.count(b.first)) {
 					cs_group_global_rank.insert(s.first);
@@ -421,7 +464,7 @@ void Domain::SetCS03(const unordered_map<OCP_USI, OCP_DBL>& bk_info, unordered_m
 	cs_group_global_rank.clear();
 	for (const auto& b : bk_info) {
 		if (b.first < numGridInterior) {
-			for (const auto& s : send_element_loc) {
+			for (const auto& s : send_element_set) {
 				const auto& sv = s.second;
 				if (sv.count(b.first)) {
 					cs_group_global_rank.insert(s.first);
@@ -507,7 +550,7 @@ void Domain::SetCS04(const unordered_map<OCP_USI, OCP_DBL>& bk_info, unordered_m
 	cs_group_global_rank.clear();
 	for (const auto& b : bk_info) {
 		if (b.first < numGridInterior) {
-			for (const auto& s : send_element_loc) {
+			for (const auto& s : send_element_set) {
 				const auto& sv = s.second;
 				if (sv.count(b.first)) {
 					cs_group_global_rank.insert(s.first);
@@ -605,6 +648,72 @@ void Domain::ProcWeight_f2i(const unordered_map<OCP_INT, OCP_DBL>& tmp_proc_wght
 }
 
 
+void Domain::ReorderInteriorRCM(const vector<vector<OCP_USI>>& adj, vector<OCP_USI>& old2new)
+{
+	const OCP_USI n = adj.size();
+
+	// mark[i] == ordered  : i has been numbered
+	// mark[i] == stamp    : i has been visited in current search
+	const OCP_USI   ordered = 0;
+	OCP_USI         stamp   = 0;
+	vector<OCP_USI> mark(n, 1);
+	vector<OCP_USI> order;
+	vector<OCP_USI> comp;
+	vector<OCP_USI> level;
+	order.reserve(n);
+
+	auto degree = [&adj](const OCP_USI& i) { return adj[i].size(); };
+
+	// breadth-first search from root, neighbors are visited in ascending order of degree
+	auto BFS = [&](const OCP_USI& root, const OCP_USI& flag, vector<OCP_USI>& seq) {
+		const OCP_USI begin = seq.size();
+		seq.push_back(root);
+		mark[root] = flag;
+		for (OCP_USI k = begin; k < seq.size(); k++) {
+			level.clear();
+			for (const auto& j : adj[seq[k]]) {
+				if (mark[j] != ordered && mark[j] != flag) {
+					mark[j] = flag;
+					level.push_back(j);
+				}
+			}
+			sort(level.begin(), level.end(), [&degree](const OCP_USI& a, const OCP_USI& b) { return degree(a) < degree(b); });
+			seq.insert(seq.end(), level.begin(), level.end());
+		}
+	};
+
+	for (OCP_USI i = 0; i < n; i++) {
+		if (mark[i] == ordered)  continue;
+		// find a pseudo-peripheral root: the last vertex found by BFS from a
+		// vertex of minimal degree in current component
+		comp.clear();
+		BFS(i, stamp += 2, comp);
+		OCP_USI root = comp[0];
+		for (const auto& c : comp) {
+			if (degree(c) < degree(root))  root = c;
+		}
+		comp.clear();
+		BFS(root, stamp += 2, comp);
+
+		BFS(comp.back(), ordered, order);
+	}
+	reverse(order.begin(), order.end());
+
+	// apply the permutation
+	old2new.resize(n);
+	vector<OCP_ULL> tmpGrid(grid.begin(), grid.begin() + n);
+	for (OCP_USI k = 0; k < n; k++) {
+		old2new[order[k]]                = k;
+		grid[k]                          = tmpGrid[order[k]];
+		init_global_to_local[grid[k]]    = k;
+	}
+
+	if (CURRENT_RANK == MASTER_PROCESS) {
+		OCP_INFO("Interior grids are renumbered by RCM");
+	}
+}
+
+
 OCP_BOOL Domain::IfIRankInLSCommGroup(const OCP_INT& p) const
 {
 	if (cs_numproc == global_numproc) {
@@ -647,6 +756,7 @@ USI Domain::GetPerfNum(const OCP_USI& wId) const
 
 const vector<OCP_ULL>* Domain::CalGlobalIndex() const
 {
+	OCP_PROFILE("GlobalIndex");
 	global_index.resize(numGridLocal + numActWellLocal);
 
 	const OCP_ULL numElementLoc = numGridInterior + numActWellLocal;
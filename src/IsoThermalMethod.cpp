@@ -30,8 +30,23 @@ void IsothermalMethod::CalRock(Bulk& bk) const
 }
 
 
+void IsothermalMethod::CalRock(Bulk& bk, const vector<OCP_USI>& bList) const
+{
+    auto& bvs = bk.vs;
+    for (const auto& n : bList) {
+        auto ROCK = bk.ROCKm.GetROCK(n);
+
+        ROCK->CalPoro(bvs.P[n], bvs.T[n], bvs.poroInit[n], BulkContent::rf);
+        bvs.poro[n]   = ROCK->GetPoro();
+        bvs.poroP[n]  = ROCK->GetdPorodP();
+        bvs.rockVp[n] = bvs.v[n] * bvs.poro[n];
+    }
+}
+
+
 void IsothermalMethod::ExchangeSolutionP(Reservoir& rs) const
 {
+    OCP_PROFILE("Halo");
     // Exchange Ghost P
     const Domain& domain = rs.domain;
     BulkVarSet&   bvs    = rs.bulk.vs;
@@ -63,6 +78,7 @@ void IsothermalMethod::ExchangeSolutionP(Reservoir& rs) const
 
 void IsothermalMethod::ExchangeSolutionNi(Reservoir& rs) const
 {
+    OCP_PROFILE("Halo");
     // Exchange Ghost Ni
     const Domain& domain = rs.domain;
     BulkVarSet&   bvs    = rs.bulk.vs;
@@ -132,7 +148,9 @@ void IsoT_IMPEC::Prepare(Reservoir& rs, OCPControl& ctrl)
     UpdateLastTimeStep(rs);
 
     rs.allWells.PrepareWell(rs.bulk);
-    NR.CalCFL(rs, ctrl.time.GetCurrentDt(), OCP_TRUE);
+    // global CFL is reduced with the physical check, it is limited in each
+    // transport sub-step
+    NR.CalCFL(rs, ctrl.time.GetCurrentDt() / ctrl.time.GetSubCycle(), OCP_FALSE);
     if (!NR.CheckPhysical(rs, { "CFL" }, ctrl.time.GetCurrentDt())) {
         ctrl.time.CutDt(NR);
     }
@@ -193,26 +211,66 @@ OCP_BOOL IsoT_IMPEC::SolveLinearSystem(LinearSystem& ls, Reservoir& rs, OCPContr
 OCP_BOOL IsoT_IMPEC::UpdateProperty(Reservoir& rs, OCPControl& ctrl)
 {
 
-    // First check : Pressure check
-    if (!NR.CheckPhysical(rs, { "BulkP", "WellP" }, ctrl.time.GetCurrentDt())) {
+    const OCP_DBL  dt     = ctrl.time.GetCurrentDt();
+    const OCP_BOOL ifSubC = ctrl.time.GetSubCycle() > 1;
+
+    // First check : Pressure check, CFL of new flux is reduced with it if
+    // transport is sub-cycled
+    if (NR.CheckPhysicalLoc(rs, { "BulkP", "WellP" }, dt)) {
+        // Calculate Flux between bulks and between bulks and wells
+        CalFlux(rs);
+        if (ifSubC) NR.CalCFL(rs, dt, OCP_FALSE);
+    }
+    OCPNRreduce& red = NR.GetReduce();
+    red.Clear();
+    const USI iS = NR.PackWorkState(red);
+    const USI iC = ifSubC ? red.PackMax(NR.GetMaxCFL()) : 0;
+    red.Reduce();
+
+    if (!NR.UnpackWorkState(red, iS)) {
         ctrl.time.CutDt(NR);
-        NR.ResetIter();
-        rs.bulk.vs.P = rs.bulk.vs.lP;
+        // flux may have been calculated where the local check passes
+        ResetToLastTimeStep01(rs, ctrl);
         return OCP_FALSE;
     }
 
-    // Calculate Flux between bulks and between bulks and wells
-    CalFlux(rs);  
-    MassConserve(rs, ctrl.time.GetCurrentDt());
+    // Transport is split into sub-steps by CFL, pressure is reused in sub-steps
+    USI nsub = 1;
+    if (ifSubC) {
+        nsub = OCP_MIN(static_cast<USI>(ceil(red.GetMax(iC))), ctrl.time.GetSubCycle());
+        nsub = OCP_MAX(nsub, 1);
+    }
+    const OCP_DBL dts = dt / nsub;
 
-    // Second check : CFL check
-    NR.CalCFL(rs, ctrl.time.GetCurrentDt(), OCP_TRUE);
-    // Third check: Ni check
+    if (nsub > 1 && ctrl.time.IfMultirate()) {
+        if (!TransportMultirate(rs, ctrl, nsub)) {
+            return OCP_FALSE;
+        }
+    }
+    else {
+        for (USI s = 0; s < nsub; s++) {
+            if (s > 0) {
+                // Flux with properties of last sub-step
+                CalFlux(rs);
+            }
+            MassConserve(rs, dts);
 
-    if (!NR.CheckPhysical(rs, { "CFL","BulkNi" }, ctrl.time.GetCurrentDt())) {
-        ctrl.time.CutDt(NR);
-        ResetToLastTimeStep01(rs, ctrl);
-        return OCP_FALSE;
+            // Second check : CFL check, global CFL is reduced with the physical check
+            NR.CalCFL(rs, dts, OCP_FALSE);
+            // Third check: Ni check
+
+            if (!NR.CheckPhysical(rs, { "CFL","BulkNi" }, dts)) {
+                ctrl.time.CutDt(NR);
+                if (s == 0) ResetToLastTimeStep01(rs, ctrl);
+                else        ResetToLastTimeStep02(rs, ctrl);
+                return OCP_FALSE;
+            }
+
+            if (s + 1 < nsub) {
+                CalFlash(rs.bulk);
+                CalKrPc(rs.bulk);
+            }
+        }
     }
 
     CalRock(rs.bulk);
@@ -237,7 +295,15 @@ void IsoT_IMPEC::FinishStep(Reservoir& rs, OCPControl& ctrl)
 {
     rs.CalIPRT(ctrl.time.GetCurrentDt());
     NR.CalMaxChangeTime(rs);
-    ctrl.CalNextTimeStep(NR, {"dP", "dN", "dS", "eV"});
+    if (ctrl.time.GetSubCycle() > 1) {
+        // Pressure step is chosen by changes of pressure and volume error, it grows
+        // past CFL until transport takes max num of sub-steps
+        NR.CalCFL(rs, ctrl.time.GetCurrentDt(), OCP_FALSE);
+        ctrl.CalNextTimeStep(NR, {"dP", "eV", "CFL"});
+    }
+    else {
+        ctrl.CalNextTimeStep(NR, {"dP", "dN", "dS", "eV"});
+    }
 }
 
 void IsoT_IMPEC::AllocateReservoir(Reservoir& rs)
@@ -334,6 +400,8 @@ void IsoT_IMPEC::InitFlash(Bulk& bk) const
 
 void IsoT_IMPEC::CalFlash(Bulk& bk)
 {
+    OCP_PROFILE("Flash");
+    OCP_HWCOUNT(flash);
     const BulkVarSet& bvs = bk.vs;
 
     for (OCP_USI n = 0; n < bvs.nb; n++) {
@@ -343,6 +411,19 @@ void IsoT_IMPEC::CalFlash(Bulk& bk)
     }
 }
 
+void IsoT_IMPEC::CalFlash(Bulk& bk, const vector<OCP_USI>& bList)
+{
+    OCP_PROFILE("Flash");
+    OCP_HWCOUNT(flash);
+    const BulkVarSet& bvs = bk.vs;
+
+    for (const auto& n : bList) {
+
+        bk.PVTm.GetPVT(n)->FlashIMPEC(n, bvs);
+        PassFlashValue(bk, n);
+    }
+}
+
 void IsoT_IMPEC::PassFlashValue(Bulk& bk, const OCP_USI& n) const
 {
     BulkVarSet& bvs = bk.vs;
@@ -396,8 +477,27 @@ void IsoT_IMPEC::CalKrPc(Bulk& bk) const
     }
 }
 
+void IsoT_IMPEC::CalKrPc(Bulk& bk, const vector<OCP_USI>& bList) const
+{
+    BulkVarSet& bvs = bk.vs;
+
+    for (const auto& n : bList) {
+
+        auto SAT = bk.SATm.GetSAT(n);
+
+        OCP_USI bId = n * bvs.np;
+        SAT->CalKrPc(n, &bvs.S[bId]);
+        copy(SAT->GetKr().begin(), SAT->GetKr().end(), &bvs.kr[bId]);
+        copy(SAT->GetPc().begin(), SAT->GetPc().end(), &bvs.Pc[bId]);
+        for (USI j = 0; j < bvs.np; j++)
+            bvs.Pj[n * bvs.np + j] = bvs.P[n] + bvs.Pc[n * bvs.np + j];
+    }
+}
+
 void IsoT_IMPEC::CalFlux(Reservoir& rs) const
 {
+    OCP_PROFILE("Flux");
+    OCP_HWCOUNT(flux);
     CalBulkFlux(rs);
     rs.allWells.CalFlux(rs.bulk);
 }
@@ -426,6 +526,26 @@ void IsoT_IMPEC::CalBulkFlux(Reservoir& rs) const
     }
 }
 
+void IsoT_IMPEC::CalBulkFlux(Reservoir& rs, const vector<OCP_USI>& cList) const
+{
+    const Bulk&     bk   = rs.bulk;
+    BulkConn&       conn = rs.conn;
+    BulkConnVarSet& bcvs = conn.vs;
+    const USI       np   = bk.vs.np;
+    const USI       nc   = bk.vs.nc;
+
+    for (const auto& c : cList) {
+
+        auto Flux = conn.FLUXm.GetFlux(c);
+
+        Flux->CalFlux(conn.iteratorConn[c], bk);
+        copy(Flux->GetConvectUpblock().begin(), Flux->GetConvectUpblock().end(), &bcvs.upblock[c * np]);
+        copy(Flux->GetConvectDP().begin(), Flux->GetConvectDP().end(), &bcvs.dP[c * np]);
+        copy(Flux->GetConvectVj().begin(), Flux->GetConvectVj().end(), &bcvs.flux_vj[c * np]);
+        copy(Flux->GetFluxNi().begin(), Flux->GetFluxNi().end(), &bcvs.flux_ni[c * nc]);
+    }
+}
+
 void IsoT_IMPEC::MassConserve(Reservoir& rs, const OCP_DBL& dt) const
 {
 
@@ -462,10 +582,159 @@ void IsoT_IMPEC::MassConserve(Reservoir& rs, const OCP_DBL& dt) const
     ExchangeSolutionNi(rs);
 }
 
+
+void IsoT_IMPEC::MassConserve(Reservoir& rs, const OCP_DBL& dt, const vector<OCP_USI>& cList,
+                              const OCP_BOOL& ifWell) const
+{
+    BulkVarSet&     bvs  = rs.bulk.vs;
+    const USI       nc   = bvs.nc;
+    const BulkConn& conn = rs.conn;
+
+    for (const auto& c : cList) {
+        const OCP_USI bId = conn.iteratorConn[c].BId();
+        const OCP_USI eId = conn.iteratorConn[c].EId();
+
+        for (USI i = 0; i < nc; i++) {
+            bvs.Ni[eId * nc + i] += dt * conn.vs.flux_ni[c * nc + i];
+            bvs.Ni[bId * nc + i] -= dt * conn.vs.flux_ni[c * nc + i];
+        }
+    }
+
+    if (ifWell) {
+        for (auto& wl : rs.allWells.wells) {
+            if (wl->IsOpen()) {
+                for (USI p = 0; p < wl->PerfNum(); p++) {
+                    OCP_USI k = wl->PerfLocation(p);
+                    for (USI i = 0; i < nc; i++) {
+                        bvs.Ni[k * nc + i] -= wl->PerfQi_lbmol(p, i) * dt;
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+void IsoT_IMPEC::SetMultirateBulk(Reservoir& rs)
+{
+    const BulkVarSet& bvs    = rs.bulk.vs;
+    const BulkConn&   conn   = rs.conn;
+    const Domain&     domain = rs.domain;
+    const OCP_USI     nb     = bvs.nb;
+    const USI         np     = bvs.np;
+
+    // Bulks whose CFL of the whole step is too large
+    vector<OCP_BOOL> seed(nb, OCP_FALSE);
+    for (OCP_USI n = 0; n < bvs.nbI; n++) {
+        for (USI j = 0; j < np; j++) {
+            if (bvs.phaseExist[n * np + j] && NR.GetCFL(n, j) > 1) {
+                seed[n] = OCP_TRUE;
+                break;
+            }
+        }
+    }
+
+    // and their neighbors, which receive the fast flow
+    mrSub = seed;
+    for (OCP_USI c = 0; c < conn.numConn; c++) {
+        const OCP_USI bId = conn.iteratorConn[c].BId();
+        const OCP_USI eId = conn.iteratorConn[c].EId();
+        if (seed[bId] || seed[eId]) {
+            mrSub[bId] = OCP_TRUE;
+            mrSub[eId] = OCP_TRUE;
+        }
+    }
+
+    // Ghost bulks follow the processes they belong to, so that fluxes of
+    // connections between processes are updated consistently
+    USI iter = 0;
+    for (const auto& r : domain.recv_element_loc) {
+        const auto& rv = r.second;
+        MPI_Irecv(&mrSub[rv[0]], rv[1] - rv[0], OCPMPI_BOOL, r.first, 0, domain.global_comm, &domain.recv_request[iter]);
+        iter++;
+    }
+
+    iter = 0;
+    vector<vector<OCP_BOOL>> send_buffer(domain.send_element_loc.size());
+    for (const auto& s : domain.send_element_loc) {
+        const auto& sv = s.second;
+        auto&       sb = send_buffer[iter];
+        sb.reserve(sv.size());
+        for (const auto& sv1 : sv) {
+            sb.push_back(mrSub[sv1]);
+        }
+        MPI_Isend(sb.data(), sb.size(), OCPMPI_BOOL, s.first, 0, domain.global_comm, &domain.send_request[iter]);
+        iter++;
+    }
+
+    MPI_Waitall(iter, domain.send_request.data(), MPI_STATUS_IGNORE);
+    MPI_Waitall(iter, domain.recv_request.data(), MPI_STATUS_IGNORE);
+
+    mrBulk.clear();
+    for (OCP_USI n = 0; n < nb; n++) {
+        if (mrSub[n]) mrBulk.push_back(n);
+    }
+    mrConnFast.clear();
+    mrConnSlow.clear();
+    for (OCP_USI c = 0; c < conn.numConn; c++) {
+        if (mrSub[conn.iteratorConn[c].BId()] || mrSub[conn.iteratorConn[c].EId()]) {
+            mrConnFast.push_back(c);
+        }
+        else {
+            mrConnSlow.push_back(c);
+        }
+    }
+}
+
+
+OCP_BOOL IsoT_IMPEC::TransportMultirate(Reservoir& rs, OCPControl& ctrl, const USI& nsub)
+{
+    const OCP_DBL dt  = ctrl.time.GetCurrentDt();
+    const OCP_DBL dts = dt / nsub;
+
+    // CFL of the whole step has been calculated
+    SetMultirateBulk(rs);
+
+    // Connections between quiet bulks take the whole step at once, the quiet bulks
+    // receive the flux through other connections accumulated over the sub-steps
+    MassConserve(rs, dt, mrConnSlow, OCP_FALSE);
+
+    for (USI s = 0; s < nsub; s++) {
+        if (s > 0) {
+            // Flux with properties of last sub-step, which are only changed in
+            // the bulks taking sub-steps
+            CalBulkFlux(rs, mrConnFast);
+            rs.allWells.CalFlux(rs.bulk);
+        }
+        MassConserve(rs, dts, mrConnFast, OCP_TRUE);
+        ExchangeSolutionNi(rs);
+
+        // CFL check, quiet bulks take the whole step
+        NR.CalCFL(rs, dts, mrSub, nsub, OCP_FALSE);
+
+        if (!NR.CheckPhysical(rs, { "CFL","BulkNi" }, dts)) {
+            ctrl.time.CutDt(NR);
+            if (s == 0) ResetToLastTimeStep01(rs, ctrl);
+            else        ResetToLastTimeStep02(rs, ctrl);
+            return OCP_FALSE;
+        }
+
+        if (s + 1 < nsub) {
+            CalFlash(rs.bulk, mrBulk);
+            CalKrPc(rs.bulk, mrBulk);
+        }
+    }
+
+    return OCP_TRUE;
+}
+
+
 void IsoT_IMPEC::AssembleMatBulks(LinearSystem&    ls,
                                   const Reservoir& rs,
                                   const OCP_DBL&   dt) const
 {
+    OCP_PROFILE("AssembleBulk");
+    OCP_HWCOUNT(assembleBulk);
     const Bulk&       bk  = rs.bulk;
     const BulkVarSet& bvs = bk.vs;
 
@@ -523,6 +792,8 @@ void IsoT_IMPEC::AssembleMatWells(LinearSystem&    ls,
                                   const Reservoir& rs,
                                   const OCP_DBL&   dt) const
 {
+    OCP_PROFILE("AssembleWell");
+    OCP_HWCOUNT(assembleWell);
     for (auto& wl : rs.allWells.wells) {
         wl->AssembleMatIMPEC(ls, rs.bulk, dt);
     }
@@ -543,6 +814,7 @@ void IsoT_IMPEC::AssembleMatWells(LinearSystem&    ls,
 
 void IsoT_IMPEC::GetSolution(Reservoir& rs, vector<OCP_DBL>& u)
 {
+    OCP_PROFILE("GetSolution");
     Bulk&       bk = rs.bulk;
     BulkVarSet& bvs = bk.vs;
     const OCP_USI nb     = bvs.nb;
@@ -639,6 +911,9 @@ void IsoT_IMPEC::ResetToLastTimeStep02(Reservoir& rs, OCPControl& ctrl)
     bvs.rho        = bvs.lrho;
     bvs.xi         = bvs.lxi;
     bvs.mu         = bvs.lmu;
+    // changed by transport sub-steps
+    bvs.kr         = bvs.lkr;
+    bvs.Pc         = bvs.lPc;
 
     // derivatives
     bvs.vfP = bvs.lvfP;
@@ -712,6 +987,17 @@ void IsoT_FIM::Setup(Reservoir& rs, const OCPControl& ctrl)
 {
     // Allocate memory for reservoir
     AllocateReservoir(rs);
+    if (ctrl.NR.GetActiveTol() > 0) {
+        const BulkVarSet& bvs   = rs.bulk.vs;
+        const USI         bsize = (bvs.nc + 1) * (bvs.nc + 1);
+        actP.resize(bvs.nb);
+        actNi.resize(bvs.nb * bvs.nc);
+        actBulk.reserve(bvs.nb);
+        actFlag.resize(bvs.nb, OCP_TRUE);
+        actAcc.resize(bvs.nbI * bsize);
+        actFluxB.resize(rs.conn.GetNumConn() * bsize);
+        actFluxE.resize(rs.conn.GetNumConn() * bsize);
+    }
 }
 
 void IsoT_FIM::InitReservoir(Reservoir& rs)
@@ -728,15 +1014,30 @@ void IsoT_FIM::InitReservoir(Reservoir& rs)
     rs.allWells.InitBHP(rs.bulk);
 }
 
-void IsoT_FIM::Prepare(Reservoir& rs, const OCP_DBL& dt)
+void IsoT_FIM::Prepare(Reservoir& rs, const OCPControl& ctrl)
 {
+    const OCP_DBL dt = ctrl.time.GetCurrentDt();
     UpdateLastTimeStep(rs);
+    // properties of all bulks are updated in the first iteration
+    actAll  = OCP_TRUE;
+    actSkip = OCP_FALSE;
+    // Extrapolate initial guess from converged states
+    if (ctrl.NR.GetGuess() != OCPNRGuess::last) {
+        NR.SaveHistory(rs, ctrl.time.GetCurrentTime(), ctrl.time.GetWellChangeTime());
+        const USI order = ctrl.NR.GetGuess() == OCPNRGuess::linear ? 1 : 2;
+        if (NR.Extrapolate(rs, dt, order, ctrl.NR.DPmax())) {
+            CalFlash(rs.bulk);
+            CalKrPc(rs.bulk);
+            CalRock(rs.bulk);
+        }
+    }
     // Calculate well property at the beginning of next time step
     rs.allWells.PrepareWell(rs.bulk);
     // Calculate initial residual
     CalInitRes(rs, dt);
     NR.InitStep(rs.bulk.GetVarSet());
     NR.InitIter(); 
+    nextDt = -1;
 }
 
 void IsoT_FIM::AssembleMat(LinearSystem&    ls,
@@ -806,17 +1107,35 @@ OCP_BOOL IsoT_FIM::SolveLinearSystem(LinearSystem& ls,
 
 OCP_BOOL IsoT_FIM::UpdateProperty(Reservoir& rs, OCPControl& ctrl)
 {
-    if (!NR.CheckPhysical(rs, { "BulkNi", "BulkP" }, ctrl.time.GetCurrentDt())) {
-        ctrl.time.CutDt(NR);
-        ResetToLastTimeStep(rs, ctrl);
-        return OCP_FALSE;
+    actSkip = OCP_FALSE;
+    // The state is reduced with the convergence check in FinishNR,
+    // properties are not updated if the check fails locally
+    if (!NR.CheckPhysicalLoc(rs, { "BulkNi", "BulkP" }, ctrl.time.GetCurrentDt())) {
+        return OCP_TRUE;
     }
 
-    // Update fluid property
-    CalFlash(rs.bulk);
-    CalKrPc(rs.bulk);
-    // Update rock property
-    CalRock(rs.bulk);
+    if (ctrl.NR.GetActiveTol() > 0) {
+        // Bulks changed little keep their properties and derivatives
+        SetActiveBulk(rs.bulk, ctrl.NR.GetActiveTol());
+        CalFlash(rs.bulk, actBulk);
+        CalKrPc(rs.bulk, actBulk);
+        CalRock(rs.bulk, actBulk);
+        actSkip = actBulk.size() < rs.bulk.vs.nb;
+        // phase pressures follow the bulk pressure anyway
+        BulkVarSet& bvs = rs.bulk.vs;
+        for (OCP_USI n = 0; n < bvs.nb; n++) {
+            for (USI j = 0; j < bvs.np; j++) {
+                bvs.Pj[n * bvs.np + j] = bvs.P[n] + bvs.Pc[n * bvs.np + j];
+            }
+        }
+    }
+    else {
+        // Update fluid property
+        CalFlash(rs.bulk);
+        CalKrPc(rs.bulk);
+        // Update rock property
+        CalRock(rs.bulk);
+    }
     // Update well property
     rs.allWells.CalFlux(rs.bulk);
 
@@ -834,14 +1153,76 @@ OCP_BOOL IsoT_FIM::FinishNR(Reservoir& rs, OCPControl& ctrl)
     //}
 
     NR.CalMaxChangeNR(rs);
-    const OCPNRStateC conflag = ctrl.CheckConverge(NR, { "res", "d" });
+    NR.WaitRes0();
+
+    if (actSkip && (ifConvD ? ctrl.NR.CheckConvergeLoc(NR, { "res", "d" }, convFac)
+                            : ctrl.NR.CheckConvergeLoc(NR, { "res" }, convFac)) == OCPNRStateC::converge) {
+        // Convergence is only checked with the residual of re-evaluated bulks
+        actAll = OCP_TRUE;
+        UpdateProperty(rs, ctrl);
+    }
+
+    const OCPNRGlobal glob = ctrl.NR.GetGlobal();
+    OCPNRreduce&      red  = NR.GetReduce();
+    OCP_BOOL          pass;
+    OCPNRStateC       conflagG;
+    OCP_DBL           merit;
+    while (OCP_TRUE) {
+        // Physical check of UpdateProperty, convergence check and residual in one reduction
+        red.Clear();
+        const USI iS = NR.PackWorkState(red);
+        const USI iC = red.PackMax(static_cast<OCP_DBL>(ifConvD ? ctrl.NR.CheckConvergeLoc(NR, { "res", "d" }, convFac)
+                                                                 : ctrl.NR.CheckConvergeLoc(NR, { "res" }, convFac)));
+        const USI iM = red.PackMax(NR.res.maxRelRes_V);
+        red.Reduce();
+
+        pass     = NR.UnpackWorkState(red, iS);
+        conflagG = static_cast<OCPNRStateC>(static_cast<USI>(red.GetMax(iC)));
+        merit    = red.GetMax(iM);
+
+        if (glob != OCPNRGlobal::lineSearch ||
+            !NR.CutStep(rs, pass, conflagG == OCPNRStateC::converge, merit,
+                        ctrl.NR.LSmaxCut(), ctrl.NR.LSdecrease())) {
+            break;
+        }
+        // Trial iterate with a cut step
+        UpdatePropertyRes(rs, ctrl.time.GetCurrentDt());
+        NR.CalMaxChangeNR(rs);
+    }
+    resNR = merit;
+
+    if (!pass) {
+        ctrl.time.CutDt(NR);
+        ResetToLastTimeStep(rs, ctrl);
+        return OCP_FALSE;
+    }
+
+    if (glob == OCPNRGlobal::trustRegion) {
+        NR.UpdateTrustRegion(merit, ctrl.NR.TRminRadius());
+    }
+    else if (glob == OCPNRGlobal::lineSearch && NR.GetStepLength() < 1) {
+        // Derivatives of the accepted trial iterate
+        UpdateProperty(rs, ctrl);
+    }
+
+    const OCPNRStateC conflag = ctrl.NR.CheckConvergeGlobal(NR, conflagG);
 
     if (conflag == OCPNRStateC::converge) {
-        if (!NR.CheckPhysical(rs, { "WellP" }, ctrl.time.GetCurrentDt())) {
+        // Well check and next time step in one reduction, the well check has
+        // side effects so it can not be done before convergence is known
+        NR.CheckPhysicalLoc(rs, { "WellP" }, ctrl.time.GetCurrentDt());
+        NR.CalMaxChangeTime(rs);
+        red.Clear();
+        const USI iW = NR.PackWorkState(red);
+        const USI iT = red.PackMin(ctrl.time.CalNextTimeStepLoc(NR, { "dP", "dS", "iter" }));
+        red.Reduce();
+
+        if (!NR.UnpackWorkState(red, iW)) {
             ctrl.time.CutDt(NR);
             ResetToLastTimeStep(rs, ctrl);
             return OCP_FALSE;
         } else {
+            nextDt = red.GetMin(iT);
             return OCP_TRUE;
         }
     } else if (conflag == OCPNRStateC::not_converge) {
@@ -853,19 +1234,45 @@ OCP_BOOL IsoT_FIM::FinishNR(Reservoir& rs, OCPControl& ctrl)
     }
 }
 
+void IsoT_FIM::UpdatePropertyRes(Reservoir& rs, const OCP_DBL& dt)
+{
+    if (!NR.CheckPhysicalLoc(rs, { "BulkNi", "BulkP" }, dt)) {
+        return;
+    }
+
+    // Flash without derivatives
+    CalFlashRes(rs.bulk);
+    CalKrPc(rs.bulk);
+    CalRock(rs.bulk);
+    rs.allWells.CalFlux(rs.bulk);
+    actAll  = OCP_TRUE;
+    actSkip = OCP_FALSE;
+
+    CalRes(rs, dt);
+}
+
 void IsoT_FIM::FinishStep(Reservoir& rs, OCPControl& ctrl)
 {
+    NR.WaitRes0();
     rs.CalIPRT(ctrl.time.GetCurrentDt());
-    NR.CalMaxChangeTime(rs);
-    ctrl.CalNextTimeStep(NR, {"dP", "dS", "iter"});
+    if (nextDt > 0) {
+        // reduced with the well check in FinishNR
+        ctrl.time.SetNextTimeStep(nextDt);
+        nextDt = -1;
+    } else {
+        NR.CalMaxChangeTime(rs);
+        ctrl.CalNextTimeStep(NR, {"dP", "dS", "iter"});
+    }
 }
 
 
 /// Transfer to FIM method
-OCP_BOOL IsoT_FIM::TransferToFIM(const OCP_DBL& global_res0, Reservoir& rs, OCPControl& ctrl)
+OCP_BOOL IsoT_FIM::TransferToFIM(const OCP_DBL& global_res0, Reservoir& rs, OCPControl& ctrl, const OCP_BOOL& initIter)
 {
     CalRes(rs, ctrl.time.GetCurrentDt());
     NR.res.maxRelRes0_V = global_res0;
+    // line search and trust region start from the iterate of subdomain solves
+    NR.InitMerit0();
 
     //{
     //    OCP_DBL tmp;
@@ -887,7 +1294,10 @@ OCP_BOOL IsoT_FIM::TransferToFIM(const OCP_DBL& global_res0, Reservoir& rs, OCPC
 
     rs.domain.InitCSComm();
     NR.InitStep(rs.bulk.GetVarSet());
-    NR.InitIter();
+    if (initIter) NR.InitIter();
+    // properties have been calculated by subdomain solves
+    actAll  = OCP_TRUE;
+    actSkip = OCP_FALSE;
 
     return OCP_TRUE;
 }
@@ -1006,6 +1416,8 @@ void IsoT_FIM::InitFlash(Bulk& bk)
 
 void IsoT_FIM::CalFlash(Bulk& bk)
 {
+    OCP_PROFILE("Flash");
+    OCP_HWCOUNT(flash);
     const BulkVarSet& bvs = bk.vs;
 
     for (OCP_USI n = 0; n < bvs.nb; n++) {
@@ -1015,6 +1427,50 @@ void IsoT_FIM::CalFlash(Bulk& bk)
     }
 }
 
+void IsoT_FIM::CalFlash(Bulk& bk, const vector<OCP_USI>& bList)
+{
+    OCP_PROFILE("Flash");
+    OCP_HWCOUNT(flash);
+    const BulkVarSet& bvs = bk.vs;
+
+    for (const auto& n : bList) {
+
+        bk.PVTm.GetPVT(n)->FlashFIM(n, bvs);
+        PassFlashValue(bk, n);
+    }
+}
+
+void IsoT_FIM::CalFlashRes(Bulk& bk)
+{
+    OCP_PROFILE("Flash");
+    OCP_HWCOUNT(flash);
+    auto& bvs = bk.vs;
+    const auto np = bvs.np;
+    const auto nc = bvs.nc;
+
+    for (OCP_USI n = 0; n < bvs.nb; n++) {
+
+        const auto PVT = bk.PVTm.GetPVT(n);
+        PVT->FlashIMPEC(n, bvs);
+
+        bvs.Nt[n] = PVT->GetNt();
+        bvs.vf[n] = PVT->GetVf();
+        for (USI j = 0; j < np; j++) {
+            const OCP_USI bIdp = n * np + j;
+            bvs.S[bIdp]          = PVT->GetS(j);
+            bvs.phaseExist[bIdp] = PVT->GetPhaseExist(j);
+            if (bvs.phaseExist[bIdp]) {
+                bvs.rho[bIdp] = PVT->GetRho(j);
+                bvs.xi[bIdp]  = PVT->GetXi(j);
+                bvs.mu[bIdp]  = PVT->GetMu(j);
+                for (USI i = 0; i < nc; i++) {
+                    bvs.xij[bIdp * nc + i] = PVT->GetXij(j, i);
+                }
+            }
+        }
+    }
+}
+
 void IsoT_FIM::PassFlashValue(Bulk& bk, const OCP_USI& n)
 {
     auto&         bvs = bk.vs;
@@ -1078,8 +1534,47 @@ void IsoT_FIM::CalKrPc(Bulk& bk) const
     }
 }
 
+void IsoT_FIM::CalKrPc(Bulk& bk, const vector<OCP_USI>& bList) const
+{
+    BulkVarSet& bvs = bk.vs;
+    const USI&  np  = bvs.np;
+    for (const auto& n : bList) {
+        auto SAT = bk.SATm.GetSAT(n);
+
+        const OCP_USI bId = n * np;
+        SAT->CalKrPcFIM(n, &bvs.S[bId]);
+        copy(SAT->GetKr().begin(), SAT->GetKr().end(), &bvs.kr[bId]);
+        copy(SAT->GetPc().begin(), SAT->GetPc().end(), &bvs.Pc[bId]);
+        copy(SAT->GetdKrdS().begin(), SAT->GetdKrdS().end(), &bvs.dKrdS[bId * np]);
+        copy(SAT->GetdPcdS().begin(), SAT->GetdPcdS().end(), &bvs.dPcdS[bId * np]);
+    }
+}
+
+void IsoT_FIM::SetActiveBulk(const Bulk& bk, const OCP_DBL& tol)
+{
+    const BulkVarSet& bvs = bk.vs;
+    const USI         nc  = bvs.nc;
+
+    actBulk.clear();
+    for (OCP_USI n = 0; n < bvs.nb; n++) {
+        OCP_BOOL active = actAll || fabs(bvs.P[n] - actP[n]) > tol * fabs(actP[n]);
+        for (USI i = 0; i < nc && !active; i++) {
+            active = fabs(bvs.Ni[n * nc + i] - actNi[n * nc + i]) > tol * bvs.Nt[n];
+        }
+        actFlag[n] = active;
+        if (active) {
+            actBulk.push_back(n);
+            actP[n] = bvs.P[n];
+            copy(&bvs.Ni[n * nc], &bvs.Ni[n * nc] + nc, &actNi[n * nc]);
+        }
+    }
+    actAll = OCP_FALSE;
+}
+
 void IsoT_FIM::CalRes(Reservoir& rs, const OCP_DBL& dt, const OCP_BOOL& initRes0)
 {
+    OCP_PROFILE("Residual");
+    OCP_HWCOUNT(flux);
     const Bulk&       bk  = rs.bulk;
     const BulkVarSet& bvs = bk.vs;
 
@@ -1161,12 +1656,8 @@ void IsoT_FIM::CalRes(Reservoir& rs, const OCP_DBL& dt, const OCP_BOOL& initRes0
     Dscalar(res.resAbs.size(), -1.0, res.resAbs.data());
 
     if (initRes0) {
-        GetWallTime timer;
-        timer.Start();
-
-        MPI_Allreduce(&res.maxRelRes_V, &res.maxRelRes0_V, 1, OCPMPI_DBL, MPI_MIN, rs.domain.global_comm);
-
-        OCPTIME_COMM_COLLECTIVE += timer.Stop();
+        // completed before the first convergence check
+        NR.StartRes0();
 
         //if (CURRENT_RANK == 0) {
         //    cout << "FIM : globalres0 : " << scientific << setprecision(12) << res.maxRelRes0_V << endl;
@@ -1179,6 +1670,8 @@ void IsoT_FIM::AssembleMatBulks(LinearSystem&    ls,
                                 const Reservoir& rs,
                                 const OCP_DBL&   dt) const
 {
+    OCP_PROFILE("AssembleBulk");
+    OCP_HWCOUNT(assembleBulk);
     const Bulk& bk  = rs.bulk;
     const BulkVarSet& bvs = bk.vs;
 
@@ -1195,11 +1688,25 @@ void IsoT_FIM::AssembleMatBulks(LinearSystem&    ls,
 
     ls.AddDim(nbI);
 
+    // Blocks are cached if properties of bulks may be kept, only those of re-evaluated
+    // bulks and their connections are calculated if properties of some bulks are kept
+    const OCP_BOOL ifCache = !actFlag.empty();
+    const OCP_BOOL ifKeep  = ifCache && actSkip;
 
     // Accumulation term
     vector<OCP_DBL> bmat(bsize, 0);
+    vector<OCP_DBL> emat(bsize, 0);
     for (OCP_USI n = 0; n < nbI; n++) {
-        ls.NewDiag(n, bk.ACCm.GetAccumuTerm()->CaldFdXpFIM(n, bvs, dt));
+        if (!ifCache) {
+            ls.NewDiag(n, bk.ACCm.GetAccumuTerm()->CaldFdXpFIM(n, bvs, dt));
+            continue;
+        }
+        if (!ifKeep || actFlag[n]) {
+            const auto& acc = bk.ACCm.GetAccumuTerm()->CaldFdXpFIM(n, bvs, dt);
+            copy(acc.begin(), acc.end(), &actAcc[n * bsize]);
+        }
+        bmat.assign(&actAcc[n * bsize], &actAcc[n * bsize] + bsize);
+        ls.NewDiag(n, bmat);
     }
 
     // flux term  
@@ -1208,13 +1715,27 @@ void IsoT_FIM::AssembleMatBulks(LinearSystem&    ls,
 
         bId       = conn.iteratorConn[c].BId();
         eId       = conn.iteratorConn[c].EId();
-        auto Flux = conn.FLUXm.GetFlux(c);
 
-        Flux->AssembleMatFIM(conn.iteratorConn[c], c, conn.vs, bk);
-        
-        bmat = Flux->GetdFdXpB();
-        DaABpbC(ncol, ncol, ncol2, dt, Flux->GetdFdXsB().data(), &bvs.dSec_dPri[bId * bsize2], dt,
-            bmat.data());
+        if (ifKeep && !actFlag[bId] && !actFlag[eId]) {
+            // both bulks keep their properties
+            bmat.assign(&actFluxB[c * bsize], &actFluxB[c * bsize] + bsize);
+            emat.assign(&actFluxE[c * bsize], &actFluxE[c * bsize] + bsize);
+        }
+        else {
+            auto Flux = conn.FLUXm.GetFlux(c);
+            Flux->AssembleMatFIM(conn.iteratorConn[c], c, conn.vs, bk);
+
+            bmat = Flux->GetdFdXpB();
+            DaABpbC(ncol, ncol, ncol2, dt, Flux->GetdFdXsB().data(), &bvs.dSec_dPri[bId * bsize2], dt,
+                bmat.data());
+            emat = Flux->GetdFdXpE();
+            DaABpbC(ncol, ncol, ncol2, dt, Flux->GetdFdXsE().data(), &bvs.dSec_dPri[eId * bsize2], dt,
+                emat.data());
+            if (ifCache) {
+                copy(bmat.begin(), bmat.end(), &actFluxB[c * bsize]);
+                copy(emat.begin(), emat.end(), &actFluxE[c * bsize]);
+            }
+        }
 
         // Assemble
         // Begin - Begin -- add
@@ -1233,26 +1754,22 @@ void IsoT_FIM::AssembleMatBulks(LinearSystem&    ls,
 #endif
 
         // End
-        bmat = Flux->GetdFdXpE();
-        DaABpbC(ncol, ncol, ncol2, dt, Flux->GetdFdXsE().data(), &bvs.dSec_dPri[eId * bsize2], dt,
-            bmat.data());
-        
         if (eId < nbI) {
             // Interior grid
             // Begin - End -- insert
-            ls.NewOffDiag(bId, eId, bmat);
+            ls.NewOffDiag(bId, eId, emat);
             // End - End -- add
-            Dscalar(bsize, -1, bmat.data());
-            ls.AddDiag(eId, bmat);
+            Dscalar(bsize, -1, emat.data());
+            ls.AddDiag(eId, emat);
         }
         else {
             // ghost grid
             // Begin - End -- insert
-            ls.NewOffDiag(bId, eId + numWell, bmat);
+            ls.NewOffDiag(bId, eId + numWell, emat);
         }
 
 #ifdef OCP_NANCHECK
-        if (!CheckNan(bmat.size(), &bmat[0])) {
+        if (!CheckNan(emat.size(), &emat[0])) {
             OCP_ABORT("INF or INF in bmat !");
         }
 #endif
@@ -1264,6 +1781,8 @@ void IsoT_FIM::AssembleMatWells(LinearSystem&    ls,
                                 const Reservoir& rs,
                                 const OCP_DBL&   dt) const
 {
+    OCP_PROFILE("AssembleWell");
+    OCP_HWCOUNT(assembleWell);
     for (auto& wl : rs.allWells.wells) {
         wl->AssembleMatFIM(ls, rs.bulk, dt);
     }
@@ -1274,6 +1793,7 @@ void IsoT_FIM::GetSolution(Reservoir&        rs,
                            vector<OCP_DBL>&  u,
                            const ControlNR& ctrlNR)
 {
+    OCP_PROFILE("GetSolution");
     const auto& domain = rs.domain;
     auto&       bk     = rs.bulk;
     auto&       bvs    = bk.vs;
@@ -1282,6 +1802,10 @@ void IsoT_FIM::GetSolution(Reservoir&        rs,
     const auto  nc     = bvs.nc;
     const auto  row    = np * (nc + 1);
     const auto  col    = nc + 1;
+    const auto  glob   = ctrlNR.GetGlobal();
+
+    // Line search starts from the iterate before update
+    if (glob == OCPNRGlobal::lineSearch) NR.SaveIterate(rs);
 
     // Well first
     USI wId = bvs.nbI * col;
@@ -1318,9 +1842,11 @@ void IsoT_FIM::GetSolution(Reservoir&        rs,
     }
 
 
-    // Bulk
-    const OCP_DBL dSmaxlim = ctrlNR.DSmax();
-    const OCP_DBL dPmaxlim = ctrlNR.DPmax();
+    // Bulk, trust region scales the limits of changes and limits pressure change also
+    const OCP_BOOL ifTR     = (glob == OCPNRGlobal::trustRegion);
+    const OCP_DBL  trRadius = ifTR ? NR.GetTRradius() : 1.0;
+    const OCP_DBL  dSmaxlim = ctrlNR.DSmax() * trRadius;
+    const OCP_DBL  dPmaxlim = ctrlNR.DPmax() * trRadius;
 
     vector<OCP_DBL> dtmp(row, 0);
     OCP_DBL         chopmin = 1;
@@ -1338,6 +1864,9 @@ void IsoT_FIM::GetSolution(Reservoir&        rs,
 			// const vector<OCP_DBL>& scm = satcm[SATNUM[n]];
 
 			chopmin = 1;
+			if (ifTR && fabs(u[n * col]) > dPmaxlim) {
+				chopmin = dPmaxlim / fabs(u[n * col]);
+			}
 			// compute the chop
 			fill(dtmp.begin(), dtmp.end(), 0.0);
 
@@ -1374,7 +1903,8 @@ void IsoT_FIM::GetSolution(Reservoir&        rs,
 			// dP
 			//choptmp = dPmaxlim / fabs(u[n * col]);
 			//chopmin = min(chopmin, choptmp);
-			bvs.P[n] += u[n * col]; // seems better
+			if (ifTR) bvs.P[n] += chopmin * u[n * col];
+			else      bvs.P[n] += u[n * col]; // seems better
 
 			// dNi
 			for (USI i = 0; i < nc; i++) {
@@ -1406,6 +1936,8 @@ void IsoT_FIM::GetSolution(Reservoir&        rs,
 
     OCPTIME_COMM_P2P += (timerT.Stop() - time_cal);
     OCPTIME_NRSTEPC  += time_cal;
+
+    if (glob == OCPNRGlobal::lineSearch) NR.SaveUpdate(rs);
 }
 
 void IsoT_FIM::ResetToLastTimeStep(Reservoir& rs, OCPControl& ctrl)
@@ -1459,6 +1991,8 @@ void IsoT_FIM::ResetToLastTimeStep(Reservoir& rs, OCPControl& ctrl)
 
     NR.InitStep(rs.bulk.GetVarSet());
     NR.ResetIter();
+    actAll  = OCP_TRUE;
+    actSkip = OCP_FALSE;
 }
 
 void IsoT_FIM::UpdateLastTimeStep(Reservoir& rs) const
@@ -1517,6 +2051,10 @@ void IsoT_AIMc::Setup(Reservoir& rs, const OCPControl& ctrl)
     AllocateReservoir(rs);
     // Setup neighbor
     SetupNeighbor(rs);
+
+    aimParam = ctrl.SM.GetAIMParam();
+    aimSeed.resize(rs.GetBulkNum(), OCP_FALSE);
+    aimLocal.Setup(rs.GetBulkNum());
 }
 
 
@@ -1622,11 +2160,10 @@ OCP_BOOL IsoT_AIMc::SolveLinearSystem(LinearSystem& ls, Reservoir& rs, OCPContro
 
 OCP_BOOL IsoT_AIMc::UpdateProperty(Reservoir& rs, OCPControl& ctrl)
 {
-    // First check: Ni check and bulk Pressure check
-    if (!NR.CheckPhysical(rs, { "BulkNi", "BulkP" }, ctrl.time.GetCurrentDt())) {
-        ctrl.time.CutDt(NR);
-        ResetToLastTimeStep(rs, ctrl);
-        return OCP_FALSE;
+    // First check: Ni check and bulk Pressure check, which is reduced with the
+    // convergence check in FinishNR
+    if (!NR.CheckPhysicalLoc(rs, { "BulkNi", "BulkP" }, ctrl.time.GetCurrentDt())) {
+        return OCP_TRUE;
     }
 
     CalFlashI(rs.bulk);
@@ -1644,16 +2181,41 @@ OCP_BOOL IsoT_AIMc::UpdateProperty(Reservoir& rs, OCPControl& ctrl)
 OCP_BOOL IsoT_AIMc::FinishNR(Reservoir& rs, OCPControl& ctrl)
 {
     NR.CalMaxChangeNR(rs);
-    const OCPNRStateC conflag = ctrl.CheckConverge(NR, { "res", "d" });
+    NR.WaitRes0();
+
+    // Physical check of UpdateProperty and convergence check in one reduction
+    OCPNRreduce& red = NR.GetReduce();
+    red.Clear();
+    const USI iS = NR.PackWorkState(red);
+    const USI iC = red.PackMax(static_cast<OCP_DBL>(ctrl.NR.CheckConvergeLoc(NR, { "res", "d" }, 1.0)));
+    red.Reduce();
+
+    if (!NR.UnpackWorkState(red, iS)) {
+        ctrl.time.CutDt(NR);
+        ResetToLastTimeStep(rs, ctrl);
+        return OCP_FALSE;
+    }
+
+    const OCPNRStateC conflag = ctrl.NR.CheckConvergeGlobal(NR, static_cast<OCPNRStateC>(static_cast<USI>(red.GetMax(iC))));
 
     if (conflag == OCPNRStateC::converge) {
-        if (!NR.CheckPhysical(rs, { "WellP" }, ctrl.time.GetCurrentDt())) {
+        // Well check and next time step in one reduction as FIM, explicit bulks are
+        // updated first since their saturations take part in the next time step
+        CalFlashEa(rs.bulk);
+        CalKrPcE(rs.bulk);
+        NR.CheckPhysicalLoc(rs, { "WellP" }, ctrl.time.GetCurrentDt());
+        NR.CalMaxChangeTime(rs);
+        red.Clear();
+        const USI iW = NR.PackWorkState(red);
+        const USI iT = red.PackMin(ctrl.time.CalNextTimeStepLoc(NR, { "dP", "dS", "iter" }));
+        red.Reduce();
+
+        if (!NR.UnpackWorkState(red, iW)) {
             ctrl.time.CutDt(NR);
             ResetToLastTimeStep(rs, ctrl);
             return OCP_FALSE;
         } else {
-            CalFlashEa(rs.bulk);
-            CalKrPcE(rs.bulk);
+            nextDt = red.GetMin(iT);
             return OCP_TRUE;
         }
 
@@ -1669,9 +2231,16 @@ OCP_BOOL IsoT_AIMc::FinishNR(Reservoir& rs, OCPControl& ctrl)
 /// Finish a time step.
 void IsoT_AIMc::FinishStep(Reservoir& rs, OCPControl& ctrl)
 {
+    NR.WaitRes0();
     rs.CalIPRT(ctrl.time.GetCurrentDt());
-    NR.CalMaxChangeTime(rs);
-    ctrl.CalNextTimeStep(NR, {"dP", "dS", "iter"});
+    if (nextDt > 0) {
+        // reduced with the well check in FinishNR
+        ctrl.time.SetNextTimeStep(nextDt);
+        nextDt = -1;
+    } else {
+        NR.CalMaxChangeTime(rs);
+        ctrl.CalNextTimeStep(NR, {"dP", "dS", "iter"});
+    }
 }
 
 /// Allocate memory for reservoir
@@ -1693,67 +2262,56 @@ void IsoT_AIMc::AllocateReservoir(Reservoir& rs)
 void IsoT_AIMc::SetFIMBulk(Reservoir& rs)
 {
     // IMPORTANT: implicity of the same grid in different processes should be consistent
-    
-    const OCP_INT nlayers = 2;
-
-    // We just consider at most 1 layer neighbor now
 
-    Bulk&           bk   = rs.bulk;
-    BulkVarSet&     bvs  = bk.vs;
-    const BulkConn& conn = rs.conn;
-    const OCP_USI   nb   = bvs.nbI;
-    const USI       np   = bvs.np;
-    const USI       nc   = bvs.nc;
-
-    // all impec
-    bk.bulkTypeAIM.Init(-1);
-
-    OCP_USI  bIdc;
-    OCP_BOOL flag;
+    Bulk&           bk     = rs.bulk;
+    BulkVarSet&     bvs    = bk.vs;
+    const BulkConn& conn   = rs.conn;
+    const OCP_USI   nb     = bvs.nbI;
+    const USI       np     = bvs.np;
+    const OCP_INT   nlayer = aimParam.nlayer;
 
+    // Seeds: well bulks, and bulks whose CFL or volume error is too large. A seed
+    // stays a seed until its CFL falls below cflOff, so it does not switch every step
+    vector<OCP_BOOL> seed(aimSeed.size(), OCP_FALSE);
+    for (const auto& p : bk.wellBulkId) {
+        seed[p] = OCP_TRUE;
+    }
     for (OCP_USI n = 0; n < nb; n++) {
-        bIdc = n * nc;
-        flag = OCP_FALSE;
+        if (seed[n]) continue;
         // CFL
+        const OCP_DBL cflLim = aimSeed[n] ? aimParam.cflOff : aimParam.cflOn;
         for (USI j = 0; j < np; j++) {
-            if (NR.GetCFL(n,j) > 0.8) {
-                flag = OCP_TRUE;
+            if (NR.GetCFL(n, j) > cflLim) {
+                seed[n] = OCP_TRUE;
                 break;
             }
         }
         // Volume error
-        if (!flag) {
-            if ((fabs(bvs.vf[n] - bvs.rockVp[n]) / bvs.rockVp[n]) > 1E-3) {
-                flag = OCP_TRUE;
+        if (!seed[n]) {
+            if ((fabs(bvs.vf[n] - bvs.rockVp[n]) / bvs.rockVp[n]) > aimParam.ve) {
+                seed[n] = OCP_TRUE;
             }
         }
+    }
 
-        // NR Step
-        if (!flag && OCP_FALSE) {
-            // dP
-            if (fabs(NR.DP(n) / bvs.P[n]) > 1E-3) {
-                flag = OCP_TRUE;
-            }
-            // dNi
-            if (!flag) {
-                for (USI i = 0; i < bvs.nc; i++) {
-                    if (fabs(NR.DN(n,i) / bvs.Ni[bIdc + i]) > 1E-3) {
-                        flag = OCP_TRUE;
-                        break;
-                    }
-                }
-            }
+    // Implicity from local seeds is updated incrementally: new seeds only add their
+    // k-neighbors, it is rebuilt only if some seeds are dropped
+    OCP_BOOL rebuild = OCP_FALSE;
+    for (OCP_USI n = 0; n < seed.size(); n++) {
+        if (aimSeed[n] && !seed[n]) {
+            rebuild = OCP_TRUE;
+            break;
         }
-
-        if (flag) {
-            SetKNeighbor(conn.neighbor, n, bk.bulkTypeAIM, nlayers);
+    }
+    if (rebuild) aimLocal.Init(-1);
+    for (OCP_USI n = 0; n < seed.size(); n++) {
+        if (seed[n] && (rebuild || !aimSeed[n])) {
+            SetKNeighbor(conn.neighbor, n, aimLocal, nlayer);
         }
     }
+    aimSeed.swap(seed);
 
-    // add WellBulk's 1-neighbor as Implicit bulk
-    for (auto& p : bk.wellBulkId) {
-        SetKNeighbor(conn.neighbor, p, bk.bulkTypeAIM, nlayers);
-    }
+    bk.bulkTypeAIM = aimLocal;
 
     // exchange information of implicity of grid
     const Domain& domain = rs.domain;
@@ -1846,7 +2404,9 @@ void IsoT_AIMc::SetFIMBulk(Reservoir& rs)
 
 void IsoT_AIMc::SetKNeighbor(const vector<vector<OCP_USI>>& neighbor, const OCP_USI& p, BulkTypeAIM& tar, OCP_INT k)
 {
-    tar.SetBulkType(p, max(k, tar.GetBulkType(p)));
+    // (k-1)-neighbors of p have been set if type of p is not less than k
+    if (tar.GetBulkType(p) >= k) return;
+    tar.SetBulkType(p, k);
     if (k > 0) {
         k--;
         for (const auto& v : neighbor[p]) {
@@ -1858,6 +2418,8 @@ void IsoT_AIMc::SetKNeighbor(const vector<vector<OCP_USI>>& neighbor, const OCP_
 
 void IsoT_AIMc::CalFlashEp(Bulk& bk)
 {
+    OCP_PROFILE("Flash");
+    OCP_HWCOUNT(flash);
     const BulkVarSet& bvs = bk.vs;
     const OCP_USI&    nb  = bvs.nb;
 
@@ -1874,6 +2436,8 @@ void IsoT_AIMc::CalFlashEp(Bulk& bk)
 
 void IsoT_AIMc::CalFlashEa(Bulk& bk)
 {
+    OCP_PROFILE("Flash");
+    OCP_HWCOUNT(flash);
     const BulkVarSet& bvs = bk.vs;
     const OCP_USI&    nb  = bvs.nb;
 
@@ -1891,6 +2455,8 @@ void IsoT_AIMc::CalFlashEa(Bulk& bk)
 
 void IsoT_AIMc::CalFlashI(Bulk& bk)
 {
+    OCP_PROFILE("Flash");
+    OCP_HWCOUNT(flash);
     BulkVarSet&    bvs = bk.vs;
     const OCP_USI& nb  = bvs.nb;
     const USI&     np  = bvs.np;
@@ -1983,6 +2549,8 @@ void IsoT_AIMc::AssembleMatBulks(LinearSystem&    ls,
                                  const Reservoir& rs,
                                  const OCP_DBL&   dt) const
 {
+    OCP_PROFILE("AssembleBulk");
+    OCP_HWCOUNT(assembleBulk);
     const USI numWell = rs.GetNumOpenWell();
 
     const Bulk&       bk      = rs.bulk;
@@ -2084,6 +2652,7 @@ void IsoT_AIMc::GetSolution(Reservoir&       rs,
                             vector<OCP_DBL>& u,
                             const ControlNR& ctrlNR)
 {
+    OCP_PROFILE("GetSolution");
     const Domain&   domain = rs.domain;
     Bulk&           bk     = rs.bulk;
     BulkVarSet&     bvs    = bk.vs;
@@ -2247,6 +2816,7 @@ void IsoT_FIMddm::Setup(Reservoir& rs, const OCPControl& ctrl)
 {
     // Allocate memory for reservoir
     AllocateReservoir(rs);
+    maxSub = ctrl.SM.GetDDMSubStep();
 }
 
 
@@ -2262,6 +2832,21 @@ void IsoT_FIMddm::Prepare(Reservoir& rs, const OCP_DBL& dt)
 
     rs.domain.SetCSComm(starBulkSet);
     CalRankSet(rs.domain);
+    if (IfSubStep()) {
+        // Processes solving a subdomain together take the same sub-steps
+        GetWallTime timer;
+        timer.Start();
+        USI numSubG;
+        MPI_Allreduce(&numSub, &numSubG, 1, OCPMPI_USI, MPI_MAX, rs.domain.cs_comm);
+        OCPTIME_COMM_COLLECTIVE += timer.Stop();
+
+        numSub   = numSubG;
+        iSub     = 0;
+        iterSub0 = 0;
+        subDone  = OCP_FALSE;
+        subFail  = OCP_FALSE;
+        lNiStep.assign(rs.bulk.vs.lNi.begin(), rs.bulk.vs.lNi.begin() + rs.bulk.vs.nbI * rs.bulk.vs.nc);
+    }
     // Calculate well property at the beginning of next time step
     rs.allWells.PrepareWell(rs.bulk);
     // Calculate initial residual
@@ -2273,9 +2858,14 @@ void IsoT_FIMddm::Prepare(Reservoir& rs, const OCP_DBL& dt)
 
 void IsoT_FIMddm::AssembleMat(LinearSystem& ls, const Reservoir& rs, const OCP_DBL& dt) const
 {
+    // Subdomain has finished its sub-steps, it waits for the others
+    if (subDone) {
+        rs.domain.SetNumActWellLocal(rs.GetNumOpenWell());
+        return;
+    }
     // Assemble matrix
-    AssembleMatBulks(ls, rs, dt);
-    IsoT_FIM::AssembleMatWells(ls, rs, dt);
+    AssembleMatBulks(ls, rs, SubDt(dt));
+    IsoT_FIM::AssembleMatWells(ls, rs, SubDt(dt));
     // Assemble rhs -- from residual
     ls.CopyRhs(NR.res.resAbs);
     rs.domain.SetNumActWellLocal(rs.GetNumOpenWell());
@@ -2285,23 +2875,31 @@ void IsoT_FIMddm::AssembleMat(LinearSystem& ls, const Reservoir& rs, const OCP_D
 OCP_BOOL IsoT_FIMddm::SolveLinearSystem(LinearSystem& ls, Reservoir& rs, OCPControl& ctrl)
 {
     GetWallTime timer;
-    timer.Start();
-    ls.AssembleMatLinearSolver();
-    OCPTIME_CONVERT_MAT_FOR_LS_IF += timer.Stop();
+    int         iter = 0;
+    if (!subDone) {
+        timer.Start();
+        ls.AssembleMatLinearSolver();
+        OCPTIME_CONVERT_MAT_FOR_LS_IF += timer.Stop();
 
-    // Solve linear system
-    //ls.OutputLinearSystem("proc" + to_string(CURRENT_RANK) + "_A_ddm.out",
-    //    "proc" + to_string(CURRENT_RANK) + "_b_ddm.out");
+        // Solve linear system
+        //ls.OutputLinearSystem("proc" + to_string(CURRENT_RANK) + "_A_ddm.out",
+        //    "proc" + to_string(CURRENT_RANK) + "_b_ddm.out");
 
-    timer.Start();
-    int iter = ls.Solve();
-    // Record time, iterations
-    OCPTIME_LSOLVER += timer.Stop();
-    OCPTIME_LSOLVER_DDM += timer.Stop();
+        timer.Start();
+        iter = ls.Solve();
+        // Record time, iterations
+        OCPTIME_LSOLVER += timer.Stop();
+        OCPTIME_LSOLVER_DDM += timer.Stop();
+    }
 
     int status = 0;
     MPI_Allreduce(&iter, &status, 1, OCPMPI_INT, MPI_MIN, rs.domain.global_comm);
 
+    if (subDone) {
+        MPI_Barrier(rs.domain.global_comm);
+        return OCP_TRUE;
+    }
+
     NR.UpdateIter(abs(iter));
 
     if (status < 0) {
@@ -2343,7 +2941,13 @@ OCP_BOOL IsoT_FIMddm::SolveLinearSystem(LinearSystem& ls, Reservoir& rs, OCPCont
 
 OCP_BOOL IsoT_FIMddm::UpdateProperty(Reservoir& rs, OCPControl& ctrl)
 {
-    if (!NR.CheckPhysical(rs, { "BulkNi", "BulkP" }, ctrl.time.GetCurrentDt())) {
+    if (IfSubStep()) {
+        if (subDone) return OCP_TRUE;
+        // Failure of a subdomain is handled with its sub-steps in FinishNR
+        subFail = !NR.CheckPhysicalLoc(rs, { "BulkNi", "BulkP" }, SubDt(ctrl.time.GetCurrentDt()));
+        if (subFail) return OCP_TRUE;
+    }
+    else if (!NR.CheckPhysical(rs, { "BulkNi", "BulkP" }, ctrl.time.GetCurrentDt())) {
         ctrl.time.CutDt(NR);
         ResetToLastTimeStep(rs, ctrl);
         return OCP_FALSE;
@@ -2366,7 +2970,10 @@ OCP_BOOL IsoT_FIMddm::UpdateProperty(Reservoir& rs, OCPControl& ctrl)
 
 OCP_BOOL IsoT_FIMddm::FinishNR(Reservoir& rs, OCPControl& ctrl)
 {
-    if (preM && OCP_TRUE) {
+    if (IfSubStep()) {
+        return FinishNRSubStep(rs, ctrl);
+    }
+    else if (preM && OCP_TRUE) {
         // check residual for each local nonlinear equations
         NR.CalMaxChangeNR(rs);
         const OCPNRStateC conflag = ctrl.CheckConverge(NR, { "res", "d" }, 1E2);
@@ -2429,6 +3036,100 @@ OCP_BOOL IsoT_FIMddm::FinishNR(Reservoir& rs, OCPControl& ctrl)
 }
 
 
+/// Finish a Newton iteration of subdomains taking sub-steps, subdomains advance
+/// their own sub-steps, a subdomain which fails refines its sub-steps first
+OCP_BOOL IsoT_FIMddm::FinishNRSubStep(Reservoir& rs, OCPControl& ctrl)
+{
+    const OCP_DBL dt = ctrl.time.GetCurrentDt();
+    const USI     nc = rs.bulk.vs.nc;
+    const OCP_USI nb = rs.bulk.vs.nbI;
+
+    // check residual for each subdomain in its current sub-step
+    OCPNRStateC conflag_loc = OCPNRStateC::converge;
+    if (subFail) {
+        conflag_loc = OCPNRStateC::not_converge;
+    }
+    else if (!subDone) {
+        NR.CalMaxChangeNR(rs);
+        conflag_loc = ctrl.NR.CheckConvergeLoc(NR, { "res", "d" }, 1E2);
+        if (conflag_loc != OCPNRStateC::converge && NR.GetIterNR() - iterSub0 < ctrl.NR.MaxIter()) {
+            conflag_loc = OCPNRStateC::continueIter;
+        }
+    }
+
+    GetWallTime timer;
+    timer.Start();
+    OCPNRStateC conflag;
+    MPI_Allreduce(&conflag_loc, &conflag, 1, OCPMPI_ENUM, MPI_MAX, rs.domain.cs_comm);
+    OCPTIME_COMM_COLLECTIVE += timer.Stop();
+
+    if (conflag == OCPNRStateC::converge && !subDone) {
+        if (iSub + 1 < numSub) {
+            // next sub-step starts from the current one
+            iSub++;
+            iterSub0 = NR.GetIterNR();
+            copy(&rs.bulk.vs.Ni[0], &rs.bulk.vs.Ni[0] + nb * nc, &rs.bulk.vs.lNi[0]);
+            CalRes(rs, dt, OCP_FALSE);
+        }
+        else {
+            subDone = OCP_TRUE;
+        }
+    }
+
+    const OCP_BOOL refine = (conflag == OCPNRStateC::not_converge);
+    OCPNRreduce&   red    = NR.GetReduce();
+    red.Clear();
+    const USI iD = red.PackMax(subDone ? 0.0 : 1.0);
+    const USI iR = red.PackMax(refine ? 1.0 : 0.0);
+    const USI iM = red.PackMax(refine && numSub >= maxSub ? 1.0 : 0.0);
+    red.Reduce();
+
+    if (red.GetMax(iM) > 0) {
+        // the finest sub-steps fail, the time step is cut for all subdomains
+        ctrl.time.CutDt();
+        ResetToLastTimeStep(rs, ctrl);
+        return OCP_FALSE;
+    }
+    else if (red.GetMax(iR) > 0) {
+        // the time step is repeated with finer sub-steps in failed subdomains
+        if (refine) numSub = min(static_cast<USI>(2 * numSub), maxSub);
+        ResetToLastTimeStep(rs, ctrl);
+        return OCP_FALSE;
+    }
+    else if (red.GetMax(iD) > 0) {
+        return OCP_FALSE;
+    }
+
+    copy(lNiStep.begin(), lNiStep.end(), &rs.bulk.vs.lNi[0]);
+    if (!NR.CheckPhysical(rs, { "WellP" }, dt)) {
+        ctrl.time.CutDt(NR);
+        ResetToLastTimeStep(rs, ctrl);
+        return OCP_FALSE;
+    }
+    // exchange solution
+    ExchangePBoundary(rs);
+    ExchangeNiBoundary(rs);
+    UpdatePropertyBoundary(rs);
+    return OCP_TRUE;
+}
+
+
+/// Transfer from FIM, subdomain problems restart from the current global iterate,
+/// their boundaries are fixed at it (fluxes for constV, P and Ni of neighbors for constP)
+void IsoT_FIMddm::TransferToFIMddm(Reservoir& rs, const OCPControl& ctrl)
+{
+    rs.domain.SetCSComm(starBulkSet);
+    CalRankSet(rs.domain);
+    // The global iterate is at the end of the time step, which can not be split
+    numSub  = 1;
+    iSub    = 0;
+    subDone = OCP_FALSE;
+    subFail = OCP_FALSE;
+    CalRes(rs, ctrl.time.GetCurrentDt());
+    NR.InitStep(rs.bulk.GetVarSet());
+}
+
+
 void IsoT_FIMddm::FinishStep(Reservoir& rs, OCPControl& ctrl)
 {
     rs.CalIPRT(ctrl.time.GetCurrentDt());
@@ -2482,8 +3183,15 @@ void IsoT_FIMddm::ResetBoundary(Reservoir& rs)
 /// Reset variables to last time step
 void IsoT_FIMddm::ResetToLastTimeStep(Reservoir& rs, OCPControl& ctrl)
 {
+    if (iSub > 0) {
+        copy(lNiStep.begin(), lNiStep.end(), &rs.bulk.vs.lNi[0]);
+    }
     IsoT_FIM::ResetToLastTimeStep(rs, ctrl);
     rs.conn.vs.flux_ni = rs.conn.vs.lflux_ni;
+    iSub     = 0;
+    iterSub0 = 0;
+    subDone  = OCP_FALSE;
+    subFail  = OCP_FALSE;
 }
 
 
@@ -2495,6 +3203,27 @@ void IsoT_FIMddm::UpdateLastTimeStep(Reservoir& rs) const
 }
 
 
+void IsoT_FIMddm::SetNumSub(const Bulk& bk, const ControlTime& ctrlTime)
+{
+    if (!IfSubStep()) return;
+
+    // max change of saturations in the subdomain over the last time step
+    const BulkVarSet& bvs   = bk.vs;
+    OCP_DBL           dSmax = 0;
+    for (OCP_USI n = 0; n < bvs.nbI * bvs.np; n++) {
+        dSmax = max(dSmax, fabs(bvs.S[n] - bvs.lS[n]));
+    }
+
+    // sub-steps which keep the change in each sub-step below the limit
+    const OCP_DBL ns = dSmax * ctrlTime.GetCurrentDt() / (ctrlTime.GetLastDt() * ctrlTime.GetDSlim());
+    USI           n  = 1;
+    while (n < ns && n < maxSub) n *= 2;
+    // sub-steps are coarsened gradually
+    numSub = max(n, static_cast<USI>(numSub / 2));
+    numSub = min(max(numSub, static_cast<USI>(1)), maxSub);
+}
+
+
 void IsoT_FIMddm::SetStarBulkSet(const Bulk& bulk, const Domain& domain, const ControlTime& ctrlTime)
 {
     SetStarBulkSet01(bulk, domain, ctrlTime);
@@ -2585,6 +3314,8 @@ void IsoT_FIMddm::CalRankSet(const Domain& domain)
 
 void IsoT_FIMddm::CalFlash(Bulk& bk, const set<OCP_INT>& rankSet, const Domain& domain)
 {
+    OCP_PROFILE("Flash");
+    OCP_HWCOUNT(flash);
     const BulkVarSet& bvs = bk.vs;
     OCP_USI bId, eId;
 
@@ -2670,11 +3401,13 @@ void IsoT_FIMddm::CalRock(Bulk& bk, const set<OCP_INT>& rankSet, const Domain& d
 /// Calculate residual
 void IsoT_FIMddm::CalRes(Reservoir& rs, const OCP_DBL& dt, const OCP_BOOL& initRes0)
 {
+    OCP_PROFILE("Residual");
+    OCP_HWCOUNT(flux);
     if (boundCondition == constP) {
-        CalResConstP(rs, dt, initRes0);
+        CalResConstP(rs, SubDt(dt), initRes0);
     }
     else if (boundCondition == constV) {
-        CalResConstV(rs, dt, initRes0);
+        CalResConstV(rs, SubDt(dt), initRes0);
     }
     else {
         OCP_ABORT("Not Used!");
@@ -2892,6 +3625,8 @@ void IsoT_FIMddm::CalResConstV(Reservoir& rs, const OCP_DBL& dt, const OCP_BOOL&
 /// Assemble linear system for bulks
 void IsoT_FIMddm::AssembleMatBulks(LinearSystem& ls, const Reservoir& rs, const OCP_DBL& dt) const
 {
+    OCP_PROFILE("AssembleBulk");
+    OCP_HWCOUNT(assembleBulk);
     if (boundCondition == constP) {
         AssembleMatBulksConstP(ls ,rs, dt);
     }
@@ -3076,6 +3811,7 @@ void IsoT_FIMddm::AssembleMatBulksConstV(LinearSystem& ls, const Reservoir& rs,
 /// Only get local solution
 void IsoT_FIMddm::GetSolution(Reservoir& rs, vector<OCP_DBL>& u, const ControlNR& ctrlNR)
 {
+    OCP_PROFILE("GetSolution");
     const auto& domain = rs.domain;
     auto&       bk     = rs.bulk;
     auto&       bvs    = bk.vs;
@@ -3224,6 +3960,7 @@ void IsoT_FIMddm::UpdatePropertyBoundary(Reservoir& rs)
 
 void IsoT_FIMddm::ExchangePBoundary(Reservoir& rs) const
 {
+    OCP_PROFILE("Halo");
     // Exchange Ghost P
     const Domain& domain = rs.domain;
     BulkVarSet&   bvs    = rs.bulk.vs;
@@ -3261,6 +3998,7 @@ void IsoT_FIMddm::ExchangePBoundary(Reservoir& rs) const
 
 void IsoT_FIMddm::ExchangeNiBoundary(Reservoir& rs) const
 {
+    OCP_PROFILE("Halo");
     // Exchange Ghost Ni
     const Domain& domain = rs.domain;
     BulkVarSet&   bvs = rs.bulk.vs;
@@ -3314,6 +4052,418 @@ OCP_BOOL IsoT_FIMddm::IfBulkInLS(const USI& bId, const Domain& domain) const
 }
 
 
+////////////////////////////////////////////
+// IsoT_SFI
+////////////////////////////////////////////
+
+void IsoT_SFI::Setup(Reservoir& rs, const OCPControl& ctrl)
+{
+    // Trial iterates of line search can not be split into two stages
+    if (ctrl.NR.GetGlobal() == OCPNRGlobal::lineSearch) {
+        OCP_ABORT("Line search is not available for SFI, use nrGlobal=tr or off!");
+    }
+    ifSwitch = ctrl.SM.GetSFISwitch();
+    IsoT_FIM::Setup(rs, ctrl);
+}
+
+
+void IsoT_SFI::SetWorkLS(const USI& wp, const USI& wt, const USI& wf, const USI& i)
+{
+    IsothermalMethod::SetWorkLS(wp, i);
+    wlsT = wt;
+    wlsF = wf;
+}
+
+
+void IsoT_SFI::Prepare(Reservoir& rs, const OCPControl& ctrl)
+{
+    IsoT_FIM::Prepare(rs, ctrl);
+    // Each time step starts with SFI, small changes of one stage do not mean
+    // the coupled system converges
+    ifFIM   = OCP_FALSE;
+    ifConvD = OCP_FALSE;
+    convFac = tolFac;
+}
+
+
+void IsoT_SFI::AssembleMat(LinearSystem& ls, const Reservoir& rs, const OCP_DBL& dt) const
+{
+    if (ifFIM) {
+        ls.SetWorkLS(wlsF);
+        IsoT_FIM::AssembleMat(ls, rs, dt);
+        return;
+    }
+    // Jacobian of FIM is reduced to the pressure system
+    ls.SetAssembleDim(rs.GetComNum() + 1);
+    IsoT_FIM::AssembleMat(ls, rs, dt);
+    ls.ReduceToFirst(wls, rs.GetBulk().GetVarSet().nbI);
+}
+
+
+OCP_BOOL IsoT_SFI::SolveLinearSystem(LinearSystem& ls, Reservoir& rs, OCPControl& ctrl)
+{
+    if (ifFIM) {
+        return IsoT_FIM::SolveLinearSystem(ls, rs, ctrl);
+    }
+
+    const OCP_DBL dt = ctrl.time.GetCurrentDt();
+
+    // Pressure stage, the system is assembled in AssembleMat
+    OCP_INT status = SolveStage(ls, rs, ctrl.NR, OCP_TRUE);
+    USI     lsIter = abs(status);
+
+    if (status >= 0) {
+        if (!NR.CheckPhysical(rs, { "BulkNi", "BulkP" }, dt)) {
+            NR.UpdateIter(lsIter);
+            ctrl.time.CutDt(NR);
+            ResetToLastTimeStep(rs, ctrl);
+            return OCP_FALSE;
+        }
+
+        GetWallTime timer;
+        timer.Start();
+        IsoT_FIM::UpdateProperty(rs, ctrl);
+        OCPTIME_UPDATE_GRID += timer.Stop();
+
+        // Transport stage, P, BHP and total volume flow rates are fixed
+        if (!SolveTransport(ls, rs, ctrl, status, lsIter)) {
+            NR.UpdateIter(lsIter);
+            ctrl.time.CutDt(NR);
+            ResetToLastTimeStep(rs, ctrl);
+            return OCP_FALSE;
+        }
+    }
+
+    // Two stages make one outer iteration
+    NR.UpdateIter(lsIter);
+
+    if (status < 0) {
+        ctrl.time.CutDt(-1.0);
+        ResetToLastTimeStep(rs, ctrl);
+        return OCP_FALSE;
+    }
+    return OCP_TRUE;
+}
+
+
+OCP_BOOL IsoT_SFI::UpdateProperty(Reservoir& rs, OCPControl& ctrl)
+{
+    if (ifFIM) {
+        return IsoT_FIM::UpdateProperty(rs, ctrl);
+    }
+    // Properties have been updated in the transport, outer iterations
+    // converge with the residual of FIM, where flow rates of wells are not fixed
+    rs.allWells.CalFlux(rs.bulk);
+    CalRes(rs, ctrl.time.GetCurrentDt());
+    return OCP_TRUE;
+}
+
+
+OCP_BOOL IsoT_SFI::FinishNR(Reservoir& rs, OCPControl& ctrl)
+{
+    const OCP_BOOL conv = IsoT_FIM::FinishNR(rs, ctrl);
+
+    // Iterations are reset if the time step is cut
+    const USI iter = NR.GetIterNR();
+    if (ifFIM || iter == 0) {
+        return conv;
+    }
+
+    // Outer iterations converge linearly, rates are the same over processes since
+    // the residual is the global one
+    const OCP_DBL rate = iter > 1 ? resNR / lastRes : 0;
+    maxRate = iter > 1 ? max(maxRate, rate) : 0;
+    lastRes = resNR;
+
+    if (conv) {
+        // Splitting error grows with the time step, the next one is limited to
+        // keep the rate of outer iterations
+        if (maxRate > rateT) {
+            nextDt = min(nextDt, ctrl.time.GetCurrentDt() * rateT / maxRate);
+        }
+        return OCP_TRUE;
+    }
+    if (iter == 1) {
+        return OCP_FALSE;
+    }
+
+    // Outer iterations fail if the residual grows or the tolerance can not be
+    // reached within the max num of iterations at current rate
+    const OCP_DBL tol  = ctrl.NR.Tol() * convFac;
+    OCP_BOOL      fail = rate >= 1;
+    if (!fail && resNR > tol) {
+        fail = iter + log(tol / resNR) / log(rate) > ctrl.NR.MaxIter();
+    }
+
+    if (fail) {
+        if (ifSwitch && ctrl.time.GetCurrentDt() <= ctrl.time.GetMinTime() * (1 + TINY)) {
+            // The time step is restarted by FIM from the last converged state
+            if (CURRENT_RANK == MASTER_PROCESS) {
+                cout << "### WARNING: SFI fails at min time step, switch to FIM!\n";
+            }
+            ifFIM   = OCP_TRUE;
+            ifConvD = OCP_TRUE;
+            convFac = 1.0;
+            OCPITER_SFI_FIM++;
+        }
+        else {
+            ctrl.time.CutDt();
+        }
+        ResetToLastTimeStep(rs, ctrl);
+    }
+    return OCP_FALSE;
+}
+
+
+OCP_INT IsoT_SFI::SolveStage(LinearSystem&    ls,
+                             Reservoir&       rs,
+                             const ControlNR& ctrlNR,
+                             const OCP_BOOL&  ifP)
+{
+    GetWallTime timer;
+    timer.Start();
+    ls.AssembleMatLinearSolver();
+    OCPTIME_CONVERT_MAT_FOR_LS_IF += timer.Stop();
+
+    timer.Start();
+    const OCP_INT status = ls.Solve();
+    OCPTIME_LSOLVER += timer.Stop();
+
+    if (status >= 0) {
+        timer.Start();
+        const BulkVarSet&      bvs = rs.GetBulk().GetVarSet();
+        const OCP_USI          nbI = bvs.nbI;
+        const USI              nc  = bvs.nc;
+        const USI              col = nc + 1;
+        const USI              nw  = rs.GetNumOpenWell();
+        const vector<OCP_DBL>& u   = ls.GetSolution();
+
+        // Solution in the layout of FIM, variables of the other stage are unchanged
+        uFIM.assign((bvs.nb + nw) * col, 0.0);
+        if (ifP) {
+            for (OCP_USI n = 0; n < nbI + nw; n++) uFIM[n * col] = u[n];
+        }
+        else {
+            // Local chop keeps the moles positive, the direction of the change
+            // of each bulk is unchanged
+            for (OCP_USI n = 0; n < nbI; n++) {
+                OCP_DBL chop = 1;
+                for (USI i = 0; i < nc; i++) {
+                    const OCP_DBL Ni = bvs.Ni[n * nc + i];
+                    if (Ni + u[n * nc + i] < 0.0) chop = min(chop, 0.9 * Ni / fabs(u[n * nc + i]));
+                }
+                for (USI i = 0; i < nc; i++) uFIM[n * col + 1 + i] = chop * u[n * nc + i];
+            }
+        }
+        GetSolution(rs, uFIM, ctrlNR);
+        OCPTIME_NRSTEP += timer.Stop();
+    }
+    ls.ClearData();
+
+    return status;
+}
+
+
+OCP_BOOL IsoT_SFI::SolveTransport(LinearSystem& ls, Reservoir& rs, OCPControl& ctrl,
+                                  OCP_INT& status, USI& lsIter)
+{
+    const OCP_DBL     dt   = ctrl.time.GetCurrentDt();
+    const BulkConn&   conn = rs.conn;
+    const BulkVarSet& bvs  = rs.bulk.vs;
+    const USI         np   = bvs.np;
+
+    // Total volume flow rates of the pressure stage are fixed, with which the
+    // residual of transport is the one of FIM now
+    vT.assign(conn.numConn, 0.0);
+    for (OCP_USI c = 0; c < conn.numConn; c++) {
+        for (USI j = 0; j < np; j++) {
+            vT[c] += conn.vs.flux_vj[c * np + j];
+        }
+    }
+    OCP_DBL      resT0 = -1;
+    OCP_DBL      resT  = CalMaxRelResTransport(rs);
+    OCPNRreduce& red   = NR.GetReduce();
+    GetWallTime  timer;
+
+    for (USI k = 0; k < maxIterT; k++) {
+        timer.Start();
+        ls.SetAssembleDim(rs.GetComNum() + 1);
+        AssembleMatTransport(ls, rs, dt);
+        ls.ReduceToOthers(wlsT, bvs.nbI, rs.GetNumOpenWell());
+        rs.domain.SetNumActWellLocal(0);
+        OCPTIME_ASSEMBLE_MAT += timer.Stop();
+
+        status  = SolveStage(ls, rs, ctrl.NR, OCP_FALSE);
+        lsIter += abs(status);
+        if (status < 0) return OCP_TRUE;
+
+        timer.Start();
+        const OCP_DBL resTloc = resT;
+        resT = 0;
+        if (NR.CheckPhysicalLoc(rs, { "BulkNi" }, dt)) {
+            CalFlash(rs.bulk);
+            CalKrPc(rs.bulk);
+            CalRock(rs.bulk);
+            for (auto& wl : rs.allWells.wells) wl->CalFluxSFI(rs.bulk);
+            CalResTransport(rs, dt);
+            resT = CalMaxRelResTransport(rs);
+        }
+        OCPTIME_UPDATE_GRID += timer.Stop();
+
+        // Physical check, residual of transport and the initial one in one reduction
+        red.Clear();
+        const USI iS  = NR.PackWorkState(red);
+        const USI iR  = red.PackMax(resT);
+        const USI iR0 = k == 0 ? red.PackMax(resTloc) : 0;
+        red.Reduce();
+
+        if (!NR.UnpackWorkState(red, iS)) return OCP_FALSE;
+        if (k == 0) resT0 = red.GetMax(iR0);
+        if (red.GetMax(iR) <= redT * max(resT0, ctrl.NR.Tol())) break;
+    }
+    return OCP_TRUE;
+}
+
+
+void IsoT_SFI::AssembleMatTransport(LinearSystem& ls, const Reservoir& rs, const OCP_DBL& dt) const
+{
+    const Bulk&       bk      = rs.bulk;
+    const BulkVarSet& bvs     = bk.vs;
+    const BulkConn&   conn    = rs.conn;
+
+    const OCP_USI     nbI     = bvs.nbI;
+    const USI         np      = bvs.np;
+    const USI         nc      = bvs.nc;
+    const USI         ncol    = nc + 1;
+    const USI         ncol2   = np * nc + np;
+    const USI         bsize   = ncol * ncol;
+    const USI         bsize2  = ncol * ncol2;
+    const USI         numWell = rs.GetNumOpenWell();
+
+    ls.AddDim(nbI);
+
+    // Accumulation term
+    vector<OCP_DBL> bmat(bsize, 0);
+    for (OCP_USI n = 0; n < nbI; n++) {
+        ls.NewDiag(n, bk.ACCm.GetAccumuTerm()->CaldFdXpFIM(n, bvs, dt));
+    }
+
+    // flux term with total volume flow rates fixed
+    OCP_USI  bId, eId;
+    for (OCP_USI c = 0; c < conn.numConn; c++) {
+
+        bId       = conn.iteratorConn[c].BId();
+        eId       = conn.iteratorConn[c].EId();
+        auto Flux = conn.FLUXm.GetFlux(c);
+
+        Flux->AssembleMatSFI(conn.iteratorConn[c], c, conn.vs, bk);
+
+        bmat = Flux->GetdFdXpB();
+        DaABpbC(ncol, ncol, ncol2, dt, Flux->GetdFdXsB().data(), &bvs.dSec_dPri[bId * bsize2], dt,
+            bmat.data());
+
+        // Begin - Begin -- add
+        ls.AddDiag(bId, bmat);
+        // End - Begin -- insert
+        if (eId < nbI) {
+            Dscalar(bsize, -1, bmat.data());
+            ls.NewOffDiag(eId, bId, bmat);
+        }
+
+        bmat = Flux->GetdFdXpE();
+        DaABpbC(ncol, ncol, ncol2, dt, Flux->GetdFdXsE().data(), &bvs.dSec_dPri[eId * bsize2], dt,
+            bmat.data());
+
+        if (eId < nbI) {
+            // Begin - End -- insert
+            ls.NewOffDiag(bId, eId, bmat);
+            // End - End -- add
+            Dscalar(bsize, -1, bmat.data());
+            ls.AddDiag(eId, bmat);
+        }
+        else {
+            // ghost grid
+            ls.NewOffDiag(bId, eId + numWell, bmat);
+        }
+    }
+
+    // Wells with fixed total volume flow rates contribute to the diagonal of bulks
+    for (auto& wl : rs.allWells.wells) wl->AssembleMatSFI(ls, bk, dt);
+    ls.CopyRhs(NR.res.resAbs);
+}
+
+
+void IsoT_SFI::CalResTransport(Reservoir& rs, const OCP_DBL& dt)
+{
+    const Bulk&       bk  = rs.bulk;
+    const BulkVarSet& bvs = bk.vs;
+
+    const USI nb  = bvs.nbI;
+    const USI np  = bvs.np;
+    const USI nc  = bvs.nc;
+    const USI len = nc + 1;
+
+    OCPNRresidual& res = NR.res;
+
+    res.SetZero();
+
+    // Accumalation Term
+    for (OCP_USI n = 0; n < nb; n++) {
+        const vector<OCP_DBL>& r = bk.ACCm.GetAccumuTerm()->CalResFIM(n, bvs, dt);
+        copy(r.begin(), r.end(), &res.resAbs[n * len]);
+    }
+
+    // Flux Term with total volume flow rates fixed
+    OCP_USI         bId, eId;
+    BulkConn&       conn = rs.conn;
+    BulkConnVarSet& bcvs = conn.vs;
+    for (OCP_USI c = 0; c < conn.numConn; c++) {
+
+        bId       = conn.iteratorConn[c].BId();
+        eId       = conn.iteratorConn[c].EId();
+        auto Flux = conn.FLUXm.GetFlux(c);
+
+        Flux->CalFluxSFI(conn.iteratorConn[c], bk, vT[c]);
+        copy(Flux->GetConvectUpblock().begin(), Flux->GetConvectUpblock().end(), &bcvs.upblock[c * np]);
+        copy(Flux->GetConvectDP().begin(), Flux->GetConvectDP().end(), &bcvs.dP[c * np]);
+        copy(Flux->GetConvectVj().begin(), Flux->GetConvectVj().end(), &bcvs.flux_vj[c * np]);
+        copy(Flux->GetFluxNi().begin(), Flux->GetFluxNi().end(), &bcvs.flux_ni[c * nc]);
+
+        for (USI i = 0; i < nc; i++) {
+            res.resAbs[bId * len + 1 + i] += dt * Flux->GetFluxNi()[i];
+        }
+        if (eId < nb) {
+            for (USI i = 0; i < nc; i++) {
+                res.resAbs[eId * len + 1 + i] -= dt * Flux->GetFluxNi()[i];
+            }
+        }
+    }
+
+    // Well to Bulk, Well
+    USI wId = nb * len;
+    for (const auto& wl : rs.allWells.wells) {
+        wl->CalResFIM(wId, res, bk, dt);
+    }
+
+    Dscalar(res.resAbs.size(), -1.0, res.resAbs.data());
+}
+
+
+OCP_DBL IsoT_SFI::CalMaxRelResTransport(const Reservoir& rs) const
+{
+    const BulkVarSet& bvs = rs.bulk.vs;
+    const USI         len = bvs.nc + 1;
+
+    OCP_DBL resT = 0;
+    for (OCP_USI n = 0; n < bvs.nbI; n++) {
+        for (USI i = 1; i < len; i++) {
+            resT = max(resT, fabs(NR.res.resAbs[n * len + i] / bvs.rockVp[n]));
+        }
+    }
+    return resT;
+}
+
+
 
 /*----------------------------------------------------------------------------*/
 /*  Brief Change History of This File                                         */
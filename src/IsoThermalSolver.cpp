@@ -34,6 +34,12 @@ void IsothermalSolver::SetupMethod(Reservoir& rs, const OCPControl& ctrl)
             fim_ddm.Setup(rs, ctrl);
             fim_ddm.SetWorkLS(LSolver.Setup(ctrl.SM.GetModel(), ctrl.SM.GetWorkDir(), ctrl.SM.GetLsFile(i), rs.GetDomain(), rs.GetComNum() + 1), i);
             break;
+        case OCPNLMethod::SFI:
+            sfi.Setup(rs, ctrl);
+            sfi.SetWorkLS(LSolver.Setup(ctrl.SM.GetModel(), ctrl.SM.GetWorkDir(), ctrl.SM.GetLsFile(i), rs.GetDomain(), 1),
+                          LSolver.Setup(ctrl.SM.GetModel(), ctrl.SM.GetWorkDir(), ctrl.SM.GetLsFileT(), rs.GetDomain(), rs.GetComNum()),
+                          LSolver.Setup(ctrl.SM.GetModel(), ctrl.SM.GetWorkDir(), ctrl.SM.GetLsFileT(), rs.GetDomain(), rs.GetComNum() + 1), i);
+            break;
         default:
             OCP_ABORT("Wrong method type!");
         }
@@ -42,6 +48,7 @@ void IsothermalSolver::SetupMethod(Reservoir& rs, const OCPControl& ctrl)
     mainMethod = methods[0];
     preMethod  = ctrl.SM.InitMethod();
     curMethod  = preMethod;
+    ddmCycle   = ctrl.SM.GetDDMCycle();
 }
 
 
@@ -61,6 +68,9 @@ void IsothermalSolver::InitReservoir(Reservoir& rs)
         case OCPNLMethod::FIMddm:
             fim_ddm.InitReservoir(rs);
             break;
+        case OCPNLMethod::SFI:
+            sfi.InitReservoir(rs);
+            break;
         default:
             OCP_ABORT("Wrong method type!");
     }
@@ -74,6 +84,7 @@ const OCPNRsuite& IsothermalSolver::GoOneStep(Reservoir& rs, OCPControl& ctrl)
 
     // Time marching with adaptive time stepsize
     while (OCP_TRUE) {
+        OCP_PROFILE("Newton");
         if (ctrl.time.GetCurrentDt() < MIN_TIME_CURSTEP) {
             if (CURRENT_RANK == MASTER_PROCESS)
                 OCP_WARNING("Time stepsize is too small: " + to_string(ctrl.time.GetCurrentDt()) + TIMEUNIT);
@@ -102,6 +113,7 @@ const OCPNRsuite& IsothermalSolver::GoOneStep(Reservoir& rs, OCPControl& ctrl)
 /// Prepare solution methods, including IMPEC and FIM.
 void IsothermalSolver::Prepare(Reservoir& rs, OCPControl& ctrl)
 {
+    OCP_PROFILE("Prepare");
     //if (ctrl.time.GetCurrentTime() > 10 - 1E-8) {
     //    curMethod = preMethod;
     //}
@@ -116,13 +128,20 @@ void IsothermalSolver::Prepare(Reservoir& rs, OCPControl& ctrl)
 		impec.Prepare(rs, ctrl);
 		break;
 	case OCPNLMethod::FIM:
-		fim.Prepare(rs, ctrl.time.GetCurrentDt());
+		fim.Prepare(rs, ctrl);
 		break;
 	case OCPNLMethod::AIMc:
 		aimc.Prepare(rs, ctrl.time.GetCurrentDt());
 		break;
 	case OCPNLMethod::FIMddm:
 		fim_ddm.Prepare(rs, ctrl.time.GetCurrentDt());
+		if (mainMethod == OCPNLMethod::FIM && ddmCycle > 0) {
+			fim.NR.InitIter();
+			ddmNumCut = ctrl.time.GetNumCut();
+		}
+		break;
+	case OCPNLMethod::SFI:
+		sfi.Prepare(rs, ctrl);
 		break;
 	default:
 		OCP_ABORT("Wrong method type!");
@@ -133,6 +152,7 @@ void IsothermalSolver::Prepare(Reservoir& rs, OCPControl& ctrl)
 /// Assemble linear systems for IMPEC and FIM.
 void IsothermalSolver::AssembleMat(const Reservoir& rs, OCPControl& ctrl)
 {
+    OCP_PROFILE("Assemble");
     // Assemble
     const OCP_DBL dt = ctrl.time.GetCurrentDt();
     GetWallTime timer;
@@ -155,6 +175,10 @@ void IsothermalSolver::AssembleMat(const Reservoir& rs, OCPControl& ctrl)
             LSolver.SetWorkLS(fim_ddm.GetWorkLS());
             fim_ddm.AssembleMat(LSolver, rs, dt);
             break;
+        case OCPNLMethod::SFI:
+            LSolver.SetWorkLS(sfi.GetWorkLS());
+            sfi.AssembleMat(LSolver, rs, dt);
+            break;
         default:
             OCP_ABORT("Wrong method type!");
     }
@@ -166,6 +190,7 @@ void IsothermalSolver::AssembleMat(const Reservoir& rs, OCPControl& ctrl)
 /// Solve linear systems for IMPEC and FIM.
 OCP_BOOL IsothermalSolver::SolveLinearSystem(Reservoir& rs, OCPControl& ctrl)
 { 
+    OCP_PROFILE("LinearSolver");
     switch (curMethod) {
         case OCPNLMethod::IMPEC:
             return impec.SolveLinearSystem(LSolver, rs, ctrl);
@@ -179,6 +204,9 @@ OCP_BOOL IsothermalSolver::SolveLinearSystem(Reservoir& rs, OCPControl& ctrl)
         case OCPNLMethod::FIMddm:
             return fim_ddm.SolveLinearSystem(LSolver, rs, ctrl);
             break;
+        case OCPNLMethod::SFI:
+            return sfi.SolveLinearSystem(LSolver, rs, ctrl);
+            break;
         default:
             OCP_ABORT("Wrong method type!");
     }
@@ -188,6 +216,7 @@ OCP_BOOL IsothermalSolver::SolveLinearSystem(Reservoir& rs, OCPControl& ctrl)
 /// Update physical properties for IMPEC and FIM.
 OCP_BOOL IsothermalSolver::UpdateProperty(Reservoir& rs, OCPControl& ctrl)
 {
+    OCP_PROFILE("UpdateProperty");
     OCP_BOOL flag;
 
     GetWallTime timer;
@@ -206,6 +235,9 @@ OCP_BOOL IsothermalSolver::UpdateProperty(Reservoir& rs, OCPControl& ctrl)
         case OCPNLMethod::FIMddm:
             flag = fim_ddm.UpdateProperty(rs, ctrl);
             break;
+        case OCPNLMethod::SFI:
+            flag = sfi.UpdateProperty(rs, ctrl);
+            break;
         default:
             OCP_ABORT("Wrong method type!");
     }
@@ -219,6 +251,7 @@ OCP_BOOL IsothermalSolver::UpdateProperty(Reservoir& rs, OCPControl& ctrl)
 /// Finish up Newton-Raphson iteration for IMPEC and FIM.
 OCP_BOOL IsothermalSolver::FinishNR(Reservoir& rs, OCPControl& ctrl)
 {
+    OCP_PROFILE("FinishNR");
     OCP_BOOL conFlag = OCP_FALSE;
 
     switch (curMethod) {
@@ -234,6 +267,9 @@ OCP_BOOL IsothermalSolver::FinishNR(Reservoir& rs, OCPControl& ctrl)
         case OCPNLMethod::FIMddm:
             conFlag = fim_ddm.FinishNR(rs, ctrl);
             break;
+        case OCPNLMethod::SFI:
+            conFlag = sfi.FinishNR(rs, ctrl);
+            break;
         default:
             OCP_ABORT("Wrong method type!");
     }
@@ -246,7 +282,14 @@ OCP_BOOL IsothermalSolver::FinishNR(Reservoir& rs, OCPControl& ctrl)
         if (curMethod == OCPNLMethod::FIM) {
             if (CURRENT_RANK == 0)
                 cout << "FIMddm iters = " << fim_ddm.NR.GetIterNR() << "  " << endl;
-            if (fim.TransferToFIM(fim_ddm.global_res0, rs, ctrl) == OCP_TRUE) {
+            if (ddmCycle > 0 && ctrl.time.GetNumCut() != ddmNumCut) {
+                // time step has been cut in subdomain solves, global Newton iterations before are wasted
+                fim.NR.ResetIter();
+                ddmNumCut = ctrl.time.GetNumCut();
+            }
+            // with ddmCycle, global Newton iterations are counted from the beginning of the time step
+            if (fim.TransferToFIM(fim_ddm.global_res0, rs, ctrl, ddmCycle == 0) == OCP_TRUE) {
+                ddmNextIter = fim.NR.GetIterNR() + ddmCycle;
                 return OCP_FALSE;
             }
             else {
@@ -255,6 +298,14 @@ OCP_BOOL IsothermalSolver::FinishNR(Reservoir& rs, OCPControl& ctrl)
         }
         return OCP_TRUE;
     }
+    else if (curMethod == OCPNLMethod::FIM && preMethod == OCPNLMethod::FIMddm && ddmCycle > 0 &&
+             ctrl.time.GetNumCut() == ddmNumCut && fim.NR.GetIterNR() >= ddmNextIter) {
+        // Global Newton iterations alternate with subdomain solves, which restart from the
+        // current global iterate, not done once time step is cut in global Newton iterations
+        curMethod = preMethod;
+        fim_ddm.TransferToFIMddm(rs, ctrl);
+        return OCP_FALSE;
+    }
     else {
         return OCP_FALSE;
     }
@@ -264,6 +315,7 @@ OCP_BOOL IsothermalSolver::FinishNR(Reservoir& rs, OCPControl& ctrl)
 /// Finish up time step for IMPEC and FIM.
 void IsothermalSolver::FinishStep(Reservoir& rs, OCPControl& ctrl)
 {
+    OCP_PROFILE("FinishStep");
     if (ctrl.SM.GetMethod().size() == 1) {
         switch (curMethod) {
         case OCPNLMethod::IMPEC:
@@ -278,6 +330,9 @@ void IsothermalSolver::FinishStep(Reservoir& rs, OCPControl& ctrl)
         case OCPNLMethod::FIMddm:
             fim_ddm.FinishStep(rs, ctrl);
             break;
+        case OCPNLMethod::SFI:
+            sfi.FinishStep(rs, ctrl);
+            break;
         default:
             OCP_ABORT("Wrong method type!");
         }
@@ -296,6 +351,7 @@ void IsothermalSolver::FinishStepComb(Reservoir& rs, OCPControl& ctrl)
         ctrl.CalNextTimeStep(fim.NR, { "dP", "dS", "iter" });
 
         fim_ddm.SetStarBulkSet(rs.GetBulk(), rs.GetDomain(), ctrl.time);
+        fim_ddm.SetNumSub(rs.GetBulk(), ctrl.time);
 
         OCPITER_NR_DDM  += fim_ddm.NR.GetIterNR();
         OCPITER_NRW_DDM += fim_ddm.NR.GetIterNRw();
@@ -319,6 +375,9 @@ const OCPNRsuite& IsothermalSolver::GetNRsuite() const
     case OCPNLMethod::FIMddm:
         return fim_ddm.GetNRsuite();
         break;
+    case OCPNLMethod::SFI:
+        return sfi.GetNRsuite();
+        break;
     default:
         OCP_ABORT("Wrong method type!");
     }
@@ -83,6 +83,7 @@ void LinearSystem::SetupLinearSolver(const OCPModel& model,
 
 void LinearSystem::AssembleMatLinearSolver()
 { 
+    OCP_PROFILE("ConvertMatrix");
 #ifdef DEBUG
     mat.CheckLinearSystem();
 #endif
@@ -92,6 +93,8 @@ void LinearSystem::AssembleMatLinearSolver()
 
 OCP_INT LinearSystem::Solve()
 {
+    OCP_PROFILE("Solve");
+    OCP_HWCOUNT(linearSolve);
     OCP_INT iters = LS[wIndex]->Solve();
     if (iters < 0)
     {
@@ -29,6 +29,9 @@ MixtureUnit::MixtureUnit(const ParamReservoir& rs_param, const USI& i, BulkOptio
 	// Miscible Factor
 	misFac = &opts.misFac;
 	mfMethodIndex = misFac->Setup(rs_param, i, opts.nb, surTen);
+	// Flash cost
+	flashCost = &opts.flashCost;
+	flashCost->Setup(opts.nb);
 }
 
 
@@ -78,7 +81,9 @@ void MixtureUnit::InitFlashFIM(const OCP_USI& bId, const BulkVarSet& bvs) const
 
 void MixtureUnit::FlashIMPEC(const OCP_USI& bId, const BulkVarSet& bvs) const
 {
+	const OCP_ULL iters = mix->GetIters();
 	mix->Flash(bId, bvs);
+	flashCost->Add(bId, mix->GetIters() - iters, vs->phaseNum);
 	surTen->CalSurfaceTension(bId, stMethodIndex, *vs);
 	misFac->CalMiscibleFactor(bId, mfMethodIndex);
 }
@@ -86,7 +91,9 @@ void MixtureUnit::FlashIMPEC(const OCP_USI& bId, const BulkVarSet& bvs) const
 
 void MixtureUnit::FlashFIM(const OCP_USI& bId, const BulkVarSet& bvs) const
 {
+	const OCP_ULL iters = mix->GetIters();
 	mix->FlashDer(bId, bvs);
+	flashCost->Add(bId, mix->GetIters() - iters, vs->phaseNum);
 	surTen->CalSurfaceTension(bId, stMethodIndex, *vs);
 	misFac->CalMiscibleFactor(bId, mfMethodIndex);
 }
@@ -15,6 +15,7 @@
 void OpenCAEPoroX::SetupDistParam(const USI& argc, const char* argv[], PreProcess& prepro)
 {
 
+    OCP_PROFILE("SetupParam");
     GetWallTime timer;
     timer.Start();
 
@@ -37,6 +38,7 @@ void OpenCAEPoroX::SetupSolver()
         OCP_INFO("Setup Simulator -- begin");
     }
 
+    OCP_PROFILE("SetupSolver");
     GetWallTime timer;
     timer.Start();
 
@@ -68,6 +70,7 @@ void OpenCAEPoroX::InitReservoir()
         OCP_INFO("Initialize Resevoir -- begin");
     }
 
+    OCP_PROFILE("InitReservoir");
     GetWallTime timer;
     timer.Start();
 
@@ -87,6 +90,7 @@ void OpenCAEPoroX::InitReservoir()
 // Call IMPEC, FIM, AIM, etc for dynamic simulation.
 void OpenCAEPoroX::RunSimulation()
 {
+    OCP_PROFILE("RunSimulation");
     control.simTime.Initialize();
 
     GetWallTime timer;
@@ -103,6 +107,7 @@ void OpenCAEPoroX::RunSimulation()
 
         /// calculations between TSTEPS
         while (!control.time.IfEndTSTEP()) {
+            OCP_PROFILE("TimeStep");
             output.PrintCurrentTimeIter(control);
             const OCPNRsuite& NR = solver.GoOneStep(reservoir, control);
             output.SetValAtTimeStep(reservoir, control, NR, timer);
@@ -145,12 +150,17 @@ void OpenCAEPoroX::OutputResults() const
 {
     GetWallTime timer;
     timer.Start();
-    output.PostProcess();
+    {
+        OCP_PROFILE("PostProcess");
+        output.PostProcess();
+    }
     OCPTIME_TOTAL += timer.Stop();
       
     OutputTimeMain(cout.rdbuf());
     OutputTimeProcess();
     reservoir.OutInfoFinal();
+    OCP_PROFILER.Output(control.GetWorkDir(), CURRENT_RANK);
+    OCP_HWCOUNTER.Output(control.GetWorkDir(), reservoir.GetDomain().global_comm);
 }
 
 
@@ -177,6 +187,10 @@ void OpenCAEPoroX::OutputTimeMain(streambuf* mysb) const
             << static_cast<double>(output.iters.GetLSt()) / output.iters.GetNRt() << " ("
             << output.iters.GetLSt() << " succeeded + " << output.iters.GetLSwt()
             << " wasted)" << endl;
+        if (control.SM.GetMethod()[0] == OCPNLMethod::SFI) {
+            cout << " - SFI restarted by FIM ....." << setw(fixWidth) << OCPITER_SFI_FIM
+                 << " (steps)" << endl;
+        }
 
         // print time usages
         cout << "CPU time:                       " << setw(fixWidth) << OCPTIME_TOTAL
@@ -247,6 +261,7 @@ void OpenCAEPoroX::OutputTimeProcess() const
             OCPTIME_LSOLVER_DDM,
             static_cast<OCP_DBL>(OCPITER_NR_DDM),
             static_cast<OCP_DBL>(OCPITER_LS_DDM),
+            reservoir.GetBulk().GetFlashCost().GetLocalCost(reservoir.GetInteriorBulkNum()),
         };
         vector<OCP_DBL> record_total;
         const OCP_INT record_var_num = record_local.size();
@@ -286,6 +301,7 @@ void OpenCAEPoroX::OutputTimeProcess() const
                 statisticsVar("Linear Solver (DDM) (s)", len, 3),
                 statisticsVar("Iter NR (DDM)", len, 0),
                 statisticsVar("Iter LS (DDM)", len, 0),
+                statisticsVar("Flash Cost", len, 0),
             };
 
             OCP_ASSERT(record_var_num == staVar.size(), "wrong staVar");
@@ -66,7 +66,23 @@ void OCPControl::SetFastControl(const USI& argc, const char* optset[])
         time.SetFastControl(ctrlFast);
         SM.SetFastControl(ctrlFast);
     }
-    printLevel = ctrlFast.printLevel;
+    printLevel   = ctrlFast.printLevel;
+    vwgtOutFile  = ctrlFast.vwgtOutFile;
+    vtuOutput    = ctrlFast.vtuOutput;
+    vtkMergeProc = ctrlFast.vtkMergeProc;
+    asyncOutput  = ctrlFast.asyncOutput;
+    summaryBin   = ctrlFast.summaryBin;
+    perfLogFmt   = ctrlFast.perfLogFmt;
+    NR.SetGlobal(ctrlFast.nrGlobal);
+    time.SetDtCtrl(ctrlFast.dtCtrl);
+    NR.SetGuess(ctrlFast.nrGuess);
+    NR.SetActiveTol(ctrlFast.actTol);
+    time.SetSubCycle(ctrlFast.subCycle);
+    time.SetMultirate(ctrlFast.multirate);
+    SM.SetAIMParam(ctrlFast);
+    SM.SetDDMCycle(ctrlFast.ddmCycle);
+    SM.SetDDMSubStep(ctrlFast.ddmSubStep);
+    SM.SetSFISwitch(ctrlFast.sfiSwitch);
 }
 
 
@@ -27,12 +27,24 @@ void ControlMethod::SetCtrlParam(const ParamControl& CtrlParam)
         else if (m == "FIMddm") {
             method.push_back(OCPNLMethod::FIMddm);
         }
+        else if (m == "SFI") {
+            method.push_back(OCPNLMethod::SFI);
+        }
         else {
             OCP_ABORT("Wrong method specified!");
         }
     }
     workDir = CtrlParam.workDir;
     lsFile  = CtrlParam.lsFile;
+    lsFileT = CtrlParam.lsFileT;
+
+    aim.cflOn  = CtrlParam.aimCFL[0];
+    aim.cflOff = CtrlParam.aimCFL[1];
+    aim.ve     = CtrlParam.aimVe;
+    aim.nlayer = CtrlParam.aimLayer;
+
+    if (method.size() > 1 && (method[0] == OCPNLMethod::SFI || method[1] == OCPNLMethod::SFI))
+        OCP_ABORT("SFI can not be combined with other methods!");
 
     if (method.size() == 0)  OCP_ABORT("METHOD is not input correctly!");
 }
@@ -42,6 +54,7 @@ void ControlMethod::SetFastControl(const FastControl& fCtrl)
 {
     method.clear();
     lsFile.clear();
+    lsFileT.clear();
 
     method.push_back(fCtrl.method);
     switch (method[0]) {
@@ -52,6 +65,10 @@ void ControlMethod::SetFastControl(const FastControl& fCtrl)
     case OCPNLMethod::FIM:
         lsFile.push_back("./bsr.fasp");
         break;
+    case OCPNLMethod::SFI:
+        lsFile.push_back("./csr.fasp");
+        lsFileT = "./bsr.fasp";
+        break;
     default:
         OCP_ABORT("Wrong method specified from command line!");
         break;
@@ -59,6 +76,18 @@ void ControlMethod::SetFastControl(const FastControl& fCtrl)
 }
 
 
+void ControlMethod::SetAIMParam(const FastControl& fCtrl)
+{
+    // params set in command line override those in METHOD
+    if (fCtrl.aimCFLOn >= 0) {
+        aim.cflOn  = fCtrl.aimCFLOn;
+        aim.cflOff = fCtrl.aimCFLOff;
+    }
+    if (fCtrl.aimVe >= 0)     aim.ve     = fCtrl.aimVe;
+    if (fCtrl.aimLayer >= 0)  aim.nlayer = fCtrl.aimLayer;
+}
+
+
 OCPNLMethod ControlMethod::InitMethod() const
 {
     if (method.size() > 1) {
@@ -117,6 +146,9 @@ void ControlMethod::OutputInfo(const USI& pl) const
         case OCPNLMethod::FIMddm:
             cout << "FIMddm ";
             break;
+        case OCPNLMethod::SFI:
+            cout << "SFI ";
+            break;
         default:
             break;
         }
@@ -26,6 +26,24 @@ ControlNRParam::ControlNRParam(const vector<OCP_DBL>& src)
 
 OCPNRStateC ControlNR::CheckConverge(const OCPNRsuite& NRs, const initializer_list<string>& il, const OCP_DBL& tmpfac) const
 {
+    const OCPNRStateC conflag_loc = CheckConvergeLoc(NRs, il, tmpfac);
+
+    GetWallTime timer;
+    timer.Start();
+
+    OCPNRStateC conflag;
+    MPI_Allreduce(&conflag_loc, &conflag, 1, OCPMPI_ENUM, MPI_MAX, myComm);
+
+    OCPTIME_COMM_COLLECTIVE += timer.Stop();
+
+    return CheckConvergeGlobal(NRs, conflag);
+}
+
+
+OCPNRStateC ControlNR::CheckConvergeLoc(const OCPNRsuite& NRs, const initializer_list<string>& il, const OCP_DBL& tmpfac) const
+{
+    OCP_ASSERT(!NRs.IfRes0Pending(), "Initial residual is not reduced yet!");
+
     OCPNRStateC conflag_loc = OCPNRStateC::not_converge;
     for (auto& s : il) {
         if (s == "res") {
@@ -58,15 +76,12 @@ OCPNRStateC ControlNR::CheckConverge(const OCPNRsuite& NRs, const initializer_li
             OCP_ABORT("Iterm not recognized!");
         }
     }
+    return conflag_loc;
+}
 
-    GetWallTime timer;
-    timer.Start();
-
-    OCPNRStateC conflag;
-    MPI_Allreduce(&conflag_loc, &conflag, 1, OCPMPI_ENUM, MPI_MAX, myComm);
-
-    OCPTIME_COMM_COLLECTIVE += timer.Stop();
 
+OCPNRStateC ControlNR::CheckConvergeGlobal(const OCPNRsuite& NRs, const OCPNRStateC& conflag) const
+{
     if (conflag == OCPNRStateC::converge) {
         // converge
         return OCPNRStateC::converge;
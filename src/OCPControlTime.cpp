@@ -48,6 +48,8 @@ void ControlTime::CutDt(const OCP_DBL& fac)
     if (fac < 0) current_dt *= wp->cutFacNR;
     else         current_dt *= fac;
 
+    RecordCut(ldt);
+
     if (CURRENT_RANK == MASTER_PROCESS) {
         cout << "### WARNING: Cut time step size: " << scientific
             << setprecision(3) << ldt << TIMEUNIT + " -> "
@@ -77,6 +79,8 @@ void ControlTime::CutDt(const OCPNRsuite& NRs)
         OCP_ABORT("WRONG work state!");
     }
 
+    RecordCut(ldt);
+
     if (CURRENT_RANK == MASTER_PROCESS) {
         cout << "### WARNING: Cut time step size: " << scientific
             << setprecision(3) << ldt << TIMEUNIT + " -> "
@@ -118,6 +122,10 @@ void ControlTime::CalInitTimeStep4TSTEP(const OCP_BOOL& wellOptChange_loc)
     if (wellOptChange || firstflag) {
         current_dt = min(dt, wp->timeInit);
         firstflag = OCP_FALSE;
+        wellChangeTime = current_time;
+        // history of PID controller is not valid after well changes
+        err1 = 1;
+        err2 = 1;
     }
     else {
         current_dt = min(dt, predict_dt);
@@ -127,8 +135,30 @@ void ControlTime::CalInitTimeStep4TSTEP(const OCP_BOOL& wellOptChange_loc)
 
 void ControlTime::CalNextTimeStep(const OCPNRsuite& NRs, const initializer_list<string>& il)
 {
-    last_dt = current_dt;
-    current_time += current_dt;
+    const OCP_DBL dt_loc = CalNextTimeStepLoc(NRs, il);
+
+    GetWallTime timer;
+    timer.Start();
+
+    OCP_DBL dt;
+    MPI_Allreduce(&dt_loc, &dt, 1, OCPMPI_DBL, MPI_MIN, myComm);
+
+    OCPTIME_COMM_COLLECTIVE += timer.Stop();
+
+    SetNextTimeStep(dt);
+}
+
+
+OCP_DBL ControlTime::CalNextTimeStepLoc(const OCPNRsuite& NRs, const initializer_list<string>& il)
+{
+    if (dtCtrl == OCPDtCtrl::PID) {
+        OCP_DBL dt_loc = current_dt * CalFactorPID(NRs, il);
+        // growth beyond a recently failed time step is penalized
+        if (failDt > 0)               dt_loc = min(dt_loc, max(failFac * failDt, current_dt));
+        if (dt_loc > wp->timeMax)     dt_loc = wp->timeMax;
+        if (dt_loc < wp->timeMin)     dt_loc = wp->timeMin;
+        return dt_loc;
+    }
 
     OCP_DBL factor = wp->maxIncreFac;
 
@@ -155,6 +185,10 @@ void ControlTime::CalNextTimeStep(const OCPNRsuite& NRs, const initializer_list<
         else if (s == "eV") {
             if (eVmax > TINY) factor = min(factor, wp->eVlim / eVmax);
         }
+        else if (s == "CFL") {
+            // CFL of current time step, at most 1 in each transport sub-step
+            if (NRs.GetMaxCFL() > TINY) factor = min(factor, subCycle / NRs.GetMaxCFL());
+        }
         else if (s == "iter") {
             if (NRs.GetIterNR() < 5)
                 factor = min(factor, static_cast<OCP_DBL>(2.0));
@@ -174,14 +208,64 @@ void ControlTime::CalNextTimeStep(const OCPNRsuite& NRs, const initializer_list<
     if (dt_loc > wp->timeMax) dt_loc = wp->timeMax;
     if (dt_loc < wp->timeMin) dt_loc = wp->timeMin;
 
-    GetWallTime timer;
-    timer.Start();
+    return dt_loc;
+}
 
-    MPI_Allreduce(&dt_loc, &current_dt, 1, OCPMPI_DBL, MPI_MIN, myComm);
 
-    OCPTIME_COMM_COLLECTIVE += timer.Stop();
+OCP_DBL ControlTime::CalFactorPID(const OCPNRsuite& NRs, const initializer_list<string>& il)
+{
+    // Normalized error is the max ratio of changes to ideal changes, 1 is the target
+    OCP_DBL err = 0;
+    for (auto& s : il) {
+        if (s == "dP")        err = max(err, fabs(NRs.DPmaxT()) / wp->dPlim);
+        else if (s == "dT")   err = max(err, fabs(NRs.DTmaxT()) / wp->dTlim);
+        else if (s == "dN")   err = max(err, fabs(NRs.DNmaxT()) / wp->dNlim);
+        else if (s == "dS")   err = max(err, fabs(NRs.DSmaxT()) / wp->dSlim);
+        else if (s == "eV")   err = max(err, fabs(NRs.EVmaxT()) / wp->eVlim);
+        else if (s == "CFL")  err = max(err, NRs.GetMaxCFL() / subCycle);
+        else if (s == "iter") err = max(err, NRs.GetIterNR() / iterTarget);
+        else                  OCP_ABORT("Iterm not recognized!");
+    }
+    errC = max(err, 1 / wp->maxIncreFac);
+
+    OCP_DBL factor = pow(1 / errC, kI) * pow(err1 / errC, kP) *
+                     pow(err1 * err1 / (errC * err2), kD);
+
+    factor = min(factor, wp->maxIncreFac);
+    factor = max(factor, wp->minChopFac);
+    return factor;
+}
+
 
-    predict_dt = current_dt;
+void ControlTime::RecordCut(const OCP_DBL& dt)
+{
+    numCut++;
+    if (dtCtrl != OCPDtCtrl::PID) return;
+
+    failDt  = dt;
+    failFac = failFac0;
+    // history before the failure is not reliable
+    err1    = 1;
+    err2    = 1;
+}
+
+
+void ControlTime::SetNextTimeStep(const OCP_DBL& dt)
+{
+    if (dtCtrl == OCPDtCtrl::PID) {
+        err2 = err1;
+        err1 = errC;
+        if (failDt > 0) {
+            // relax the penalty after each successful time step
+            failFac *= failFacGrow;
+            if (failFac > wp->maxIncreFac) failDt = 0;
+        }
+    }
+
+    last_dt       = current_dt;
+    current_time += current_dt;
+    current_dt    = dt;
+    predict_dt    = current_dt;
 
     if (current_dt > (wp->end_time - current_time))
         current_dt = (wp->end_time - current_time);
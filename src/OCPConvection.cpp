@@ -480,6 +480,140 @@ void OCPConvection01::AssembleMatIMPEC(const BulkConnPair& bp, const OCP_USI& c,
 }
 
 
+void OCPConvection01::CalFluxSFI(const BulkConnPair& bp, const Bulk& bk, const OCP_DBL& vT, FluxVarSet& fvs)
+{
+    // Potential differences of all phases are shifted by s so that the sum of vj is vT,
+    // i.e. vj = lambda_j / lambdaT * (vT + sum_k lambda_k * (dP_j - dP_k))
+    CalFlux(bp, bk, fvs);
+
+    const BulkVarSet& bvs = bk.vs;
+
+    auto& flux_ni = fvs.flux_ni;
+
+    const OCP_DBL Akd = bp.Trans();
+    OCP_USI       uId_np_j;
+    OCP_DBL       lambdaT = 0;
+    OCP_DBL       vt      = 0;
+
+    for (USI j = 0; j < np; j++) {
+        uId_np_j = upblock[j] * np + j;
+        if (!bvs.phaseExist[uId_np_j]) continue;
+        lambdaT += Akd * bvs.kr[uId_np_j] / bvs.mu[uId_np_j];
+        vt      += vj[j];
+    }
+    if (lambdaT <= 0)  return;
+
+    const OCP_DBL s = (vT - vt) / lambdaT;
+    OCP_DBL       dv;
+    for (USI j = 0; j < np; j++) {
+        uId_np_j = upblock[j] * np + j;
+        if (!bvs.phaseExist[uId_np_j]) continue;
+
+        dv     = Akd * bvs.kr[uId_np_j] / bvs.mu[uId_np_j] * s;
+        dP[j] += s;
+        vj[j] += dv;
+        for (USI i = 0; i < nc; i++) {
+            flux_ni[i] += dv * bvs.xi[uId_np_j] * bvs.xij[uId_np_j * nc + i];
+        }
+    }
+}
+
+
+void OCPConvection01::AssembleMatSFI(const BulkConnPair& bp, const OCP_USI& c, const BulkConnVarSet& bcvs, const Bulk& bk, FluxVarSet& fvs)
+{
+    // With the shift s of potentials fixed, derivatives are those of FIM with the shifted dP.
+    // s depends on Xs to keep the total volume flow rate V fixed, which contributes
+    // -c_i * dV/dXs, where c_i = sum_j xi_j * x_ij * lambda_j / lambdaT. Derivatives
+    // with respect to P are not corrected since P is fixed in transport.
+    AssembleMatFIM(bp, c, bcvs, bk, fvs);
+
+    const USI& ncol2  = fvs.ncol2;
+    auto&      dFdXsB = fvs.dFdXsB;
+    auto&      dFdXsE = fvs.dFdXsE;
+    auto&      dVdXsB = fvs.dVdXsB;
+    auto&      dVdXsE = fvs.dVdXsE;
+
+    const BulkVarSet& bvs = bk.vs;
+
+    const OCP_USI bId    = bp.BId();
+    const OCP_USI eId    = bp.EId();
+    const OCP_DBL Akd    = bp.Trans();
+    const OCP_DBL dGamma = GRAVITY_FACTOR * (bvs.depth[bId] - bvs.depth[eId]);
+
+    OCP_USI  bId_np_j, eId_np_j, uId_np_j, dId_np_j;
+    OCP_DBL  rhoWghtU, rhoWghtD;
+    OCP_DBL  dP, transJ, mu, lambdaT;
+
+    OCP_DBL* dVdXsU;     // up    bulk: dV / dXs
+    OCP_DBL* dVdXsD;     // down  bulk: dV / dXs
+
+    fill(dVdXsB.begin(), dVdXsB.end(), 0.0);
+    fill(dVdXsE.begin(), dVdXsE.end(), 0.0);
+    lambdaT = 0;
+
+    for (USI j = 0; j < np; j++) {
+        uId_np_j = bcvs.upblock[c * np + j] * np + j;
+        if (!bvs.phaseExist[uId_np_j]) continue;
+        bId_np_j = bId * np + j;
+        eId_np_j = eId * np + j;
+
+        if (bId_np_j == uId_np_j) {
+            dId_np_j = eId_np_j;
+            dVdXsU   = &dVdXsB[0];
+            dVdXsD   = &dVdXsE[0];
+        }
+        else {
+            dId_np_j = bId_np_j;
+            dVdXsU   = &dVdXsE[0];
+            dVdXsD   = &dVdXsB[0];
+        }
+        if (bvs.phaseExist[dId_np_j]) {
+            rhoWghtU = 0.5;
+            rhoWghtD = 0.5;
+        }
+        else {
+            rhoWghtU = 1;
+            rhoWghtD = 0;
+        }
+
+        dP       = bcvs.dP[c * np + j];
+        mu       = bvs.mu[uId_np_j];
+        transJ   = Akd * bvs.kr[uId_np_j] / mu;
+        lambdaT += transJ;
+
+        // dS
+        for (USI k = 0; k < np; k++) {
+            dVdXsB[k] += transJ * bvs.dPcdS[bId_np_j * np + k];
+            dVdXsE[k] -= transJ * bvs.dPcdS[eId_np_j * np + k];
+            dVdXsU[k] += Akd * bvs.dKrdS[uId_np_j * np + k] / mu * dP;
+        }
+        // dxij
+        for (USI k = 0; k < nc; k++) {
+            dVdXsU[np + j * nc + k] += -transJ * rhoWghtU * bvs.rhox[uId_np_j * nc + k] * dGamma
+                                       - transJ * bvs.mux[uId_np_j * nc + k] / mu * dP;
+            dVdXsD[np + j * nc + k] += -transJ * rhoWghtD * bvs.rhox[dId_np_j * nc + k] * dGamma;
+        }
+    }
+    if (lambdaT <= 0)  return;
+
+    OCP_DBL ci;
+    for (USI i = 0; i < nc; i++) {
+        ci = 0;
+        for (USI j = 0; j < np; j++) {
+            uId_np_j = bcvs.upblock[c * np + j] * np + j;
+            if (!bvs.phaseExist[uId_np_j]) continue;
+            ci += Akd * bvs.kr[uId_np_j] / bvs.mu[uId_np_j] * bvs.xi[uId_np_j] * bvs.xij[uId_np_j * nc + i];
+        }
+        ci /= lambdaT;
+
+        for (USI k = 0; k < ncol2; k++) {
+            dFdXsB[(i + 1) * ncol2 + k] -= ci * dVdXsB[k];
+            dFdXsE[(i + 1) * ncol2 + k] -= ci * dVdXsE[k];
+        }
+    }
+}
+
+
 ////////////////////////////////////////////
 // OCPConvection02
 ////////////////////////////////////////////
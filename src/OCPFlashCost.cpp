@@ -0,0 +1,141 @@
+/*! \file    OCPFlashCost.cpp
+ *  \brief   OCPFlashCost class declaration
+ *  \author  Shizhe Li
+ *  \date    Oct/16/2026
+ *
+ *-----------------------------------------------------------------------------------
+ *  Copyright (C) 2021--present by the OpenCAEPoroX team. All rights reserved.
+ *  Released under the terms of the GNU Lesser General Public License 3.0 or later.
+ *-----------------------------------------------------------------------------------
+ */
+
+#include "OCPFlashCost.hpp"
+#include "Domain.hpp"
+
+#include <fstream>
+#include <cmath>
+#include <algorithm>
+
+
+/////////////////////////////////////////////////////////////////////
+// Flash Cost
+/////////////////////////////////////////////////////////////////////
+
+
+OCP_DBL FlashCost::GetLocalCost(const OCP_USI& nbI) const
+{
+    OCP_DBL tmp = 0;
+    for (OCP_USI n = 0; n < OCP_MIN(nbI, nb); n++) {
+        tmp += cost[n];
+    }
+    return tmp;
+}
+
+
+void FlashCost::PrintVertexWeight(const string& file, const Domain& domain) const
+{
+    const OCP_USI nbI     = domain.GetNumGridInterior();
+    const auto&   gIndex  = domain.GetGrid();
+    const OCP_INT numproc = domain.global_numproc;
+    const OCP_INT myrank  = domain.global_rank;
+
+    // (global index, cost) of interior bulks
+    vector<OCP_ULL> sendBuf(2 * nbI);
+    for (OCP_USI n = 0; n < nbI; n++) {
+        sendBuf[2 * n]     = gIndex[n];
+        sendBuf[2 * n + 1] = n < nb ? cost[n] : 0;
+    }
+
+    const OCP_INT   sendLen = sendBuf.size();
+    vector<OCP_INT> recvLen;
+    vector<OCP_INT> displs;
+    vector<OCP_ULL> recvBuf;
+    if (myrank == MASTER_PROCESS) {
+        recvLen.resize(numproc);
+        displs.resize(numproc + 1, 0);
+    }
+    MPI_Gather(&sendLen, 1, OCPMPI_INT, recvLen.data(), 1, OCPMPI_INT, MASTER_PROCESS, domain.global_comm);
+    if (myrank == MASTER_PROCESS) {
+        for (OCP_INT p = 0; p < numproc; p++) {
+            displs[p + 1] = displs[p] + recvLen[p];
+        }
+        recvBuf.resize(displs[numproc]);
+    }
+    MPI_Gatherv(sendBuf.data(), sendLen, OCPMPI_ULL, recvBuf.data(), recvLen.data(),
+                displs.data(), OCPMPI_ULL, MASTER_PROCESS, domain.global_comm);
+
+    if (myrank != MASTER_PROCESS) return;
+
+    const OCP_ULL   numGrid = domain.GetNumGridTotal();
+    vector<OCP_DBL> gCost(numGrid, 0);
+    vector<OCP_DBL> pCost(numproc, 0);
+    OCP_DBL         totalCost = 0;
+    for (OCP_INT p = 0; p < numproc; p++) {
+        for (OCP_INT i = displs[p]; i < displs[p + 1]; i += 2) {
+            gCost[recvBuf[i]] = recvBuf[i + 1];
+            pCost[p]         += recvBuf[i + 1];
+        }
+        totalCost += pCost[p];
+    }
+
+    // Normalize weights, the average bulk weights 10, the spread is limited
+    // to keep the sum of weights in the range of idx_t
+    const OCP_DBL avgCost = totalCost / numGrid;
+    vector<OCP_INT> wgt(numGrid, 1);
+    if (avgCost > 0) {
+        for (OCP_ULL n = 0; n < numGrid; n++) {
+            wgt[n] = OCP_MAX(1, OCP_MIN(1000, static_cast<OCP_INT>(std::lround(10 * gCost[n] / avgCost))));
+        }
+    }
+
+    ofstream outF(file, ios::out | ios::binary);
+    if (!outF.is_open()) {
+        OCP_WARNING("Can not open " + file);
+        return;
+    }
+    outF.write(reinterpret_cast<const char*>(&numGrid), sizeof(numGrid));
+    outF.write(reinterpret_cast<const char*>(wgt.data()), numGrid * sizeof(OCP_INT));
+    outF.close();
+
+    if (totalCost > 0) {
+        const OCP_DBL maxCost = *max_element(pCost.begin(), pCost.end());
+        OCP_INFO("Flash cost imbalance (max/avg) " + to_string(maxCost * numproc / totalCost)
+                 + ", vertex weights are written to " + file);
+    }
+}
+
+
+OCP_BOOL ReadVertexWeight(const string& file, const OCP_ULL& numGrid, const OCP_ULL& begin,
+                          const OCP_ULL& end, vector<OCP_INT>& wgt)
+{
+    ifstream inF(file, ios::in | ios::binary);
+    if (!inF.is_open()) {
+        OCP_WARNING("Can not open " + file);
+        return OCP_FALSE;
+    }
+
+    OCP_ULL numGridF;
+    inF.read(reinterpret_cast<char*>(&numGridF), sizeof(numGridF));
+    if (!inF || numGridF != numGrid) {
+        OCP_WARNING("Vertex weights in " + file + " do not match current grid");
+        return OCP_FALSE;
+    }
+
+    wgt.resize(end - begin);
+    inF.seekg(sizeof(numGridF) + begin * sizeof(OCP_INT), ios::beg);
+    inF.read(reinterpret_cast<char*>(wgt.data()), wgt.size() * sizeof(OCP_INT));
+    if (!inF) {
+        OCP_WARNING("Vertex weights in " + file + " are incomplete");
+        return OCP_FALSE;
+    }
+    return OCP_TRUE;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*  Brief Change History of This File                                         */
+/*----------------------------------------------------------------------------*/
+/*  Author              Date             Actions                              */
+/*----------------------------------------------------------------------------*/
+/*  Shizhe Li           Oct/16/2026      Create file                          */
+/*----------------------------------------------------------------------------*/
@@ -373,6 +373,10 @@ ViscosityMethod02::ViscosityMethod02(const vector<OCP_DBL>& av, const vector<OCP
 	avisc = av;
 	bvisc = bv;
 	nc    = avisc.size();
+	muc.resize(nc);
+	// viscosity is independent of pressure
+	mucP.resize(nc, 0);
+	mucT.resize(nc);
 }
 
 
@@ -0,0 +1,224 @@
+/*! \file    OCPHWCounter.cpp
+ *  \brief   OCPHWCounter class definition
+ *  \author  Shizhe Li
+ *  \date    Oct/16/2026
+ *
+ *-----------------------------------------------------------------------------------
+ *  Copyright (C) 2021--present by the OpenCAEPoroX team. All rights reserved.
+ *  Released under the terms of the GNU Lesser General Public License 3.0 or later.
+ *-----------------------------------------------------------------------------------
+ */
+
+#include "OCPHWCounter.hpp"
+#include "UtilOutput.hpp"
+
+#include <fstream>
+#include <iomanip>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+
+OCPHWCounter OCP_HWCOUNTER;
+
+
+static const vector<string> HWKERNEL_NAME{ "Flash", "Flux", "AssembleBulk", "AssembleWell", "LinearSolve" };
+
+
+void OCPHWCounter::Enable()
+{
+    requested = OCP_TRUE;
+#ifdef __linux__
+    // cycles, instructions, last level cache references and misses
+    if (!OpenGroup({ PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE },
+                   { PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                     PERF_COUNT_HW_CACHE_REFERENCES, PERF_COUNT_HW_CACHE_MISSES })) {
+        if (CURRENT_RANK == MASTER_PROCESS) {
+            OCP_WARNING("Hardware counters are not available, see perf_event_paranoid");
+        }
+        return;
+    }
+
+    // double precision FP_ARITH_INST_RETIRED on Intel: scalar, 128, 256, 512 bits
+    ifstream cpuinfo("/proc/cpuinfo");
+    string   line;
+    OCP_BOOL ifIntel = OCP_FALSE;
+    while (getline(cpuinfo, line)) {
+        if (line.find("vendor_id") == 0) {
+            ifIntel = line.find("GenuineIntel") != string::npos;
+            break;
+        }
+    }
+    if (ifIntel) {
+        ifFP = OpenGroup({ PERF_TYPE_RAW, PERF_TYPE_RAW, PERF_TYPE_RAW, PERF_TYPE_RAW },
+                         { 0x01C7, 0x04C7, 0x10C7, 0x40C7 });
+    }
+    const USI nk = static_cast<USI>(HWKernel::num);
+    beginVal.assign(nk, vector<uint64_t>(numEvent, 0));
+    sumVal.assign(nk, vector<uint64_t>(numEvent, 0));
+    calls.assign(nk, 0);
+    endVal.resize(numEvent, 0);
+
+    for (const auto& l : leader) {
+        ioctl(l, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(l, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+    enabled = OCP_TRUE;
+#else
+    if (CURRENT_RANK == MASTER_PROCESS) {
+        OCP_WARNING("Hardware counters are only available on Linux");
+    }
+#endif
+}
+
+
+OCP_BOOL OCPHWCounter::OpenGroup(const vector<uint64_t>& type, const vector<uint64_t>& config)
+{
+#ifdef __linux__
+    OCP_INT         fdLeader = -1;
+    vector<OCP_INT> fdGroup;
+    for (USI i = 0; i < type.size(); i++) {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size           = sizeof(attr);
+        attr.type           = type[i];
+        attr.config         = config[i];
+        attr.disabled       = fdLeader < 0 ? 1 : 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv     = 1;
+        attr.read_format    = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                              PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        const OCP_INT fd = syscall(__NR_perf_event_open, &attr, 0, -1, fdLeader, 0);
+        if (fd < 0) {
+            for (const auto& f : fdGroup) close(f);
+            return OCP_FALSE;
+        }
+        if (fdLeader < 0) fdLeader = fd;
+        fdGroup.push_back(fd);
+    }
+    leader.push_back(fdLeader);
+    groupSize.push_back(fdGroup.size());
+    readBuf.resize(3 + fdGroup.size());
+    return OCP_TRUE;
+#else
+    return OCP_FALSE;
+#endif
+}
+
+
+void OCPHWCounter::Read(vector<uint64_t>& val) const
+{
+#ifdef __linux__
+    USI e = 0;
+    for (USI g = 0; g < leader.size(); g++) {
+        // nr, time enabled, time running, values
+        const ssize_t len = (3 + groupSize[g]) * sizeof(uint64_t);
+        if (read(leader[g], readBuf.data(), len) != len) {
+            fill(val.begin() + e, val.begin() + e + groupSize[g], 0);
+        }
+        else {
+            // scale the counts if counters are multiplexed
+            const OCP_DBL scale = readBuf[2] > 0 && readBuf[2] < readBuf[1]
+                                      ? static_cast<OCP_DBL>(readBuf[1]) / readBuf[2]
+                                      : 1.0;
+            for (USI i = 0; i < groupSize[g]; i++) {
+                val[e + i] = static_cast<uint64_t>(readBuf[3 + i] * scale);
+            }
+        }
+        e += groupSize[g];
+    }
+#endif
+}
+
+
+void OCPHWCounter::Begin(const HWKernel& k)
+{
+    Read(beginVal[static_cast<USI>(k)]);
+}
+
+
+void OCPHWCounter::End(const HWKernel& k)
+{
+    const USI id = static_cast<USI>(k);
+    Read(endVal);
+    for (USI e = 0; e < numEvent; e++) {
+        // scaled counts of multiplexed counters may decrease slightly
+        if (endVal[e] > beginVal[id][e]) sumVal[id][e] += endVal[e] - beginVal[id][e];
+    }
+    calls[id]++;
+}
+
+
+void OCPHWCounter::Output(const string& dir, const MPI_Comm& comm) const
+{
+    // counters may be unavailable in some processes
+    if (!requested) return;
+
+    OCP_INT myrank, numproc;
+    MPI_Comm_rank(comm, &myrank);
+    MPI_Comm_size(comm, &numproc);
+
+    const USI        nk  = static_cast<USI>(HWKernel::num);
+    const USI        len = nk * (numEvent + 1);
+    vector<uint64_t> local(len, 0);
+    if (enabled) {
+        for (USI k = 0; k < nk; k++) {
+            copy(sumVal[k].begin(), sumVal[k].end(), &local[k * (numEvent + 1)]);
+            local[k * (numEvent + 1) + numEvent] = calls[k];
+        }
+    }
+    vector<uint64_t> all(myrank == MASTER_PROCESS ? len * numproc : 0);
+    MPI_Gather(local.data(), len, MPI_UINT64_T, all.data(), len, MPI_UINT64_T, MASTER_PROCESS, comm);
+
+    if (myrank != MASTER_PROCESS) return;
+
+    const string file = dir + "HWCounter.out";
+    ofstream     outF(file);
+    if (!outF.is_open()) {
+        OCP_WARNING("Can not open " + file);
+        return;
+    }
+
+    outF << "IPC: instructions per cycle, MPKI: last level cache misses per 1000 instructions\n"
+         << "Low IPC with high MPKI indicates a memory bound kernel\n\n";
+    outF << setw(6) << "Rank" << setw(14) << "Kernel" << setw(10) << "Calls" << setw(16)
+         << "Cycles" << setw(16) << "Instructions" << setw(8) << "IPC" << setw(14)
+         << "CacheRef" << setw(14) << "CacheMiss" << setw(8) << "MPKI" << setw(16)
+         << "FLOPs" << setw(12) << "FLOP/Cycle" << "\n";
+    outF << fixed;
+    for (OCP_INT p = 0; p < numproc; p++) {
+        for (USI k = 0; k < nk; k++) {
+            const uint64_t* v     = &all[p * len + k * (numEvent + 1)];
+            const OCP_DBL   cyc   = v[cycles];
+            const OCP_DBL   ins   = v[instructions];
+            const uint64_t  flops = v[fpScalar] + 2 * v[fp128] + 4 * v[fp256] + 8 * v[fp512];
+            outF << setw(6) << p << setw(14) << HWKERNEL_NAME[k] << setw(10) << v[numEvent]
+                 << setw(16) << v[cycles] << setw(16) << v[instructions] << setprecision(2)
+                 << setw(8) << (cyc > 0 ? ins / cyc : 0) << setw(14) << v[cacheRef]
+                 << setw(14) << v[cacheMiss] << setw(8) << (ins > 0 ? 1000 * v[cacheMiss] / ins : 0);
+            if (ifFP) {
+                outF << setw(16) << flops << setprecision(3) << setw(12) << (cyc > 0 ? flops / cyc : 0);
+            }
+            else {
+                outF << setw(16) << "-" << setw(12) << "-";
+            }
+            outF << "\n";
+        }
+    }
+    OCP_INFO("Hardware counters are written to " + file);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*  Brief Change History of This File                                         */
+/*----------------------------------------------------------------------------*/
+/*  Author              Date             Actions                              */
+/*----------------------------------------------------------------------------*/
+/*  Shizhe Li           Oct/16/2026      Create file                          */
+/*----------------------------------------------------------------------------*/
@@ -10,6 +10,7 @@
  */
 
 #include "OCPMatrix.hpp"
+#include "DenseMat.hpp"
 
 
 void OCPMatrix::Allocate(const Domain& domain, const USI& blockdim)
@@ -157,6 +158,81 @@ void OCPMatrix::CopyRhs(const vector<OCP_DBL>& rhs)
 }
 
 
+void OCPMatrix::ReduceToFirst(const OCP_USI& nr)
+{
+    vector<OCP_DBL> w(nb);
+    vector<OCP_DBL> D(nb2);
+    vector<INT>     pivot(nb);
+
+    // Blocks and rhs are reduced in place, rows before n have been reduced
+    for (OCP_USI n = 0; n < dim; n++) {
+        fill(w.begin(), w.end(), 0.0);
+        w[0] = 1.0;
+        if (n < nr) {
+            // w^T * D = e_0^T, row-major D is the transpose in LAPACK
+            copy(val[n].begin(), val[n].begin() + nb2, D.begin());
+            LUSolve(1, nb, D.data(), w.data(), pivot.data());
+        }
+
+        const USI nblk = colId[n].size();
+        for (USI k = 0; k < nblk; k++) {
+            const OCP_DBL* B = &val[n][k * nb2];
+            OCP_DBL        v = 0;
+            for (USI i = 0; i < nb; i++) v += w[i] * B[i * nb];
+            val[n][k] = v;
+        }
+        val[n].resize(nblk);
+
+        OCP_DBL r = 0;
+        for (USI i = 0; i < nb; i++) r += w[i] * b[n * nb + i];
+        b[n] = r;
+    }
+
+    SetBlockDim(1);
+    fill(u.begin(), u.begin() + dim, 0.0);
+}
+
+
+void OCPMatrix::ReduceToOthers(const OCP_USI& nr, const OCP_USI& nd)
+{
+    const USI nbo  = nb - 1;
+    const USI nbo2 = nbo * nbo;
+
+    // Blocks and rhs are reduced in place, the reduced one is never behind the original one
+    for (OCP_USI n = 0; n < nr; n++) {
+        const USI nblk = colId[n].size();
+        USI       m    = 0;
+        for (USI k = 0; k < nblk; k++) {
+            const OCP_USI c = colId[n][k];
+            if (c >= nr && c < nr + nd) continue;
+
+            colId[n][m] = c < nr ? c : c - nd;
+            const OCP_DBL* B  = &val[n][k * nb2];
+            OCP_DBL*       Bo = &val[n][m * nbo2];
+            for (USI i = 0; i < nbo; i++) {
+                for (USI j = 0; j < nbo; j++) {
+                    Bo[i * nbo + j] = B[(i + 1) * nb + j + 1];
+                }
+            }
+            m++;
+        }
+        colId[n].resize(m);
+        val[n].resize(m * nbo2);
+
+        for (USI i = 0; i < nbo; i++) b[n * nbo + i] = b[n * nb + i + 1];
+    }
+    // rows after nr are dropped
+    for (OCP_USI n = nr; n < dim; n++) {
+        colId[n].clear();
+        val[n].clear();
+    }
+
+    dim = nr;
+    SetBlockDim(nbo);
+    fill(u.begin(), u.begin() + dim * nb, 0.0);
+}
+
+
 void OCPMatrix::OutputLinearSystem(const Domain* domain, const string& dir, const string& fileA, const string& fileb) const
 {
     string FileA = dir + fileA;
@@ -11,6 +11,7 @@
 
 
  // Standard header files
+#include <algorithm>
 #include <vector>
 
 // OpenCAEPoroX header files
@@ -22,6 +23,8 @@ void OCPNRsuite::Setup(const OCP_BOOL& ifthermal, const BulkVarSet& bvs, const O
     myComm  = domain.global_comm;
     numproc = domain.global_numproc;
     myrank  = domain.global_rank;
+    reduce.Setup(myComm);
+    res0Reduce.Setup(myComm);
 
     nb        = bvs.nbI;
     np        = bvs.np;
@@ -58,6 +61,7 @@ void OCPNRsuite::Setup(const BulkVarSet& bvs, const Domain& domain)
     myComm  = domain.global_comm;
     numproc = domain.global_numproc;
     myrank  = domain.global_rank;
+    reduce.Setup(myComm);
 
     nb = bvs.nbI;
     np = bvs.np;
@@ -80,6 +84,11 @@ void OCPNRsuite::InitStep(const BulkVarSet& bvs)
     dNmaxNR.clear();
     dSmaxNR.clear();
     eVmaxNR.clear();
+
+    alpha    = 1;
+    numCutNR = 0;
+    numCut   = 0;
+    trRadius = 1;
 }
 
 
@@ -279,6 +288,38 @@ void OCPNRsuite::CalCFL(const Reservoir& rs, const OCP_DBL& dt, const OCP_BOOL&
 }
 
 
+void OCPNRsuite::CalCFL(const Reservoir& rs, const OCP_DBL& dt, const vector<OCP_BOOL>& ifSub,
+                        const USI& nsub, const OCP_BOOL& ifComm)
+{
+    CalCFL(rs, dt, OCP_FALSE);
+
+    const BulkVarSet& bvs = rs.bulk.GetVarSet();
+
+    maxCFL_loc = 0;
+    for (OCP_USI n = 0; n < nb; n++) {
+        for (USI j = 0; j < np; j++) {
+            const OCP_USI nj = n * np + j;
+            if (bvs.phaseExist[nj] && bvs.vj[nj] > TINY) {
+                if (!ifSub[n]) cfl[nj] *= nsub;
+                if (maxCFL_loc < cfl[nj]) maxCFL_loc = cfl[nj];
+            }
+        }
+    }
+    if (ifComm) {
+
+        GetWallTime timer;
+        timer.Start();
+
+        MPI_Allreduce(&maxCFL_loc, &maxCFL, 1, OCPMPI_DBL, MPI_MAX, myComm);
+
+        OCPTIME_COMM_COLLECTIVE += timer.Stop();
+    }
+    else {
+        maxCFL = maxCFL_loc;
+    }
+}
+
+
 ReservoirState OCPNRsuite::CheckCFL(const OCP_DBL& cflLim) const
 {
     if (maxCFL > cflLim)
@@ -288,7 +329,24 @@ ReservoirState OCPNRsuite::CheckCFL(const OCP_DBL& cflLim) const
 }
 
 
-OCP_BOOL OCPNRsuite::CheckPhysical(Reservoir& rs, const initializer_list<string>& il, const OCP_DBL& dt) const
+OCP_BOOL OCPNRsuite::CheckPhysical(Reservoir& rs, const initializer_list<string>& il, const OCP_DBL& dt)
+{
+    CheckPhysicalLoc(rs, il, dt);
+
+    // local CFL decides the local state, so the global one is reduced together
+    const OCP_BOOL ifCFL = find(il.begin(), il.end(), "CFL") != il.end();
+
+    reduce.Clear();
+    const USI iS = PackWorkState(reduce);
+    const USI iC = ifCFL ? reduce.PackMax(maxCFL) : 0;
+    reduce.Reduce();
+
+    if (ifCFL) maxCFL = reduce.GetMax(iC);
+    return UnpackWorkState(reduce, iS);
+}
+
+
+OCP_BOOL OCPNRsuite::CheckPhysicalLoc(Reservoir& rs, const initializer_list<string>& il, const OCP_DBL& dt)
 {
     OCPNRStateP     workState_loc = OCPNRStateP::continueSol;
     ReservoirState rsState;
@@ -338,13 +396,14 @@ OCP_BOOL OCPNRsuite::CheckPhysical(Reservoir& rs, const initializer_list<string>
             break;
     }
 
-    GetWallTime timer;
-    timer.Start();
+    workState = workState_loc;
+    return workState == OCPNRStateP::continueSol;
+}
 
-    MPI_Allreduce(&workState_loc, &workState, 1, OCPMPI_ENUM, MPI_MAX, myComm);
 
-    OCPTIME_COMM_COLLECTIVE += timer.Stop();
-    OCPTIME_COMM_1ALLREDUCE += timer.Stop();
+OCP_BOOL OCPNRsuite::UnpackWorkState(const OCPNRreduce& red, const USI& i)
+{
+    workState = static_cast<OCPNRStateP>(static_cast<USI>(red.GetMax(i)));
 
     switch (workState)
     {
@@ -362,6 +421,217 @@ OCP_BOOL OCPNRsuite::CheckPhysical(Reservoir& rs, const initializer_list<string>
 }
 
 
+void OCPNRsuite::StartRes0()
+{
+    res0Reduce.Clear();
+    res0Reduce.PackMin(res.maxRelRes_V);
+    res0Reduce.PackMax(res.maxRelRes_V);
+    res0Reduce.Start();
+}
+
+
+void OCPNRsuite::WaitRes0()
+{
+    if (res0Reduce.IfPending()) {
+        res0Reduce.Wait();
+        res.maxRelRes0_V = res0Reduce.GetMin(0);
+        merit0           = res0Reduce.GetMax(1);
+    }
+}
+
+
+void OCPNRsuite::InitMerit0()
+{
+    res0Reduce.Clear();
+    const USI iM = res0Reduce.PackMax(res.maxRelRes_V);
+    res0Reduce.Reduce();
+    merit0 = res0Reduce.GetMax(iM);
+}
+
+
+void OCPNRsuite::SaveIterate(const Reservoir& rs)
+{
+    const BulkVarSet& bvs = rs.bulk.GetVarSet();
+
+    x0P = bvs.P;
+    x0N = bvs.Ni;
+    x0S = bvs.S;
+    x0X = bvs.xij;
+    rs.allWells.GetBHP(x0W);
+
+    alpha    = 1;
+    numCutNR = 0;
+}
+
+
+void OCPNRsuite::SaveUpdate(const Reservoir& rs)
+{
+    const BulkVarSet& bvs = rs.bulk.GetVarSet();
+
+    auto diff = [](const vector<OCP_DBL>& x, const vector<OCP_DBL>& x0, vector<OCP_DBL>& dx) {
+        dx.resize(x.size());
+        for (OCP_USI n = 0; n < x.size(); n++) dx[n] = x[n] - x0[n];
+    };
+    diff(bvs.P, x0P, dxP);
+    diff(bvs.Ni, x0N, dxN);
+    diff(bvs.S, x0S, dxS);
+    diff(bvs.xij, x0X, dxX);
+    vector<OCP_DBL> bhp;
+    rs.allWells.GetBHP(bhp);
+    diff(bhp, x0W, dxW);
+}
+
+
+OCP_BOOL OCPNRsuite::CutStep(Reservoir& rs, const OCP_BOOL& pass, const OCP_BOOL& converge,
+                             const OCP_DBL& merit, const USI& maxCut, const OCP_DBL& c)
+{
+    const OCP_BOOL accept = pass && (converge || merit <= (1 - c * alpha) * merit0);
+
+    if (accept || numCutNR >= maxCut) {
+        if (pass) merit0 = merit;
+        return OCP_FALSE;
+    }
+
+    alpha *= 0.5;
+    numCutNR++;
+    numCut++;
+    SetIterate(rs);
+    return OCP_TRUE;
+}
+
+
+void OCPNRsuite::SetIterate(Reservoir& rs)
+{
+    BulkVarSet& bvs = rs.bulk.vs;
+
+    auto axpy = [&](const vector<OCP_DBL>& x0, const vector<OCP_DBL>& dx, vector<OCP_DBL>& x) {
+        for (OCP_USI n = 0; n < x.size(); n++) x[n] = x0[n] + alpha * dx[n];
+    };
+    axpy(x0P, dxP, bvs.P);
+    axpy(x0N, dxN, bvs.Ni);
+    axpy(x0S, dxS, bvs.S);
+    axpy(x0X, dxX, bvs.xij);
+    vector<OCP_DBL> bhp(x0W.size());
+    axpy(x0W, dxW, bhp);
+    rs.allWells.SetBHP(bhp, x0W);
+
+    // changes of the trial iterate are relative to the saved iterate
+    copy(x0P.begin(), x0P.end(), lP.begin());
+    copy(x0N.begin(), x0N.end(), lN.begin());
+    copy(x0S.begin(), x0S.end(), lS.begin());
+    dPBmaxNR.pop_back();
+    dPWmaxNR.pop_back();
+    dTmaxNR.pop_back();
+    dNmaxNR.pop_back();
+    dSmaxNR.pop_back();
+    eVmaxNR.pop_back();
+}
+
+
+void OCPNRsuite::UpdateTrustRegion(const OCP_DBL& merit, const OCP_DBL& rmin)
+{
+    if (merit > merit0)            trRadius = max(0.5 * trRadius, rmin);
+    else if (merit < 0.5 * merit0) trRadius = min(2 * trRadius, 1.0);
+    merit0 = merit;
+}
+
+
+void OCPNRsuite::SaveHistory(const Reservoir& rs, const OCP_DBL& t, const OCP_DBL& tw)
+{
+    // states before well changes are not smooth with current one
+    USI len = 0;
+    while (len < hisTime.size() && hisTime[len] > tw - TINY) len++;
+    // a state at the time of the newest one replaces it, e.g. a step is repeated
+    // after a restart, otherwise it is added
+    const OCP_BOOL ifNew = len == 0 || fabs(hisTime[0] - t) >= TINY;
+    if (ifNew) len = min(len, static_cast<USI>(numHis - 1));
+
+    const BulkVarSet& bvs = rs.bulk.GetVarSet();
+
+    // vectors are rotated to reuse memory
+    auto push = [&len, &ifNew](auto& his, const auto& x) {
+        if (ifNew) {
+            his.resize(len + 1);
+            rotate(his.rbegin(), his.rbegin() + 1, his.rend());
+        }
+        else {
+            his.resize(len);
+        }
+        his[0] = x;
+    };
+    push(hisTime, t);
+    push(hisP, bvs.P);
+    push(hisN, bvs.Ni);
+    push(hisT, bvs.T);
+    vector<OCP_DBL> bhp;
+    rs.allWells.GetBHP(bhp);
+    push(hisW, bhp);
+}
+
+
+OCP_BOOL OCPNRsuite::Extrapolate(Reservoir& rs, const OCP_DBL& dt, const USI& order, const OCP_DBL& dPmax) const
+{
+    const USI o = min(order, static_cast<USI>(hisTime.size() - 1));
+    if (o == 0) return OCP_FALSE;
+
+    // Lagrange weights of differences to the newest state
+    const OCP_DBL t  = hisTime[0] + dt;
+    const OCP_DBL t0 = hisTime[0];
+    const OCP_DBL t1 = hisTime[1];
+    OCP_DBL       w1 = (t - t0) / (t1 - t0);
+    OCP_DBL       w2 = 0;
+    if (o == 2) {
+        const OCP_DBL t2 = hisTime[2];
+        w1 *= (t - t2) / (t1 - t2);
+        w2  = (t - t0) * (t - t1) / ((t2 - t0) * (t2 - t1));
+    }
+    auto delta = [&](const vector<vector<OCP_DBL>>& his, const OCP_USI& i) {
+        OCP_DBL d = w1 * (his[1][i] - his[0][i]);
+        if (o == 2) d += w2 * (his[2][i] - his[0][i]);
+        return d;
+    };
+
+    // One factor for all bulks keeps the predicted state consistent, it limits the
+    // change of pressure and keeps components from being depleted by the prediction
+    BulkVarSet& bvs      = rs.bulk.vs;
+    const USI   nc       = bvs.nc;
+    OCP_DBL     chop_loc = 1;
+    for (OCP_USI n = 0; n < bvs.nbI; n++) {
+        const OCP_DBL dP = delta(hisP, n);
+        if (fabs(dP) * chop_loc > dPmax) chop_loc = dPmax / fabs(dP);
+        for (USI i = 0; i < nc; i++) {
+            const OCP_DBL dN = delta(hisN, n * nc + i);
+            if (dN < 0 && bvs.Ni[n * nc + i] + chop_loc * dN < 0.7 * bvs.Ni[n * nc + i]) {
+                chop_loc = 0.3 * bvs.Ni[n * nc + i] / fabs(dN);
+            }
+        }
+    }
+    OCP_DBL chop = chop_loc;
+    MPI_Allreduce(&chop_loc, &chop, 1, OCPMPI_DBL, MPI_MIN, rs.domain.global_comm);
+
+    for (OCP_USI n = 0; n < bvs.nb; n++) {
+        bvs.P[n] += chop * delta(hisP, n);
+        bvs.T[n] += chop * delta(hisT, n);
+        for (USI i = 0; i < nc; i++) {
+            bvs.Ni[n * nc + i] += chop * delta(hisN, n * nc + i);
+        }
+    }
+
+    // well pressure, the last one is kept in NR step
+    vector<OCP_DBL> bhp;
+    rs.allWells.GetBHP(bhp);
+    const vector<OCP_DBL> lbhp = bhp;
+    for (USI w = 0; w < bhp.size(); w++) {
+        OCP_DBL dP = delta(hisW, w);
+        if (fabs(dP) > dPmax) dP *= dPmax / fabs(dP);
+        if (bhp[w] + dP > 0)  bhp[w] += dP;
+    }
+    rs.allWells.SetBHP(bhp, lbhp);
+
+    return OCP_TRUE;
+}
+
+
 void OCPNRsuite::InitIter() {
     iterNR  = 0;
     iterLS  = 0;
@@ -389,6 +659,56 @@ void OCPNRsuite::ResetIter()
 }
 
 
+void OCPNRreduce::Clear()
+{
+    if (IfPending()) Wait();
+    local.clear();
+}
+
+
+USI OCPNRreduce::PackMax(const OCP_DBL& v)
+{
+    OCP_ASSERT(!IfPending(), "Values are packed during reduction!");
+    local.push_back(v);
+    return local.size() - 1;
+}
+
+
+USI OCPNRreduce::PackMin(const OCP_DBL& v)
+{
+    OCP_ASSERT(!IfPending(), "Values are packed during reduction!");
+    local.push_back(-v);
+    return local.size() - 1;
+}
+
+
+void OCPNRreduce::Start()
+{
+    if (IfPending()) Wait();
+
+    GetWallTime timer;
+    timer.Start();
+
+    global.resize(local.size());
+    MPI_Iallreduce(local.data(), global.data(), local.size(), OCPMPI_DBL, MPI_MAX, myComm, &request);
+
+    OCPTIME_COMM_COLLECTIVE += timer.Stop();
+    OCPTIME_COMM_1ALLREDUCE += timer.Stop();
+}
+
+
+void OCPNRreduce::Wait()
+{
+    GetWallTime timer;
+    timer.Start();
+
+    MPI_Wait(&request, MPI_STATUS_IGNORE);
+
+    OCPTIME_COMM_COLLECTIVE += timer.Stop();
+    OCPTIME_COMM_1ALLREDUCE += timer.Stop();
+}
+
+
 /*----------------------------------------------------------------------------*/
 /*  Brief Change History of This File                                         */
 /*----------------------------------------------------------------------------*/
@@ -10,6 +10,7 @@
  */
 
 #include "OCPOutput.hpp"
+#include "UtilMemory.hpp"
 
 #include <cstring>
 
@@ -557,6 +558,155 @@ void Summary::SetVal(const Reservoir& rs, const OCPControl& ctrl, const ItersInf
     //    Sumdata[n++].val.push_back(bulk.GetSWAT(SWAT.index[i]));
 }
 
+OCP_BOOL Summary::IfCommonItem(const string& item)
+{
+    return item == "FOPR" || item == "FGPR" || item == "FWPR" ||
+           item == "FOPT" || item == "FGPT" || item == "FWPT" ||
+           item == "FGIR" || item == "FGIT" || item == "FWIR" ||
+           item == "FWIT" || item == "FPR" || item == "FTR" ||
+           item == "Volume" || item == "TIME" || item == "TimeStep" ||
+           item == "NRiter" || item == "NRiterW" || item == "NRiter(DDM)" ||
+           item == "NRiterW(DDM)" || item == "LSiter" || item == "LS/NR" ||
+           item == "Runtime";
+}
+
+
+void Summary::SetupBinary(const string& dir, const MPI_Comm& comm)
+{
+    useBinary = OCP_TRUE;
+    binComm   = comm;
+    MPI_Comm_size(binComm, &binNumproc);
+    MPI_Comm_rank(binComm, &binRank);
+
+    // common items are in the front of Sumdata
+    numCommon = 0;
+    while (numCommon < Sumdata.size() && IfCommonItem(Sumdata[numCommon].Item)) {
+        numCommon++;
+    }
+
+    // descriptors of well items
+    string desc;
+    for (USI n = numCommon; n < Sumdata.size(); n++) {
+        desc += Sumdata[n].Item + "\n" + Sumdata[n].Obj + "\n" + Sumdata[n].Unit + "\n";
+    }
+
+    const OCP_INT   rowLen  = Sumdata.size();
+    const OCP_INT   descLen = desc.size();
+    vector<OCP_INT> descLens;
+    vector<OCP_INT> descDispls;
+    vector<char>    descRecv;
+    if (binRank == MASTER_PROCESS) {
+        binLen.resize(binNumproc);
+        binDispls.resize(binNumproc + 1, 0);
+        descLens.resize(binNumproc);
+        descDispls.resize(binNumproc + 1, 0);
+    }
+    MPI_Gather(&rowLen, 1, OCPMPI_INT, binLen.data(), 1, OCPMPI_INT, MASTER_PROCESS, binComm);
+    MPI_Gather(&descLen, 1, OCPMPI_INT, descLens.data(), 1, OCPMPI_INT, MASTER_PROCESS, binComm);
+    if (binRank == MASTER_PROCESS) {
+        for (OCP_INT p = 0; p < binNumproc; p++) {
+            binDispls[p + 1]  = binDispls[p] + binLen[p];
+            descDispls[p + 1] = descDispls[p] + descLens[p];
+        }
+        descRecv.resize(descDispls[binNumproc]);
+    }
+    MPI_Gatherv(desc.data(), descLen, OCPMPI_CHAR, descRecv.data(), descLens.data(),
+                descDispls.data(), OCPMPI_CHAR, MASTER_PROCESS, binComm);
+
+    binRow.resize(rowLen);
+    if (binRank != MASTER_PROCESS) return;
+
+    // items of master process come first, repeated items of other processes are skipped
+    vector<SumBinItem> items;
+    for (USI n = 0; n < numCommon; n++) {
+        items.push_back(SumBinItem(Sumdata[n].Item, Sumdata[n].Obj, Sumdata[n].Unit));
+    }
+    binCol.resize(binDispls[binNumproc], -1);
+    for (OCP_INT p = 0; p < binNumproc; p++) {
+        istringstream iss(string(descRecv.data() + descDispls[p], descLens[p]));
+        for (OCP_INT j = 0; j < binLen[p]; j++) {
+            if (j < static_cast<OCP_INT>(numCommon)) {
+                binCol[binDispls[p] + j] = j;
+                continue;
+            }
+            SumBinItem s;
+            getline(iss, s.Item);
+            getline(iss, s.Obj);
+            getline(iss, s.Unit);
+            OCP_BOOL flag = OCP_FALSE;
+            for (const auto& s1 : items) {
+                if (s1.Item == s.Item && s1.Obj == s.Obj) {
+                    flag = OCP_TRUE;
+                    break;
+                }
+            }
+            if (flag) continue;
+            binCol[binDispls[p] + j] = items.size();
+            items.push_back(s);
+        }
+    }
+    binRecv.resize(binDispls[binNumproc]);
+    binRecord.resize(items.size());
+    binWriter.Open(dir + "SUMMARY.bin", items);
+}
+
+
+void Summary::PrintBinary()
+{
+    if (!useBinary) return;
+
+    // the gather of last time step has been overlapped with current time step
+    FinishBinary();
+
+    for (USI n = 0; n < Sumdata.size(); n++) {
+        binRow[n] = Sumdata[n].val.back();
+    }
+    MPI_Igatherv(binRow.data(), binRow.size(), OCPMPI_DBL, binRecv.data(), binLen.data(),
+                 binDispls.data(), OCPMPI_DBL, MASTER_PROCESS, binComm, &binReq);
+}
+
+
+void Summary::FinishBinary()
+{
+    if (binReq == MPI_REQUEST_NULL) return;
+
+    MPI_Wait(&binReq, MPI_STATUS_IGNORE);
+
+    if (binRank != MASTER_PROCESS) return;
+
+    // combine common items in the same way as PostProcess
+    for (USI n = 0; n < numCommon; n++) {
+        const string& item = Sumdata[n].Item;
+        if (item == "FPR" || item == "FTR") {
+            // average weighted by the volume in the next item
+            OCP_DBL tmpP = 0, tmpV = 0;
+            for (OCP_INT p = 0; p < binNumproc; p++) {
+                tmpP += binRecv[binDispls[p] + n] * binRecv[binDispls[p] + n + 1];
+                tmpV += binRecv[binDispls[p] + n + 1];
+            }
+            binRecord[n] = tmpP / tmpV;
+        }
+        else if (item[0] == 'F' || item == "Volume") {
+            binRecord[n] = 0;
+            for (OCP_INT p = 0; p < binNumproc; p++) {
+                binRecord[n] += binRecv[binDispls[p] + n];
+            }
+        }
+        else {
+            binRecord[n] = binRecv[binDispls[MASTER_PROCESS] + n];
+        }
+    }
+    // well items
+    for (USI i = 0; i < binCol.size(); i++) {
+        if (binCol[i] >= static_cast<OCP_INT>(numCommon)) {
+            binRecord[binCol[i]] = binRecv[i];
+        }
+    }
+
+    binWriter.Write(binRecord);
+}
+
+
 /// Write output information in the dir/SUMMARY.out file.
 void Summary::PrintInfo(const string& dir, const string& filename, const OCP_INT& rank) const
 {
@@ -780,111 +930,111 @@ void Summary::PrintInfo(const string& dir, const string& filename, const OCP_INT
 // By communication
 void Summary::PostProcess(const string& dir, const string& filename, const OCP_INT& numproc) const
 {
+    // record of the last time step in binary summary
+    const_cast<Summary*>(this)->FinishBinary();
+
     vector<SumItem>* sumdata = const_cast<vector<SumItem>*>(&Sumdata);
-    OCP_USI         rowNum = Sumdata[0].val.size();
-    double* buffer = new double[rowNum];
+    const OCP_USI    rowNum  = Sumdata[0].val.size();
 
-    // post process
-    // combine some values
+    // field values are packed and summed by a single reduction, the averages are
+    // weighted by the volume in the next item
+    vector<USI> fieldCol;
     for (USI n = 0; n < sumdata->size(); n++) {
         auto& s = sumdata->at(n);
-        if (s.Item == "FOPR" || s.Item == "FGPR" || s.Item == "FWPR" ||
-            s.Item == "FOPT" || s.Item == "FGPT" || s.Item == "FWPT" ||
-            s.Item == "FGIR" || s.Item == "FGIT" || s.Item == "FWIR" ||
-            s.Item == "FWIT") {
-            MPI_Reduce(s.val.data(), buffer, rowNum, MPI_DOUBLE, MPI_SUM, MASTER_PROCESS, file_myComm);
-            memcpy(s.val.data(), buffer, sizeof(double) * rowNum);
-
-        }
-        else if (s.Item == "FPR" || s.Item == "FTR") {
+        if (s.Item == "FPR" || s.Item == "FTR") {
             for (USI i = 0; i < rowNum; i++) {
-                s.val[i] = s.val[i] * (&s + 1)->val[i];
-            }
-            MPI_Reduce((&s + 1)->val.data(), buffer, rowNum, MPI_DOUBLE, MPI_SUM, MASTER_PROCESS, file_myComm);
-            memcpy((&s + 1)->val.data(), buffer, sizeof(double) * rowNum);
-            MPI_Reduce(s.val.data(), buffer, rowNum, MPI_DOUBLE, MPI_SUM, MASTER_PROCESS, file_myComm);
-            for (USI i = 0; i < rowNum; i++) {
-                sumdata->at(n).val[i] = buffer[i] / sumdata->at(n + 1).val[i];
+                s.val[i] *= (&s + 1)->val[i];
             }
+            fieldCol.push_back(n);
+        }
+        else if (IfCommonItem(s.Item) && (s.Item[0] == 'F' || s.Item == "Volume")) {
+            fieldCol.push_back(n);
         }
     }
-    // gather extra column
-    int* extra_column_count = new int[numproc];
-    int local_extra_column_count = 0;
-    int ItemStringLenPresum[4];
-
-    for (USI n = 0; n < sumdata->size(); n++) {
-        auto& s = sumdata->at(n);
-        if (s.Item == "FOPR" || s.Item == "FGPR" || s.Item == "FWPR" ||
-            s.Item == "FOPT" || s.Item == "FGPT" || s.Item == "FWPT" ||
-            s.Item == "FGIR" || s.Item == "FGIT" || s.Item == "FWIR" ||
-            s.Item == "FWIT" || s.Item == "FPR" || s.Item == "FTR" ||
-            s.Item == "Volume" || s.Item == "TIME" || s.Item == "TimeStep" ||
-            s.Item == "NRiter" || s.Item == "NRiterW" || s.Item == "NRiter(DDM)" ||
-            s.Item == "NRiterW(DDM)" || s.Item == "LSiter" || s.Item == "LS/NR" ||
-            s.Item == "Runtime") {
-            continue;
+    vector<OCP_DBL> fieldSend(fieldCol.size() * rowNum);
+    vector<OCP_DBL> fieldRecv(file_myrank == MASTER_PROCESS ? fieldSend.size() : 0);
+    for (USI j = 0; j < fieldCol.size(); j++) {
+        const auto& val = sumdata->at(fieldCol[j]).val;
+        copy(val.begin(), val.begin() + rowNum, fieldSend.begin() + j * rowNum);
+    }
+    MPI_Reduce(fieldSend.data(), fieldRecv.data(), fieldSend.size(), OCPMPI_DBL, MPI_SUM,
+               MASTER_PROCESS, file_myComm);
+
+    // well items of all processes are gathered at once
+    string          desc;
+    vector<OCP_DBL> wellSend;
+    for (const auto& s : Sumdata) {
+        if (IfCommonItem(s.Item)) continue;
+        desc += s.Item + "\n" + s.Obj + "\n" + s.Unit + "\n" + s.Type + "\n";
+        wellSend.insert(wellSend.end(), s.val.begin(), s.val.begin() + rowNum);
+    }
+    const OCP_INT   sendLen[2] = { static_cast<OCP_INT>(desc.size()),
+                                   static_cast<OCP_INT>(wellSend.size()) };
+    vector<OCP_INT> recvLen;
+    vector<OCP_INT> descLens, descDispls, wellLens, wellDispls;
+    vector<char>    descRecv;
+    vector<OCP_DBL> wellRecv;
+    if (file_myrank == MASTER_PROCESS) {
+        recvLen.resize(2 * numproc);
+        descLens.resize(numproc);
+        wellLens.resize(numproc);
+        descDispls.resize(numproc + 1, 0);
+        wellDispls.resize(numproc + 1, 0);
+    }
+    MPI_Gather(sendLen, 2, OCPMPI_INT, recvLen.data(), 2, OCPMPI_INT, MASTER_PROCESS, file_myComm);
+    if (file_myrank == MASTER_PROCESS) {
+        for (OCP_INT p = 0; p < numproc; p++) {
+            descLens[p]       = recvLen[2 * p];
+            wellLens[p]       = recvLen[2 * p + 1];
+            descDispls[p + 1] = descDispls[p] + descLens[p];
+            wellDispls[p + 1] = wellDispls[p] + wellLens[p];
         }
-        local_extra_column_count++;
+        descRecv.resize(descDispls[numproc]);
+        wellRecv.resize(wellDispls[numproc]);
     }
-    MPI_Gather(&local_extra_column_count, 1, MPI_INT, extra_column_count, 1, MPI_INT, MASTER_PROCESS, file_myComm);
+    MPI_Gatherv(desc.data(), sendLen[0], OCPMPI_CHAR, descRecv.data(), descLens.data(),
+                descDispls.data(), OCPMPI_CHAR, MASTER_PROCESS, file_myComm);
+    MPI_Gatherv(wellSend.data(), sendLen[1], OCPMPI_DBL, wellRecv.data(), wellLens.data(),
+                wellDispls.data(), OCPMPI_DBL, MASTER_PROCESS, file_myComm);
 
     if (file_myrank == MASTER_PROCESS) {
-        char ItemStringBuffer[256];
-        for (USI proc = 0; proc < numproc; proc++) {
-            if (proc != MASTER_PROCESS) {
-                for (USI i = 0; i < extra_column_count[proc]; i++) {
-                    MPI_Recv(ItemStringLenPresum, 4, MPI_INT, proc, 0, file_myComm, MPI_STATUS_IGNORE);
-                    MPI_Recv(ItemStringBuffer, ItemStringLenPresum[3], MPI_CHAR, proc, 1, file_myComm, MPI_STATUS_IGNORE);
-                    MPI_Recv(buffer, rowNum, MPI_DOUBLE, proc, 2, file_myComm, MPI_STATUS_IGNORE);
-                    string Item(ItemStringBuffer, ItemStringLenPresum[0]);
-                    string Obj(ItemStringBuffer + ItemStringLenPresum[0], ItemStringLenPresum[1] - ItemStringLenPresum[0]);
-                    string Unit(ItemStringBuffer + ItemStringLenPresum[1], ItemStringLenPresum[2] - ItemStringLenPresum[1]);
-                    string Type(ItemStringBuffer + ItemStringLenPresum[2], ItemStringLenPresum[3] - ItemStringLenPresum[2]);
-                    SumItem column(Item, Obj);
-                    bool flag = false;
-                    for (USI n = 0; n < sumdata->size(); n++) {
-                        if (sumdata->at(n) == column) {
-                            flag = true;
-                        }
-                    }
-                    if (flag) {
-                        continue;
-                    }
-                    sumdata->emplace_back(Item, Obj, Unit, Type, rowNum);
-                    for (USI i = 0; i < rowNum; i++)
-                        sumdata->rbegin()->val.push_back(buffer[i]);
-                }
-            }
+        for (USI j = 0; j < fieldCol.size(); j++) {
+            copy(fieldRecv.begin() + j * rowNum, fieldRecv.begin() + (j + 1) * rowNum,
+                 sumdata->at(fieldCol[j]).val.begin());
         }
-    }
-    else {
-        string ItemStringBuffer;
         for (USI n = 0; n < sumdata->size(); n++) {
             auto& s = sumdata->at(n);
-            if (s.Item == "FOPR" || s.Item == "FGPR" || s.Item == "FWPR" ||
-                s.Item == "FOPT" || s.Item == "FGPT" || s.Item == "FWPT" ||
-                s.Item == "FGIR" || s.Item == "FGIT" || s.Item == "FWIR" ||
-                s.Item == "FWIT" || s.Item == "FPR" || s.Item == "FTR" ||
-                s.Item == "Volume" || s.Item == "TIME" || s.Item == "TimeStep" ||
-                s.Item == "NRiter" || s.Item == "NRiterW" || s.Item == "NRiter(DDM)" ||
-                s.Item == "NRiterW(DDM)" || s.Item == "LSiter" || s.Item == "LS/NR" ||
-                s.Item == "Runtime") {
-                continue;
+            if (s.Item == "FPR" || s.Item == "FTR") {
+                for (USI i = 0; i < rowNum; i++) {
+                    s.val[i] /= (&s + 1)->val[i];
+                }
+            }
+        }
+
+        for (OCP_INT p = 0; p < numproc; p++) {
+            if (p == MASTER_PROCESS) continue;
+            istringstream  iss(string(descRecv.data() + descDispls[p], descLens[p]));
+            const OCP_DBL* val = wellRecv.data() + wellDispls[p];
+            string         Item, Obj, Unit, Type;
+            for (; getline(iss, Item); val += rowNum) {
+                getline(iss, Obj);
+                getline(iss, Unit);
+                getline(iss, Type);
+                const SumItem column(Item, Obj);
+                OCP_BOOL      flag = OCP_FALSE;
+                for (auto& s : *sumdata) {
+                    if (s == column) {
+                        flag = OCP_TRUE;
+                        break;
+                    }
+                }
+                if (flag) continue;
+                sumdata->emplace_back(Item, Obj, Unit, Type, rowNum);
+                sumdata->back().val.assign(val, val + rowNum);
             }
-            ItemStringLenPresum[0] = s.Item.length();
-            ItemStringLenPresum[1] = ItemStringLenPresum[0] + s.Obj.length();
-            ItemStringLenPresum[2] = ItemStringLenPresum[1] + s.Unit.length();
-            ItemStringLenPresum[3] = ItemStringLenPresum[2] + s.Type.length();
-            ItemStringBuffer = s.Item + s.Obj + s.Unit + s.Type;
-            MPI_Send(ItemStringLenPresum, 4, MPI_INT, MASTER_PROCESS, 0, file_myComm);
-            MPI_Send(ItemStringBuffer.c_str(), ItemStringLenPresum[3], MPI_CHAR, MASTER_PROCESS, 1, file_myComm);
-            MPI_Send(s.val.data(), rowNum, MPI_DOUBLE, MASTER_PROCESS, 2, file_myComm);
         }
     }
 
-    delete[]extra_column_count;
-    delete[]buffer;
     // set output precision
     if (file_myrank == MASTER_PROCESS) {
         for (USI n = 0; n < sumdata->size(); n++) {
@@ -1167,6 +1317,125 @@ void CriticalInfo::PostProcess(const string& dir, const string& filename, const
 }
 
 
+// timers recorded in PerfLog, values of current time step are the increments
+static const vector<OCP_DBL*> PERFLOG_TIMER{ &OCPTIME_UPDATE_GRID, &OCPTIME_ASSEMBLE_MAT,
+                                             &OCPTIME_CONVERT_MAT_FOR_LS_IF, &OCPTIME_LSOLVER,
+                                             &OCPTIME_COMM_COLLECTIVE, &OCPTIME_COMM_P2P };
+// names of columns, the first ones are from master process, and the last ones
+// are the maximum over processes. Times are in seconds, rss is in GB, imbalance
+// is the max/avg of compute time (update, assemble, convert, solve), fallback is
+// the num of attempts of SFI restarted by FIM
+static const vector<string> PERFLOG_ITEM{ "step", "time", "dt", "NR", "NRw", "LS", "LSw", "wall",
+                                          "update", "assemble", "convert", "solve", "comm",
+                                          "imbalance", "rss", "fallback" };
+
+
+void PerfLog::Setup(const string& dir, const string& fmt, const MPI_Comm& comm)
+{
+    if (fmt.empty()) return;
+
+    useLog = OCP_TRUE;
+    jsonl  = fmt == "jsonl";
+    myComm = comm;
+    MPI_Comm_size(myComm, &numproc);
+    MPI_Comm_rank(myComm, &myrank);
+
+    // update, assemble, convert, solve, comm, compute time, rss
+    localVal.resize(7);
+    // timers, wall time
+    lastVal.resize(PERFLOG_TIMER.size() + 1, 0);
+    for (USI i = 0; i < PERFLOG_TIMER.size(); i++) {
+        lastVal[i] = *PERFLOG_TIMER[i];
+    }
+    if (myrank != MASTER_PROCESS) return;
+
+    allVal.resize(localVal.size() * numproc);
+    const string file = dir + "PerfLog." + (jsonl ? "jsonl" : "csv");
+    outF.open(file);
+    if (!outF.is_open()) {
+        OCP_WARNING("Can not open " + file);
+        return;
+    }
+    if (!jsonl) {
+        for (USI i = 0; i < PERFLOG_ITEM.size(); i++) {
+            outF << (i > 0 ? "," : "") << PERFLOG_ITEM[i];
+        }
+        outF << endl;
+    }
+}
+
+
+void PerfLog::SetVal(const OCPControl& ctrl, const OCPNRsuite& NRs, const ItersInfo& iters, const OCP_DBL& wallTime)
+{
+    if (!useLog) return;
+
+    const USI       nt = PERFLOG_TIMER.size();
+    vector<OCP_DBL> dT(nt);
+    for (USI i = 0; i < nt; i++) {
+        dT[i]      = *PERFLOG_TIMER[i] - lastVal[i];
+        lastVal[i] = *PERFLOG_TIMER[i];
+    }
+    copy(dT.begin(), dT.begin() + 4, localVal.begin());
+    localVal[4] = dT[4] + dT[5];
+    localVal[5] = dT[0] + dT[1] + dT[2] + dT[3];
+    localVal[6] = OCPGetCurrentRSS();
+
+    MPI_Gather(localVal.data(), localVal.size(), OCPMPI_DBL, allVal.data(), localVal.size(),
+               OCPMPI_DBL, MASTER_PROCESS, myComm);
+
+    if (myrank != MASTER_PROCESS || !outF.is_open()) return;
+
+    const USI       len = localVal.size();
+    vector<OCP_DBL> maxVal(len, 0);
+    OCP_DBL         sumCompute = 0;
+    for (OCP_INT p = 0; p < numproc; p++) {
+        for (USI i = 0; i < len; i++) {
+            maxVal[i] = OCP_MAX(maxVal[i], allVal[p * len + i]);
+        }
+        sumCompute += allVal[p * len + 5];
+    }
+
+    const vector<OCP_DBL> row{
+        static_cast<OCP_DBL>(iters.GetNumTimeStep()),
+        ctrl.time.GetCurrentTime(),
+        ctrl.time.GetLastDt(),
+        static_cast<OCP_DBL>(NRs.GetIterNR()),
+        static_cast<OCP_DBL>(NRs.GetIterNRw()),
+        static_cast<OCP_DBL>(NRs.GetIterLS()),
+        static_cast<OCP_DBL>(NRs.GetIterLSw()),
+        wallTime - lastVal[nt],
+        maxVal[0],
+        maxVal[1],
+        maxVal[2],
+        maxVal[3],
+        maxVal[4],
+        sumCompute > 0 ? maxVal[5] * numproc / sumCompute : 1.0,
+        maxVal[6],
+        static_cast<OCP_DBL>(OCPITER_SFI_FIM - lastFallback)
+    };
+    lastVal[nt]  = wallTime;
+    lastFallback = OCPITER_SFI_FIM;
+
+    OCP_ASSERT(row.size() == PERFLOG_ITEM.size(), "Wrong PerfLog items!");
+
+    outF << setprecision(6);
+    if (jsonl) {
+        outF << "{";
+        for (USI i = 0; i < row.size(); i++) {
+            outF << (i > 0 ? "," : "") << "\"" << PERFLOG_ITEM[i] << "\":" << row[i];
+        }
+        outF << "}";
+    }
+    else {
+        for (USI i = 0; i < row.size(); i++) {
+            outF << (i > 0 ? "," : "") << row[i];
+        }
+    }
+    // lines are visible to monitors during the run
+    outF << endl;
+}
+
+
 
 void OutGridVarSet::Setup(const OutGridParam& param, const Bulk& bk)
 {
@@ -1550,11 +1819,15 @@ void OutGridVarSet::Setup(const OutGridParam& param, const Bulk& bk)
 
 static const INT timeInfoLen = 256;
 
-void Out4VTK::Setup(const OutputVTKParam& VTKParam, const string& dir, const Reservoir& rs)
+void Out4VTK::Setup(const OutputVTKParam& VTKParam, const OCPControl& ctrl, const string& dir, const Reservoir& rs)
 {
     useVTK = VTKParam.useVTK;
     if (!useVTK) return;
 
+    useVTU       = ctrl.vtuOutput;
+    numMergeProc = ctrl.vtkMergeProc;
+    writer.SetAsync(ctrl.asyncOutput);
+
     bgp.Setup(VTKParam.bgp, rs.bulk);
     out4vtk.Setup(VTKParam.bgp.ASCII, VTKParam.bgp.DOUBLE);
 
@@ -1566,10 +1839,21 @@ void Out4VTK::Initialize(const string& dir, const Reservoir& rs)
 {
     if (!useVTK) return;
 
+    const Domain& doman = rs.domain;
+    myComm  = doman.global_comm;
+    numproc = doman.global_numproc;
+    myrank  = doman.global_rank;
+    workDir = dir;
+
+    if (useVTU) {
+        // each process gets the geometry of its own grids
+        out4vtk.ScatterGridInfo(dir, doman.GetGrid(), doman.GetNumGridInterior(), myComm, piece);
+        return;
+    }
+
     timeInfo = new OCP_CHAR[timeInfoLen];
 
     // output the gloabl index of grids belonging to current domain
-    const Domain& doman = rs.domain;
     if (doman.global_numproc > 1) {
         myFile = dir + "proc" + to_string(doman.global_rank) + "_vtktmp.out";
         ofstream outF(myFile, ios::out | ios::binary);
@@ -1597,8 +1881,41 @@ void Out4VTK::PrintVTK(const Reservoir& rs, const OCPControl& ctrl) const
 {
     if (!useVTK)         return;
 
+    if (useVTU) {
+        PrintVTU(rs, ctrl);
+        return;
+    }
+
     countPrint++;
 
+    // values are copied into staging buffer, which is written by writer
+    vector<OCP_CHAR> staging;
+    // output time info
+    {
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(3) << ctrl.GetOCPFile() << ctrl.time.GetCurrentTime();
+        std::string str = oss.str() + TIMEUNIT + "_";
+        strncpy(timeInfo, str.c_str(), timeInfoLen);
+        staging.insert(staging.end(), timeInfo, timeInfo + timeInfoLen);
+    }
+
+    // output physical variables
+    CollectGridVal(rs, ctrl, [&staging](const string&, const string&, const vector<OCP_DBL>& tmpV) {
+        const OCP_CHAR* ptr = (const OCP_CHAR*)tmpV.data();
+        staging.insert(staging.end(), ptr, ptr + tmpV.size() * sizeof(tmpV[0]));
+    });
+
+    writer.Launch([file = myFile, staging = move(staging)]() {
+        ofstream outF(file, ios::app | ios::binary);
+        outF.write(staging.data(), staging.size());
+        outF.close();
+    });
+}
+
+
+void Out4VTK::CollectGridVal(const Reservoir& rs, const OCPControl& ctrl,
+                             const function<void(const string&, const string&, const vector<OCP_DBL>&)>& op) const
+{
     const BulkVarSet& bvs = rs.bulk.vs;
 
     const auto nb     = bvs.nbI;
@@ -1608,83 +1925,67 @@ void Out4VTK::PrintVTK(const Reservoir& rs, const OCPControl& ctrl) const
     const auto GIndex = bvs.g;
     const auto WIndex = bvs.w;
 
-    ofstream outF(myFile, ios::app | ios::binary);
     vector<OCP_DBL> tmpV(nb);
-    // output    
-    // output time info
-    {
-        std::ostringstream oss;
-        oss << std::fixed << std::setprecision(3) << ctrl.GetOCPFile() << ctrl.time.GetCurrentTime();
-        std::string str = oss.str() + TIMEUNIT + "_";
-        strncpy(timeInfo, str.c_str(), timeInfoLen);
-        outF.write(timeInfo, timeInfoLen);
-    }
-
-    if (bgp.bgpnum == 0) {
-        outF.close();
-        return;
-    }
 
-    // output physical variables
     if (bgp.PRE) {
         for (OCP_USI n = 0; n < nb; n++)
             tmpV[n] = bvs.P[n];
-        outF.write((const OCP_CHAR*)&tmpV[0], nb * sizeof(tmpV[0]));
+        op("PRESSURE", VTK_FLOAT, tmpV);
     }
     if (bgp.COMPM) {
         for (USI i = 0; i < nc; i++) {
             for (OCP_USI n = 0; n < nb; n++)
                 tmpV[n] = bvs.Ni[n * nc + i];
-            outF.write((const OCP_CHAR*)&tmpV[0], nb * sizeof(tmpV[0]));
+            op("COMPM-" + to_string(i), VTK_FLOAT, tmpV);
         }
     }
     if (bgp.PHASEP) {
         for (USI j = 0; j < np; j++) {
             for (OCP_USI n = 0; n < nb; n++)
                 tmpV[n] = bvs.Pj[n * np + j];
-            outF.write((const OCP_CHAR*)&tmpV[0], nb * sizeof(tmpV[0]));
+            op("PHASEP-" + to_string(j), VTK_FLOAT, tmpV);
         }
     }
     if (bgp.SOIL) {
         for (OCP_USI n = 0; n < nb; n++)
             tmpV[n] = bvs.S[n * np + OIndex];
-        outF.write((const OCP_CHAR*)&tmpV[0], nb * sizeof(tmpV[0]));
+        op("SOIL", VTK_FLOAT, tmpV);
     }
     if (bgp.SGAS) {
         for (OCP_USI n = 0; n < nb; n++)
             tmpV[n] = bvs.S[n * np + GIndex];
-        outF.write((const OCP_CHAR*)&tmpV[0], nb * sizeof(tmpV[0]));
+        op("SGAS", VTK_FLOAT, tmpV);
     }
     if (bgp.SWAT) {
         for (OCP_USI n = 0; n < nb; n++)
             tmpV[n] = bvs.S[n * np + WIndex];
-        outF.write((const OCP_CHAR*)&tmpV[0], nb * sizeof(tmpV[0]));
+        op("SWAT", VTK_FLOAT, tmpV);
     }
 
     // add CO2 concentration for SPE11
     if (bgp.CO2) {
         for (OCP_USI n = 0; n < nb; n++)
             tmpV[n] = bvs.rho[n * np + WIndex] * bvs.xij[(n * np + WIndex) * nc + GIndex];
-        outF.write((const OCP_CHAR*)&tmpV[0], nb * sizeof(tmpV[0]));
+        op("CO2", VTK_FLOAT, tmpV);
     }
 
     // add SAT region for SPE11
     if (bgp.SATNUM) {
         for (OCP_USI n = 0; n < nb; n++)
             tmpV[n] = static_cast<OCP_DBL>(rs.bulk.SATm.GetSATNUM(n));
-        outF.write((const OCP_CHAR*)&tmpV[0], nb * sizeof(tmpV[0]));
+        op("SATNUM", VTK_UNSIGNED_INT, tmpV);
     }
 
     if (bgp.PERMX) {
         for (OCP_USI n = 0; n < nb; n++)
             tmpV[n] = bvs.rockKx[n];
-        outF.write((const OCP_CHAR*)&tmpV[0], nb * sizeof(tmpV[0]));
+        op("PERMX", VTK_FLOAT, tmpV);
     }
 
     if (bgp.PERMY) {
         for (OCP_USI n = 0; n < nb; n++)
             tmpV[n] = bvs.rockKy[n];
-        outF.write((const OCP_CHAR*)&tmpV[0], nb * sizeof(tmpV[0]));
+        op("PERMY", VTK_FLOAT, tmpV);
     }
 
     OCP_DBL dt = ctrl.time.GetLastDt();
@@ -1694,14 +1995,14 @@ void Out4VTK::PrintVTK(const Reservoir& rs, const OCPControl& ctrl) const
         for (USI j = 0; j < np; j++) {
             for (OCP_USI n = 0; n < nb; n++)
                 tmpV[n] = fabs(bvs.S[n * np + j] - bvs.lS[n * np + j]);
-            outF.write((const OCP_CHAR*)&tmpV[0], nb * sizeof(tmpV[0]));
+            op("DS-" + to_string(j), VTK_FLOAT, tmpV);
         }
     }
     if (bgp.DP) {
         for (USI j = 0; j < np; j++) {
             for (OCP_USI n = 0; n < nb; n++)
                 tmpV[n] = fabs(bvs.Pj[n * np + j] - bvs.lPj[n * np + j]);
-            outF.write((const OCP_CHAR*)&tmpV[0], nb * sizeof(tmpV[0]));
+            op("DP-" + to_string(j), VTK_FLOAT, tmpV);
         }
     }
     if (bgp.CSFLAG) {
@@ -1710,27 +2011,69 @@ void Out4VTK::PrintVTK(const Reservoir& rs, const OCPControl& ctrl) const
             flag = static_cast<OCP_DBL>(*rs.domain.cs_group_global_rank_for_output.begin());
         }
         fill(tmpV.begin(), tmpV.end(), flag);
-        outF.write((const OCP_CHAR*)&tmpV[0], nb * sizeof(tmpV[0]));
+        op("CSFLAG", VTK_INT, tmpV);
     }
     if (bgp.ITERNRDDM) {
         fill(tmpV.begin(), tmpV.end(), static_cast<OCP_DBL>(OCPITER_NR_DDM));
-        outF.write((const OCP_CHAR*)&tmpV[0], nb * sizeof(tmpV[0]));
+        op("ITERNRDDM", VTK_INT, tmpV);
     }
     if (bgp.ITERLSDDM) {
         fill(tmpV.begin(), tmpV.end(), static_cast<OCP_DBL>(OCPITER_LS_DDM));
-        outF.write((const OCP_CHAR*)&tmpV[0], nb * sizeof(tmpV[0]));
+        op("ITERLSDDM", VTK_INT, tmpV);
     }
     if (bgp.TIMELSDDM) {
         fill(tmpV.begin(), tmpV.end(), OCPTIME_LSOLVER_DDM);
-        outF.write((const OCP_CHAR*)&tmpV[0], nb * sizeof(tmpV[0]));
+        op("TIMELSDDM", VTK_FLOAT, tmpV);
     }
-         
-    outF.close();
+}
+
+
+void Out4VTK::PrintVTU(const Reservoir& rs, const OCPControl& ctrl) const
+{
+    const OCP_ULL nb = rs.bulk.vs.nbI;
+
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(3) << ctrl.GetOCPFile() << ctrl.time.GetCurrentTime();
+    const string stem = oss.str() + TIMEUNIT + "_" + to_string(countPrint++);
+
+    vector<VtuArray> cellData;
+    // Ouput partition
+    out4vtk.AddCellArray(cellData, "PARTITION", VTK_UNSIGNED_INT, vector<OCP_DBL>(nb, myrank), nb);
+    CollectGridVal(rs, ctrl, [this, &cellData, &nb](const string& name, const string& type, const vector<OCP_DBL>& tmpV) {
+        out4vtk.AddCellArray(cellData, name, type, tmpV, nb);
+    });
+
+    vector<string> pieces;
+    if (myrank == MASTER_PROCESS) {
+        pieces.resize(numproc);
+        for (OCP_INT p = 0; p < numproc; p++) {
+            pieces[p] = stem + "_p" + to_string(p) + ".vtu";
+        }
+        vtuSeries.push_back(make_pair(ctrl.time.GetCurrentTime(), stem + ".pvtu"));
+    }
+
+    // cellData is the staging buffer, piece is fixed after setup
+    writer.Launch([this, stem, pvdFile = workDir + ctrl.GetOCPFile() + ".pvd", pieces = move(pieces),
+                   series = (myrank == MASTER_PROCESS ? vtuSeries : vector<pair<OCP_DBL, string>>()),
+                   cellData = move(cellData)]() {
+        Output4Vtk::OutputVTU(workDir + stem + "_p" + to_string(myrank) + ".vtu", piece, cellData);
+        if (myrank == MASTER_PROCESS) {
+            Output4Vtk::OutputPVTU(workDir + stem + ".pvtu", pieces, cellData);
+            // the collection is rewritten each time, so it is valid even if the run stops
+            Output4Vtk::OutputPVD(pvdFile, series);
+        }
+    });
 }
 
 
 void Out4VTK::PostProcess(const string& dir, const string& filename, const OCP_INT& numproc) const
 {
+    // temporary files must be complete
+    writer.Wait();
+
+    // pieces of vtu have been output by each process
+    if (useVTU)       return;
+
     if (numproc > 1)  PostProcessP(dir, filename, numproc);
     else              PostProcessS(dir, filename);
 }
@@ -1742,205 +2085,92 @@ void Out4VTK::PostProcessP(const string& dir, const string& filename, const OCP_
 
     // Input Points
     const string srcFile = dir + "TSTEP.vtk";
-    numGrid = out4vtk.Init(dir, srcFile, "RUN of " + dir + filename);
+    if (myrank == MASTER_PROCESS) {
+        numGrid = out4vtk.Init(dir, srcFile, "RUN of " + dir + filename);
+    }
+    MPI_Bcast(&numGrid, 1, OCPMPI_ULL, MASTER_PROCESS, myComm);
+    // wait for srcFile
+    MPI_Barrier(myComm);
+
+    // time steps are merged by the first numMerge processes in turn, and each of
+    // them holds the values of only one time step
+    const OCP_INT  numMerge = OCP_MAX(1, OCP_MIN(numMergeProc, numproc));
+    const OCP_BOOL ifMerge  = myrank < numMerge &&
+                              (myrank < static_cast<OCP_INT>(countPrint) || myrank == MASTER_PROCESS);
+    if (ifMerge) {
+
+        // Input the global index of grids in each process
+        vector<vector<OCP_ULL>> global_index(numproc);
+        vector<streamoff>       headLen(numproc);
+        vector<OCP_USI>         mypart(numGrid);
+        for (OCP_INT p = 0; p < numproc; p++) {
+            const string myfile = dir + "proc" + to_string(p) + "_vtktmp.out";
+            ifstream inV(myfile, ios::in | ios::binary);
+            if (!inV.is_open()) {
+                OCP_WARNING("Can not open " + myfile);
+            }
+
+            OCP_USI numGridLoc = 0;
+            inV.read((OCP_CHAR*)(&numGridLoc), sizeof(numGridLoc));
+            global_index[p].resize(numGridLoc);
+            inV.read((OCP_CHAR*)(global_index[p].data()), sizeof(global_index[p][0]) * numGridLoc);
+            inV.close();
+
+            headLen[p] = sizeof(numGridLoc) + sizeof(global_index[p][0]) * numGridLoc;
+            for (const auto& g : global_index[p])
+                mypart[g] = p;
+        }
 
-    // Input cell values    
-    vector<vector<OCP_DBL>> gridVal;        // each row is on a node of TSTEP in turn
-    vector<OCP_ULL>         global_index;
-    vector<OCP_USI>         mypart(numGrid);
-    OCP_DBL*                workPtr;
-    vector<OCP_DBL>         tmpVal;
-    
+        if (countPrint == 0) {
+            ofstream source(srcFile, ios::app);
+            source << "\n" << VTK_CELL_DATA << " " << numGrid;
+            // Ouput partition
+            out4vtk.OutputCELL_DATA_SCALARS(source, "PARTITION", VTK_UNSIGNED_INT, mypart, 0, numGrid, 0);
+            source.close();
+        }
 
-    vector<string>          timeSeries;
+        vector<OCP_CHAR> timeBuf(timeInfoLen);
+        vector<OCP_DBL>  gridVal(bgp.bgpnum * numGrid);
+        vector<OCP_DBL>  tmpVal;
+        for (USI t = myrank; t < countPrint; t += numMerge) {
+            string timeStr;
+            for (OCP_INT p = 0; p < numproc; p++) {
+                const string myfile = dir + "proc" + to_string(p) + "_vtktmp.out";
+                ifstream inV(myfile, ios::in | ios::binary);
+                if (!inV.is_open()) {
+                    OCP_WARNING("Can not open " + myfile);
+                }
 
-    for (USI p = 0; p < numproc; p++) {
-        const string myfile = dir + "proc" + to_string(p) + "_vtktmp.out";
-        ifstream inV(myfile, ios::in | ios::binary);
-        if (!inV.is_open()) {
-            OCP_WARNING("Can not open " + myfile);
-        }
-        
-        OCP_USI numGridLoc = 0;
-        inV.read((OCP_CHAR*)(&numGridLoc), sizeof(numGridLoc));
-        global_index.resize(numGridLoc);
-        inV.read((OCP_CHAR*)(&global_index[0]), sizeof(global_index[0]) * numGridLoc);
-
-        for (OCP_USI n = 0; n < numGridLoc; n++)
-            mypart[global_index[n]] = p;
-
-
-		USI index = 0;
-		while (index < countPrint) {
-			// input time info
-			inV.read(timeInfo, timeInfoLen);
-			if (p == 0) {
-				timeSeries.push_back(string(timeInfo));
-			}
-
-			// input grid info
-            if (bgp.bgpnum == 0) {
-                index++;
-                continue;
-            }
+                // each record contains time info and values of all variables
+                const OCP_USI   numGridLoc = global_index[p].size();
+                const streamoff recordLen  = timeInfoLen + sizeof(OCP_DBL) * bgp.bgpnum * numGridLoc;
+                inV.seekg(headLen[p] + t * recordLen, ios::beg);
 
-			tmpVal.resize(numGridLoc * bgp.bgpnum);
-
-			if (index >= gridVal.size()) {
-				gridVal.push_back(vector<OCP_DBL>());
-				gridVal.back().resize(bgp.bgpnum * numGrid);
-			}
-			workPtr = &gridVal[index][0];
-			inV.read((OCP_CHAR*)(&tmpVal[0]), sizeof(tmpVal[0]) * tmpVal.size());
-			const OCP_DBL* tmpVal_ptr = &tmpVal[0];
-
-			if (bgp.PRE) {
-				for (OCP_USI n = 0; n < numGridLoc; n++) {
-					workPtr[global_index[n]] = tmpVal_ptr[n];
-				}
-				workPtr += numGrid;
-				tmpVal_ptr += numGridLoc;
-			}
-			if (bgp.COMPM) {
-				for (USI i = 0; i < bgp.nc; i++) {
-					for (OCP_USI n = 0; n < numGridLoc; n++) {
-						workPtr[global_index[n]] = tmpVal_ptr[n];
-					}
-					workPtr += numGrid;
-					tmpVal_ptr += numGridLoc;
-				}
-			}
-			if (bgp.PHASEP) {
-				for (USI j = 0; j < bgp.np; j++) {
-					for (OCP_USI n = 0; n < numGridLoc; n++) {
-						workPtr[global_index[n]] = tmpVal_ptr[n];
-					}
-					workPtr += numGrid;
-					tmpVal_ptr += numGridLoc;
-				}
-			}
-			if (bgp.SOIL) {
-				for (OCP_USI n = 0; n < numGridLoc; n++) {
-					workPtr[global_index[n]] = tmpVal_ptr[n];
-				}
-				workPtr += numGrid;
-				tmpVal_ptr += numGridLoc;
-			}
-			if (bgp.SGAS) {
-				for (OCP_USI n = 0; n < numGridLoc; n++) {
-					workPtr[global_index[n]] = tmpVal_ptr[n];
-				}
-				workPtr += numGrid;
-				tmpVal_ptr += numGridLoc;
-			}
-			if (bgp.SWAT) {
-				for (OCP_USI n = 0; n < numGridLoc; n++) {
-					workPtr[global_index[n]] = tmpVal_ptr[n];
-				}
-				workPtr += numGrid;
-				tmpVal_ptr += numGridLoc;
-			}
-			if (bgp.CO2) {
-				for (OCP_USI n = 0; n < numGridLoc; n++) {
-					workPtr[global_index[n]] = tmpVal_ptr[n];
-				}
-				workPtr += numGrid;
-				tmpVal_ptr += numGridLoc;
-			}
-			if (bgp.SATNUM) {
-				for (OCP_USI n = 0; n < numGridLoc; n++) {
-					workPtr[global_index[n]] = tmpVal_ptr[n];
-				}
-				workPtr += numGrid;
-				tmpVal_ptr += numGridLoc;
-			}
-			if (bgp.PERMX) {
-				for (OCP_USI n = 0; n < numGridLoc; n++) {
-					workPtr[global_index[n]] = tmpVal_ptr[n];
-				}
-				workPtr += numGrid;
-				tmpVal_ptr += numGridLoc;
-			}
-            if (bgp.PERMY) {
-                for (OCP_USI n = 0; n < numGridLoc; n++) {
-                    workPtr[global_index[n]] = tmpVal_ptr[n];
+                // input time info
+                inV.read(timeBuf.data(), timeInfoLen);
+                if (p == 0) {
+                    timeStr = string(timeBuf.data());
                 }
-                workPtr += numGrid;
-                tmpVal_ptr += numGridLoc;
-            }
-			if (bgp.DSAT) {
-				for (USI j = 0; j < bgp.np; j++) {
-					for (OCP_USI n = 0; n < numGridLoc; n++) {
-						workPtr[global_index[n]] = tmpVal_ptr[n];
-					}
-					workPtr += numGrid;
-					tmpVal_ptr += numGridLoc;
-				}
-			}
-            if (bgp.DP) {
-                for (USI j = 0; j < bgp.np; j++) {
+
+                // input grid info
+                tmpVal.resize(bgp.bgpnum * numGridLoc);
+                inV.read((OCP_CHAR*)(tmpVal.data()), sizeof(tmpVal[0]) * tmpVal.size());
+                if (!inV) {
+                    OCP_ABORT("Something Wrong in the temporary files");
+                }
+                inV.close();
+
+                const OCP_ULL* gIndex = global_index[p].data();
+                for (USI v = 0; v < bgp.bgpnum; v++) {
+                    OCP_DBL*       workPtr    = &gridVal[v * numGrid];
+                    const OCP_DBL* tmpVal_ptr = &tmpVal[v * numGridLoc];
                     for (OCP_USI n = 0; n < numGridLoc; n++) {
-                        workPtr[global_index[n]] = tmpVal_ptr[n];
+                        workPtr[gIndex[n]] = tmpVal_ptr[n];
                     }
-                    workPtr += numGrid;
-                    tmpVal_ptr += numGridLoc;
-                }
-            }
-			if (bgp.CSFLAG) {
-				for (OCP_USI n = 0; n < numGridLoc; n++) {
-					workPtr[global_index[n]] = tmpVal_ptr[n];
-				}
-				workPtr += numGrid;
-				tmpVal_ptr += numGridLoc;
-			}
-            if (bgp.ITERNRDDM) {
-                for (OCP_USI n = 0; n < numGridLoc; n++) {
-                    workPtr[global_index[n]] = tmpVal_ptr[n];
-                }
-                workPtr += numGrid;
-                tmpVal_ptr += numGridLoc;
-            }
-            if (bgp.ITERLSDDM) {
-                for (OCP_USI n = 0; n < numGridLoc; n++) {
-                    workPtr[global_index[n]] = tmpVal_ptr[n];
                 }
-                workPtr += numGrid;
-                tmpVal_ptr += numGridLoc;
             }
-            if (bgp.TIMELSDDM) {
-                for (OCP_USI n = 0; n < numGridLoc; n++) {
-                    workPtr[global_index[n]] = tmpVal_ptr[n];
-                }
-                workPtr += numGrid;
-                tmpVal_ptr += numGridLoc;
-            }
-
-			index++;
-		}
-        inV.close();
-		if (remove(myfile.c_str()) != 0) {
-			OCP_WARNING("Failed to delete " + myfile);
-		}
-    }
-
-    // OutPut
 
-    USI numTstep = timeSeries.size();
-    if (numTstep != gridVal.size()) {
-        cout << numTstep << "   " << gridVal.size() << endl;
-        OCP_ABORT("Something Wrong in the temporary files");
-    }
-
-    if (numTstep == 0) {
-        ofstream source(srcFile, ios::app);
-        source << "\n" << VTK_CELL_DATA << " " << numGrid;
-        // Ouput partition
-        out4vtk.OutputCELL_DATA_SCALARS(source, "PARTITION", VTK_UNSIGNED_INT, mypart, 0, numGrid, 0);
-        source.close();
-    }
-    else {
-        for (USI t = 0; t < numTstep; t++) {
-            const string dstFile = dir + timeSeries[t] + to_string(t) + ".vtk";
+            const string dstFile = dir + timeStr + to_string(t) + ".vtk";
             ifstream source(srcFile, ios::binary);
             ofstream dest(dstFile, ios::binary);
             dest << source.rdbuf();
@@ -1949,83 +2179,18 @@ void Out4VTK::PostProcessP(const string& dir, const string& filename, const OCP_
             dest << "\n" << VTK_CELL_DATA << " " << numGrid;
             // Ouput partition
             out4vtk.OutputCELL_DATA_SCALARS(dest, "PARTITION", VTK_UNSIGNED_INT, mypart, 0, numGrid, 0);
-
-            OCP_ULL bId = 0;
-            if (bgp.PRE) {
-                out4vtk.OutputCELL_DATA_SCALARS(dest, "PRESSURE", VTK_FLOAT, gridVal[t], bId, numGrid, 3);
-                bId += numGrid;
-            }
-            if (bgp.COMPM) {
-                for (USI i = 0; i < bgp.nc; i++) {
-                    out4vtk.OutputCELL_DATA_SCALARS(dest, "COMPM-" + to_string(i), VTK_FLOAT, gridVal[t], bId, numGrid, 3);
-                    bId += numGrid;
-                }
-            }
-            if (bgp.PHASEP) {
-                for (USI j = 0; j < bgp.np; j++) {
-                    out4vtk.OutputCELL_DATA_SCALARS(dest, "PHASEP-" + to_string(j), VTK_FLOAT, gridVal[t], bId, numGrid, 3);
-                    bId += numGrid;
-                }
-            }
-            if (bgp.SOIL) {
-                out4vtk.OutputCELL_DATA_SCALARS(dest, "SOIL", VTK_FLOAT, gridVal[t], bId, numGrid, 6);
-                bId += numGrid;
-            }
-            if (bgp.SGAS) {
-                out4vtk.OutputCELL_DATA_SCALARS(dest, "SGAS", VTK_FLOAT, gridVal[t], bId, numGrid, 6);
-                bId += numGrid;
-            }
-            if (bgp.SWAT) {
-                out4vtk.OutputCELL_DATA_SCALARS(dest, "SWAT", VTK_FLOAT, gridVal[t], bId, numGrid, 6);
-                bId += numGrid;
-            }
-            if (bgp.CO2) {
-                out4vtk.OutputCELL_DATA_SCALARS(dest, "CO2", VTK_FLOAT, gridVal[t], bId, numGrid, 6);
-                bId += numGrid;
-            }
-            if (bgp.SATNUM) {
-                out4vtk.OutputCELL_DATA_SCALARS(dest, "SATNUM", VTK_UNSIGNED_INT, gridVal[t], bId, numGrid, 0);
-                bId += numGrid;
-            }
-            if (bgp.PERMX) {
-                out4vtk.OutputCELL_DATA_SCALARS(dest, "PERMX", VTK_FLOAT, gridVal[t], bId, numGrid, 0);
-                bId += numGrid;
-            }
-            if (bgp.PERMY) {
-                out4vtk.OutputCELL_DATA_SCALARS(dest, "PERMY", VTK_FLOAT, gridVal[t], bId, numGrid, 0);
-                bId += numGrid;
-            }
-            if (bgp.DSAT) {
-                for (USI j = 0; j < bgp.np; j++) {
-                    out4vtk.OutputCELL_DATA_SCALARS(dest, "DS-" + to_string(j), VTK_FLOAT, gridVal[t], bId, numGrid, 3);
-                    bId += numGrid;
-                }
-            }
-            if (bgp.DP) {
-                for (USI j = 0; j < bgp.np; j++) {
-                    out4vtk.OutputCELL_DATA_SCALARS(dest, "DP-" + to_string(j), VTK_FLOAT, gridVal[t], bId, numGrid, 3);
-                    bId += numGrid;
-                }
-            }
-            if (bgp.CSFLAG) {
-                out4vtk.OutputCELL_DATA_SCALARS(dest, "CSFLAG", VTK_INT, gridVal[t], bId, numGrid, 0);
-                bId += numGrid;
-            }
-            if (bgp.ITERNRDDM) {
-                out4vtk.OutputCELL_DATA_SCALARS(dest, "ITERNRDDM", VTK_INT, gridVal[t], bId, numGrid, 0);
-                bId += numGrid;
-            }
-            if (bgp.ITERLSDDM) {
-                out4vtk.OutputCELL_DATA_SCALARS(dest, "ITERLSDDM", VTK_INT, gridVal[t], bId, numGrid, 0);
-                bId += numGrid;
-            }
-            if (bgp.TIMELSDDM) {
-                out4vtk.OutputCELL_DATA_SCALARS(dest, "TIMELSDDM", VTK_FLOAT, gridVal[t], bId, numGrid, 0);
-                bId += numGrid;
-            }
-
+            OutputCellData(dest, gridVal);
             dest.close();
         }
+    }
+
+    // all time steps have been output
+    MPI_Barrier(myComm);
+
+    if (remove(myFile.c_str()) != 0) {
+        OCP_WARNING("Failed to delete " + myFile);
+    }
+    if (myrank == MASTER_PROCESS && countPrint > 0) {
         if (remove(srcFile.c_str()) != 0) {
             OCP_WARNING("Failed to delete " + srcFile);
         }
@@ -2033,6 +2198,84 @@ void Out4VTK::PostProcessP(const string& dir, const string& filename, const OCP_
 }
 
 
+void Out4VTK::OutputCellData(ofstream& dest, const vector<OCP_DBL>& gridVal) const
+{
+    OCP_ULL bId = 0;
+    if (bgp.PRE) {
+        out4vtk.OutputCELL_DATA_SCALARS(dest, "PRESSURE", VTK_FLOAT, gridVal, bId, numGrid, 3);
+        bId += numGrid;
+    }
+    if (bgp.COMPM) {
+        for (USI i = 0; i < bgp.nc; i++) {
+            out4vtk.OutputCELL_DATA_SCALARS(dest, "COMPM-" + to_string(i), VTK_FLOAT, gridVal, bId, numGrid, 3);
+            bId += numGrid;
+        }
+    }
+    if (bgp.PHASEP) {
+        for (USI j = 0; j < bgp.np; j++) {
+            out4vtk.OutputCELL_DATA_SCALARS(dest, "PHASEP-" + to_string(j), VTK_FLOAT, gridVal, bId, numGrid, 3);
+            bId += numGrid;
+        }
+    }
+    if (bgp.SOIL) {
+        out4vtk.OutputCELL_DATA_SCALARS(dest, "SOIL", VTK_FLOAT, gridVal, bId, numGrid, 6);
+        bId += numGrid;
+    }
+    if (bgp.SGAS) {
+        out4vtk.OutputCELL_DATA_SCALARS(dest, "SGAS", VTK_FLOAT, gridVal, bId, numGrid, 6);
+        bId += numGrid;
+    }
+    if (bgp.SWAT) {
+        out4vtk.OutputCELL_DATA_SCALARS(dest, "SWAT", VTK_FLOAT, gridVal, bId, numGrid, 6);
+        bId += numGrid;
+    }
+    if (bgp.CO2) {
+        out4vtk.OutputCELL_DATA_SCALARS(dest, "CO2", VTK_FLOAT, gridVal, bId, numGrid, 6);
+        bId += numGrid;
+    }
+    if (bgp.SATNUM) {
+        out4vtk.OutputCELL_DATA_SCALARS(dest, "SATNUM", VTK_UNSIGNED_INT, gridVal, bId, numGrid, 0);
+        bId += numGrid;
+    }
+    if (bgp.PERMX) {
+        out4vtk.OutputCELL_DATA_SCALARS(dest, "PERMX", VTK_FLOAT, gridVal, bId, numGrid, 0);
+        bId += numGrid;
+    }
+    if (bgp.PERMY) {
+        out4vtk.OutputCELL_DATA_SCALARS(dest, "PERMY", VTK_FLOAT, gridVal, bId, numGrid, 0);
+        bId += numGrid;
+    }
+    if (bgp.DSAT) {
+        for (USI j = 0; j < bgp.np; j++) {
+            out4vtk.OutputCELL_DATA_SCALARS(dest, "DS-" + to_string(j), VTK_FLOAT, gridVal, bId, numGrid, 3);
+            bId += numGrid;
+        }
+    }
+    if (bgp.DP) {
+        for (USI j = 0; j < bgp.np; j++) {
+            out4vtk.OutputCELL_DATA_SCALARS(dest, "DP-" + to_string(j), VTK_FLOAT, gridVal, bId, numGrid, 3);
+            bId += numGrid;
+        }
+    }
+    if (bgp.CSFLAG) {
+        out4vtk.OutputCELL_DATA_SCALARS(dest, "CSFLAG", VTK_INT, gridVal, bId, numGrid, 0);
+        bId += numGrid;
+    }
+    if (bgp.ITERNRDDM) {
+        out4vtk.OutputCELL_DATA_SCALARS(dest, "ITERNRDDM", VTK_INT, gridVal, bId, numGrid, 0);
+        bId += numGrid;
+    }
+    if (bgp.ITERLSDDM) {
+        out4vtk.OutputCELL_DATA_SCALARS(dest, "ITERLSDDM", VTK_INT, gridVal, bId, numGrid, 0);
+        bId += numGrid;
+    }
+    if (bgp.TIMELSDDM) {
+        out4vtk.OutputCELL_DATA_SCALARS(dest, "TIMELSDDM", VTK_FLOAT, gridVal, bId, numGrid, 0);
+        bId += numGrid;
+    }
+}
+
+
 void Out4VTK::PostProcessS(const string& dir, const string& filename) const
 {
     if (!useVTK) return;
@@ -2069,80 +2312,7 @@ void Out4VTK::PostProcessS(const string& dir, const string& filename) const
         source.close();
 
         dest << "\n" << VTK_CELL_DATA << " " << numGrid;
-        OCP_ULL bId = 0;
-        if (bgp.PRE) {
-            out4vtk.OutputCELL_DATA_SCALARS(dest, "PRESSURE", VTK_FLOAT, tmpVal, bId, numGrid, 3);
-            bId += numGrid;
-        }
-        if (bgp.COMPM) {
-            for (USI i = 0; i < bgp.nc; i++) {
-                out4vtk.OutputCELL_DATA_SCALARS(dest, "COMPM-" + to_string(i), VTK_FLOAT, tmpVal, bId, numGrid, 3);
-                bId += numGrid;
-            }
-        }
-        if (bgp.PHASEP) {
-            for (USI j = 0; j < bgp.np; j++) {
-                out4vtk.OutputCELL_DATA_SCALARS(dest, "PHASEP-" + to_string(j), VTK_FLOAT, tmpVal, bId, numGrid, 3);
-                bId += numGrid;
-            }
-        }
-        if (bgp.SOIL) {
-            out4vtk.OutputCELL_DATA_SCALARS(dest, "SOIL", VTK_FLOAT, tmpVal, bId, numGrid, 6);
-            bId += numGrid;
-        }
-        if (bgp.SGAS) {
-            out4vtk.OutputCELL_DATA_SCALARS(dest, "SGAS", VTK_FLOAT, tmpVal, bId, numGrid, 6);
-            bId += numGrid;
-        }
-        if (bgp.SWAT) {
-            out4vtk.OutputCELL_DATA_SCALARS(dest, "SWAT", VTK_FLOAT, tmpVal, bId, numGrid, 6);
-            bId += numGrid;
-        }
-        if (bgp.CO2) {
-            out4vtk.OutputCELL_DATA_SCALARS(dest, "CO2", VTK_FLOAT, tmpVal, bId, numGrid, 6);
-            bId += numGrid;
-        }
-        if (bgp.SATNUM) {
-            out4vtk.OutputCELL_DATA_SCALARS(dest, "SATNUM", VTK_UNSIGNED_INT, tmpVal, bId, numGrid, 0);
-            bId += numGrid;
-        }
-        if (bgp.PERMX) {
-            out4vtk.OutputCELL_DATA_SCALARS(dest, "PERMX", VTK_FLOAT, tmpVal, bId, numGrid, 0);
-            bId += numGrid;
-        }
-        if (bgp.PERMY) {
-            out4vtk.OutputCELL_DATA_SCALARS(dest, "PERMY", VTK_FLOAT, tmpVal, bId, numGrid, 0);
-            bId += numGrid;
-        }
-        if (bgp.DSAT) {
-            for (USI j = 0; j < bgp.np; j++) {
-                out4vtk.OutputCELL_DATA_SCALARS(dest, "DS-" + to_string(j), VTK_FLOAT, tmpVal, bId, numGrid, 3);
-                bId += numGrid;
-            }
-        }
-        if (bgp.DP) {
-            for (USI j = 0; j < bgp.np; j++) {
-                out4vtk.OutputCELL_DATA_SCALARS(dest, "DP-" + to_string(j), VTK_FLOAT, tmpVal, bId, numGrid, 3);
-                bId += numGrid;
-            }
-        }
-        if (bgp.CSFLAG) {
-            out4vtk.OutputCELL_DATA_SCALARS(dest, "CSFLAG", VTK_INT, tmpVal, bId, numGrid, 0);
-            bId += numGrid;
-        }
-        if (bgp.ITERNRDDM) {
-            out4vtk.OutputCELL_DATA_SCALARS(dest, "ITERNRDDM", VTK_INT, tmpVal, bId, numGrid, 0);
-            bId += numGrid;
-        }
-        if (bgp.ITERLSDDM) {
-            out4vtk.OutputCELL_DATA_SCALARS(dest, "ITERLSDDM", VTK_INT, tmpVal, bId, numGrid, 0);
-            bId += numGrid;
-        }
-        if (bgp.TIMELSDDM) {
-            out4vtk.OutputCELL_DATA_SCALARS(dest, "TIMELSDDM", VTK_FLOAT, tmpVal, bId, numGrid, 0);
-            bId += numGrid;
-        }
-
+        OutputCellData(dest, tmpVal);
         dest.close();
     }
 
@@ -2170,8 +2340,12 @@ void OCPOutput::Setup(const ParamOutput& paramOutput, const OCPControl& ctrl, co
     SetupComm(rs.GetDomain());
 
     summary.Setup(paramOutput.summary, rs);
-    out4VTK.Setup(paramOutput.outVTKParam, workDir, rs);
+    if (ctrl.summaryBin) {
+        summary.SetupBinary(workDir, myComm);
+    }
+    out4VTK.Setup(paramOutput.outVTKParam, ctrl, workDir, rs);
     crtInfo.Setup();
+    perfLog.Setup(workDir, ctrl.perfLogFmt, myComm);
     if (CURRENT_RANK == MASTER_PROCESS) {
         OCP_INFO("Input Output Params -- end");
     }
@@ -2188,12 +2362,15 @@ void OCPOutput::SetupComm(const Domain& domain)
 
 void OCPOutput::SetValAtTimeStep(const Reservoir& rs, const OCPControl& ctrl, const OCPNRsuite& NR, GetWallTime& timer_total)
 {
+    OCP_PROFILE("Summary");
     GetWallTime timer;
     timer.Start();
 
     iters.Update(NR);
     summary.SetVal(rs, ctrl, iters, timer_total);
+    summary.PrintBinary();
     crtInfo.SetVal(ctrl, NR);
+    perfLog.SetVal(ctrl, NR, iters, timer_total.Stop());
 
     OCPTIME_OUTPUT += timer.Stop();
 }
@@ -2213,6 +2390,7 @@ void OCPOutput::PrintInfoSched(const Reservoir&  rs,
                                const OCPControl& ctrl,
                                const OCP_DBL&    runtime) const
 {
+    OCP_PROFILE("OutputTSTEP");
     OCP_DBL time = ctrl.time.GetCurrentTime();
 
     // print timing info on the screen
@@ -2227,6 +2405,9 @@ void OCPOutput::PrintInfoSched(const Reservoir&  rs,
     timer.Start();
     //out4RPT.PrintRPT(workDir, rs, days);
     out4VTK.PrintVTK(rs, ctrl);
+    if (!ctrl.vwgtOutFile.empty()) {
+        rs.GetBulk().GetFlashCost().PrintVertexWeight(ctrl.vwgtOutFile, rs.GetDomain());
+    }
     OCPTIME_OUTPUT += timer.Stop();
 }
 
@@ -2259,9 +2440,7 @@ void OCPOutput::PostProcess() const
     file_myrank = myrank;
     summary.PostProcess(workDir, fileName, numproc);
     crtInfo.PostProcess(workDir, fileName, numproc, iters);
-    if (myrank == MASTER_PROCESS) {
-        out4VTK.PostProcess(workDir, fileName, numproc);
-    }
+    out4VTK.PostProcess(workDir, fileName, numproc);
 
 
     OCPTIME_OUTPUT += timer.Stop();
@@ -0,0 +1,160 @@
+/*! \file    OCPProfiler.cpp
+ *  \brief   OCPProfiler class definition
+ *  \author  Shizhe Li
+ *  \date    Oct/16/2026
+ *
+ *-----------------------------------------------------------------------------------
+ *  Copyright (C) 2021--present by the OpenCAEPoroX team. All rights reserved.
+ *  Released under the terms of the GNU Lesser General Public License 3.0 or later.
+ *-----------------------------------------------------------------------------------
+ */
+
+#include "OCPProfiler.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <functional>
+
+
+OCPProfiler OCP_PROFILER;
+
+
+void OCPProfiler::Enable(const OCP_BOOL& ifTrace)
+{
+    enabled   = OCP_TRUE;
+    trace     = ifTrace;
+    regions.clear();
+    regions.push_back(Region("Total", 0));
+    stack.assign(1, 0);
+    startTime = Clock::now();
+    beginTime.assign(1, startTime);
+    events.clear();
+}
+
+
+USI OCPProfiler::GetChild(const char* name)
+{
+    const USI cur = stack.back();
+    for (const auto& c : regions[cur].child) {
+        // names are literals, so pointers are compared first
+        if (regions[c].name == name || strcmp(regions[c].name, name) == 0) {
+            return c;
+        }
+    }
+    regions.push_back(Region(name, cur));
+    regions[cur].child.push_back(regions.size() - 1);
+    return regions.size() - 1;
+}
+
+
+void OCPProfiler::Begin(const char* name)
+{
+    stack.push_back(GetChild(name));
+    beginTime.push_back(Clock::now());
+}
+
+
+void OCPProfiler::End()
+{
+    OCP_ASSERT(stack.size() > 1, "Unmatched profiler region!");
+
+    const auto    endTime = Clock::now();
+    const OCP_DBL dur     = std::chrono::duration<OCP_DBL>(endTime - beginTime.back()).count();
+
+    Region& r = regions[stack.back()];
+    if (r.count == 0) {
+        r.minT = r.maxT = dur;
+    } else {
+        r.minT = OCP_MIN(r.minT, dur);
+        r.maxT = OCP_MAX(r.maxT, dur);
+    }
+    r.count++;
+    r.total += dur;
+
+    if (trace && events.size() < maxEvents) {
+        const OCP_DBL begin =
+            std::chrono::duration<OCP_DBL, std::micro>(beginTime.back() - startTime).count();
+        events.push_back(Event(stack.back(), begin, dur * 1E6));
+    }
+
+    stack.pop_back();
+    beginTime.pop_back();
+}
+
+
+void OCPProfiler::Output(const string& dir, const OCP_INT& rank) const
+{
+    if (!enabled) return;
+
+    OutputTable(dir + "profile_p" + to_string(rank) + ".out");
+    if (trace) {
+        OutputTrace(dir + "profile_p" + to_string(rank) + ".json", rank);
+    }
+}
+
+
+void OCPProfiler::OutputTable(const string& file) const
+{
+    ofstream outF(file);
+    if (!outF.is_open()) {
+        OCP_WARNING("Can not open " + file);
+        return;
+    }
+
+    const OCP_DBL totalT =
+        std::chrono::duration<OCP_DBL>(Clock::now() - startTime).count();
+
+    outF << left << setw(48) << "Region" << right << setw(12) << "Count" << setw(14)
+         << "Total(s)" << setw(10) << "%" << setw(14) << "Avg(s)" << setw(14)
+         << "Min(s)" << setw(14) << "Max(s)" << "\n";
+    outF << string(126, '-') << "\n";
+
+    // depth first, children in the order of first call
+    function<void(const USI&, const USI&)> PrintRegion = [&](const USI& id, const USI& depth) {
+        const Region& r    = regions[id];
+        const OCP_DBL time = id == 0 ? totalT : r.total;
+        outF << left << setw(48) << string(2 * depth, ' ') + r.name << right << setw(12)
+             << (id == 0 ? 1 : r.count) << fixed << setprecision(4) << setw(14) << time
+             << setprecision(2) << setw(10) << 100 * time / totalT << setprecision(6)
+             << setw(14) << (id == 0 ? time : r.total / r.count) << setw(14)
+             << (id == 0 ? time : r.minT) << setw(14) << (id == 0 ? time : r.maxT) << "\n";
+        for (const auto& c : r.child) PrintRegion(c, depth + 1);
+    };
+    PrintRegion(0, 0);
+
+    if (events.size() >= maxEvents) {
+        outF << "\nTrace is truncated after " << maxEvents << " events\n";
+    }
+}
+
+
+void OCPProfiler::OutputTrace(const string& file, const OCP_INT& rank) const
+{
+    ofstream outF(file);
+    if (!outF.is_open()) {
+        OCP_WARNING("Can not open " + file);
+        return;
+    }
+
+    // names are from the source code, no escape is needed
+    outF << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    outF << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << rank
+         << ",\"args\":{\"name\":\"rank " << rank << "\"}}";
+    outF << fixed << setprecision(3);
+    for (const auto& e : events) {
+        outF << ",\n{\"name\":\"" << regions[e.region].name
+             << "\",\"cat\":\"OCP\",\"ph\":\"X\",\"pid\":" << rank << ",\"tid\":0,\"ts\":"
+             << e.begin << ",\"dur\":" << e.dur << "}";
+    }
+    outF << "\n]}\n";
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*  Brief Change History of This File                                         */
+/*----------------------------------------------------------------------------*/
+/*  Author              Date             Actions                              */
+/*----------------------------------------------------------------------------*/
+/*  Shizhe Li           Oct/16/2026      Create file                          */
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,147 @@
+/*! \file    OCPSummaryBin.cpp
+ *  \brief   OCPSummaryBin class declaration
+ *  \author  Shizhe Li
+ *  \date    Oct/16/2026
+ *
+ *-----------------------------------------------------------------------------------
+ *  Copyright (C) 2021--present by the OpenCAEPoroX team. All rights reserved.
+ *  Released under the terms of the GNU Lesser General Public License 3.0 or later.
+ *-----------------------------------------------------------------------------------
+ */
+
+#include "OCPSummaryBin.hpp"
+
+#include <algorithm>
+
+
+static const char SUMBIN_MAGIC[8] = { 'O', 'C', 'P', 'S', 'U', 'M', 'B', '1' };
+
+
+static void WriteString(ofstream& outF, const string& str)
+{
+    const uint32_t len = str.size();
+    outF.write(reinterpret_cast<const char*>(&len), sizeof(len));
+    outF.write(str.data(), len);
+}
+
+
+static OCP_BOOL ReadString(ifstream& inF, string& str)
+{
+    uint32_t len;
+    inF.read(reinterpret_cast<char*>(&len), sizeof(len));
+    if (!inF) return OCP_FALSE;
+    str.resize(len);
+    inF.read(&str[0], len);
+    return static_cast<OCP_BOOL>(inF.good());
+}
+
+
+/////////////////////////////////////////////////////////////////////
+// Binary Summary Writer
+/////////////////////////////////////////////////////////////////////
+
+
+void SummaryBinWriter::Open(const string& file, const vector<SumBinItem>& items)
+{
+    outF.open(file, ios::out | ios::binary | ios::trunc);
+    if (!outF.is_open()) {
+        OCP_WARNING("Can not open " + file);
+        return;
+    }
+
+    numItem = items.size();
+    const uint32_t num = numItem;
+    outF.write(SUMBIN_MAGIC, sizeof(SUMBIN_MAGIC));
+    outF.write(reinterpret_cast<const char*>(&num), sizeof(num));
+    for (const auto& s : items) {
+        WriteString(outF, s.Item);
+        WriteString(outF, s.Obj);
+        WriteString(outF, s.Unit);
+    }
+    outF.flush();
+}
+
+
+void SummaryBinWriter::Write(const vector<OCP_DBL>& record)
+{
+    if (!outF.is_open()) return;
+
+    OCP_ASSERT(record.size() == numItem, "Wrong record length!");
+    outF.write(reinterpret_cast<const char*>(record.data()), numItem * sizeof(OCP_DBL));
+    // records are visible to readers during the run
+    outF.flush();
+}
+
+
+/////////////////////////////////////////////////////////////////////
+// Binary Summary Reader
+/////////////////////////////////////////////////////////////////////
+
+
+OCP_BOOL SummaryBinReader::Open(const string& file)
+{
+    inF.open(file, ios::in | ios::binary);
+    if (!inF.is_open()) {
+        OCP_WARNING("Can not open " + file);
+        return OCP_FALSE;
+    }
+
+    char magic[sizeof(SUMBIN_MAGIC)];
+    inF.read(magic, sizeof(magic));
+    if (!inF || !equal(magic, magic + sizeof(magic), SUMBIN_MAGIC)) {
+        OCP_WARNING(file + " is not a binary summary file");
+        return OCP_FALSE;
+    }
+
+    uint32_t num;
+    inF.read(reinterpret_cast<char*>(&num), sizeof(num));
+    items.resize(num);
+    for (auto& s : items) {
+        if (!ReadString(inF, s.Item) || !ReadString(inF, s.Obj) || !ReadString(inF, s.Unit)) {
+            OCP_WARNING("Header of " + file + " is incomplete");
+            return OCP_FALSE;
+        }
+    }
+    headLen = inF.tellg();
+
+    inF.seekg(0, ios::end);
+    const streamoff recordLen = num * sizeof(OCP_DBL);
+    numRecord = recordLen > 0 ? (inF.tellg() - headLen) / recordLen : 0;
+    return OCP_TRUE;
+}
+
+
+OCP_INT SummaryBinReader::FindItem(const string& item, const string& obj) const
+{
+    for (USI i = 0; i < items.size(); i++) {
+        if (items[i].Item == item && (obj.empty() || items[i].Obj == obj)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+
+void SummaryBinReader::ReadColumns(const vector<USI>& cols, vector<vector<OCP_DBL>>& vals)
+{
+    vals.assign(cols.size(), vector<OCP_DBL>(numRecord));
+
+    const streamoff recordLen = items.size() * sizeof(OCP_DBL);
+    inF.clear();
+    for (uint64_t r = 0; r < numRecord; r++) {
+        const streamoff rBegin = headLen + r * recordLen;
+        for (USI c = 0; c < cols.size(); c++) {
+            inF.seekg(rBegin + cols[c] * sizeof(OCP_DBL), ios::beg);
+            inF.read(reinterpret_cast<char*>(&vals[c][r]), sizeof(OCP_DBL));
+        }
+    }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*  Brief Change History of This File                                         */
+/*----------------------------------------------------------------------------*/
+/*  Author              Date             Actions                              */
+/*----------------------------------------------------------------------------*/
+/*  Shizhe Li           Oct/16/2026      Create file                          */
+/*----------------------------------------------------------------------------*/
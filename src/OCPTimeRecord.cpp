@@ -35,6 +35,7 @@ OCP_DBL OCPTIME_LSOLVER_DDM           = 0;
 OCP_USI OCPITER_NR_DDM                = 0;
 OCP_USI OCPITER_NRW_DDM               = 0;
 OCP_USI OCPITER_LS_DDM                = 0;
+OCP_USI OCPITER_SFI_FIM               = 0;
 
  /*----------------------------------------------------------------------------*/
  /*  Brief Change History of This File                                         */
@@ -11,9 +11,42 @@
 
 #include "Output4Vtk.hpp"
 
+#include <cstdint>
+#include <sstream>
+#include <iomanip>
+#include <type_traits>
+
 const string Output4Vtk::tmpFile = "grid.tmpinfo";
 
 
+/// Name of data type in vtu files
+template <typename T>
+static string VtuTypeName()
+{
+    if (is_floating_point<T>::value) {
+        return sizeof(T) == 4 ? "Float32" : "Float64";
+    }
+    else {
+        return (is_signed<T>::value ? "Int" : "UInt") + to_string(8 * sizeof(T));
+    }
+}
+
+
+static string VtuByteOrder()
+{
+    const uint16_t one = 1;
+    return *reinterpret_cast<const char*>(&one) == 1 ? "LittleEndian" : "BigEndian";
+}
+
+
+template <typename T>
+static void AppendRawData(vector<char>& dst, const T* src, const OCP_ULL& len)
+{
+    const char* ptr = reinterpret_cast<const char*>(src);
+    dst.insert(dst.end(), ptr, ptr + len * sizeof(T));
+}
+
+
 void Output4Vtk::Setup(const OCP_BOOL& ascii, const OCP_BOOL& use_dbl)
 {
     ifASCII  = ascii;
@@ -180,6 +213,250 @@ void Output4Vtk::InputGridInfo(const string& dir, OCP_ULL& nG, OCP_ULL& nP, vect
 }
 
 
+void Output4Vtk::ScatterGridInfo(const string& dir, const vector<OCP_ULL>& gIndex, const OCP_ULL& nG,
+                                 const MPI_Comm& comm, VtuPiece& piece) const
+{
+    OCP_INT numproc, myrank;
+    MPI_Comm_size(comm, &numproc);
+    MPI_Comm_rank(comm, &myrank);
+
+    // global index of grids owned by each process
+    const OCP_INT   sendLen = nG;
+    vector<OCP_INT> recvLen;
+    vector<OCP_INT> displs;
+    vector<OCP_ULL> recvBuf;
+    if (myrank == MASTER_PROCESS) {
+        recvLen.resize(numproc);
+        displs.resize(numproc + 1, 0);
+    }
+    MPI_Gather(&sendLen, 1, OCPMPI_INT, recvLen.data(), 1, OCPMPI_INT, MASTER_PROCESS, comm);
+    if (myrank == MASTER_PROCESS) {
+        for (OCP_INT p = 0; p < numproc; p++) {
+            displs[p + 1] = displs[p] + recvLen[p];
+        }
+        recvBuf.resize(displs[numproc]);
+    }
+    MPI_Gatherv(gIndex.data(), sendLen, OCPMPI_ULL, recvBuf.data(), recvLen.data(),
+                displs.data(), OCPMPI_ULL, MASTER_PROCESS, comm);
+
+    OCP_ULL len[3];
+    if (myrank == MASTER_PROCESS) {
+        OCP_ULL numGrid, nP;
+        vector<OCP_SIN> points_xyz;
+        vector<OCP_ULL> cell_points;
+        vector<USI>     cell_type;
+        InputGridInfo(dir, numGrid, nP, points_xyz, cell_points, cell_type);
+
+        // begin of each cell in cell_points
+        vector<OCP_ULL> cellBegin(numGrid);
+        for (OCP_ULL n = 0, iterC = 0; n < numGrid; n++) {
+            cellBegin[n] = iterC;
+            iterC       += cell_points[iterC] + 1;
+        }
+
+        vector<OCP_SLL> pMap(nP, -1);
+        vector<OCP_ULL> pUsed;
+        VtuPiece        tmpPiece;
+        for (OCP_INT p = 0; p < numproc; p++) {
+            VtuPiece& dst = (p == MASTER_PROCESS ? piece : tmpPiece);
+            dst.points.clear();
+            dst.connectivity.clear();
+            dst.offsets.clear();
+            dst.types.clear();
+            pUsed.clear();
+
+            for (OCP_INT i = displs[p]; i < displs[p + 1]; i++) {
+                const OCP_ULL  g  = recvBuf[i];
+                const OCP_ULL* cp = &cell_points[cellBegin[g]];
+                for (OCP_ULL k = 1; k <= cp[0]; k++) {
+                    const OCP_ULL pId = cp[k];
+                    if (pMap[pId] < 0) {
+                        pMap[pId] = pUsed.size();
+                        pUsed.push_back(pId);
+                        dst.points.insert(dst.points.end(), &points_xyz[3 * pId], &points_xyz[3 * pId] + 3);
+                    }
+                    dst.connectivity.push_back(pMap[pId]);
+                }
+                dst.offsets.push_back(dst.connectivity.size());
+                dst.types.push_back(cell_type[g]);
+            }
+            for (const auto& pId : pUsed)  pMap[pId] = -1;
+
+            if (p != MASTER_PROCESS) {
+                len[0] = dst.points.size();
+                len[1] = dst.connectivity.size();
+                len[2] = dst.offsets.size();
+                MPI_Send(len, 3, OCPMPI_ULL, p, 0, comm);
+                MPI_Send(dst.points.data(), len[0], MPI_FLOAT, p, 1, comm);
+                MPI_Send(dst.connectivity.data(), len[1], OCPMPI_ULL, p, 2, comm);
+                MPI_Send(dst.offsets.data(), len[2], OCPMPI_ULL, p, 3, comm);
+                MPI_Send(dst.types.data(), len[2], OCPMPI_USI, p, 4, comm);
+            }
+        }
+    }
+    else {
+        MPI_Recv(len, 3, OCPMPI_ULL, MASTER_PROCESS, 0, comm, MPI_STATUS_IGNORE);
+        piece.points.resize(len[0]);
+        piece.connectivity.resize(len[1]);
+        piece.offsets.resize(len[2]);
+        piece.types.resize(len[2]);
+        MPI_Recv(piece.points.data(), len[0], MPI_FLOAT, MASTER_PROCESS, 1, comm, MPI_STATUS_IGNORE);
+        MPI_Recv(piece.connectivity.data(), len[1], OCPMPI_ULL, MASTER_PROCESS, 2, comm, MPI_STATUS_IGNORE);
+        MPI_Recv(piece.offsets.data(), len[2], OCPMPI_ULL, MASTER_PROCESS, 3, comm, MPI_STATUS_IGNORE);
+        MPI_Recv(piece.types.data(), len[2], OCPMPI_USI, MASTER_PROCESS, 4, comm, MPI_STATUS_IGNORE);
+    }
+}
+
+
+void Output4Vtk::AddCellArray(vector<VtuArray>& cellData, const string& dataName, string dataType,
+                              const vector<OCP_DBL>& tmpV, const OCP_ULL& nb) const
+{
+    cellData.push_back(VtuArray());
+    VtuArray& dst = cellData.back();
+    dst.name      = dataName;
+
+    if (dataType == VTK_FLOAT) {
+        if (ifDOUBLE) {
+            dst.type = VtuTypeName<OCP_DBL>();
+            AppendRawData(dst.data, tmpV.data(), nb);
+        }
+        else {
+            dst.type = VtuTypeName<OCP_SIN>();
+            dst.data.resize(nb * sizeof(OCP_SIN));
+            OCP_SIN* wptr = reinterpret_cast<OCP_SIN*>(dst.data.data());
+            for (OCP_ULL n = 0; n < nb; n++)  wptr[n] = static_cast<OCP_SIN>(tmpV[n]);
+        }
+    }
+    else if (dataType == VTK_UNSIGNED_INT) {
+        dst.type = VtuTypeName<USI>();
+        dst.data.resize(nb * sizeof(USI));
+        USI* wptr = reinterpret_cast<USI*>(dst.data.data());
+        for (OCP_ULL n = 0; n < nb; n++)  wptr[n] = static_cast<USI>(tmpV[n]);
+    }
+    else if (dataType == VTK_INT) {
+        dst.type = VtuTypeName<INT>();
+        dst.data.resize(nb * sizeof(INT));
+        INT* wptr = reinterpret_cast<INT*>(dst.data.data());
+        for (OCP_ULL n = 0; n < nb; n++)  wptr[n] = static_cast<INT>(tmpV[n]);
+    }
+    else {
+        OCP_ABORT("unknown data type!");
+    }
+}
+
+
+void Output4Vtk::OutputVTU(const string& myFile, const VtuPiece& piece, const vector<VtuArray>& cellData)
+{
+    ofstream outVtu(myFile, ios::out | ios::binary);
+    if (!outVtu.is_open()) {
+        OCP_WARNING("Can not open " + myFile);
+        return;
+    }
+
+    const OCP_ULL nP = piece.points.size() / 3;
+    const OCP_ULL nG = piece.offsets.size();
+    vector<uint8_t> types(piece.types.begin(), piece.types.end());
+
+    // offset of each appended block, every block begins with its length in bytes
+    uint64_t offset = 0;
+    auto dataArray = [&outVtu, &offset](const string& type, const string& name, const USI& ncomp, const uint64_t& bytes) {
+        outVtu << "        <DataArray type=\"" << type << "\"";
+        if (!name.empty())  outVtu << " Name=\"" << name << "\"";
+        if (ncomp > 1)      outVtu << " NumberOfComponents=\"" << ncomp << "\"";
+        outVtu << " format=\"appended\" offset=\"" << offset << "\"/>\n";
+        offset += sizeof(uint64_t) + bytes;
+    };
+
+    outVtu << "<?xml version=\"1.0\"?>\n";
+    outVtu << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\"" << VtuByteOrder()
+           << "\" header_type=\"UInt64\">\n";
+    outVtu << "  <UnstructuredGrid>\n";
+    outVtu << "    <Piece NumberOfPoints=\"" << nP << "\" NumberOfCells=\"" << nG << "\">\n";
+    outVtu << "      <Points>\n";
+    dataArray(VtuTypeName<OCP_SIN>(), "", 3, piece.points.size() * sizeof(OCP_SIN));
+    outVtu << "      </Points>\n";
+    outVtu << "      <Cells>\n";
+    dataArray(VtuTypeName<OCP_ULL>(), "connectivity", 1, piece.connectivity.size() * sizeof(OCP_ULL));
+    dataArray(VtuTypeName<OCP_ULL>(), "offsets", 1, piece.offsets.size() * sizeof(OCP_ULL));
+    dataArray(VtuTypeName<uint8_t>(), "types", 1, types.size() * sizeof(uint8_t));
+    outVtu << "      </Cells>\n";
+    outVtu << "      <CellData>\n";
+    for (const auto& c : cellData) {
+        dataArray(c.type, c.name, 1, c.data.size());
+    }
+    outVtu << "      </CellData>\n";
+    outVtu << "    </Piece>\n";
+    outVtu << "  </UnstructuredGrid>\n";
+    outVtu << "  <AppendedData encoding=\"raw\">\n_";
+
+    auto rawBlock = [&outVtu](const void* data, const uint64_t& bytes) {
+        outVtu.write(reinterpret_cast<const char*>(&bytes), sizeof(bytes));
+        outVtu.write(reinterpret_cast<const char*>(data), bytes);
+    };
+    rawBlock(piece.points.data(), piece.points.size() * sizeof(OCP_SIN));
+    rawBlock(piece.connectivity.data(), piece.connectivity.size() * sizeof(OCP_ULL));
+    rawBlock(piece.offsets.data(), piece.offsets.size() * sizeof(OCP_ULL));
+    rawBlock(types.data(), types.size() * sizeof(uint8_t));
+    for (const auto& c : cellData) {
+        rawBlock(c.data.data(), c.data.size());
+    }
+
+    outVtu << "\n  </AppendedData>\n";
+    outVtu << "</VTKFile>\n";
+    outVtu.close();
+}
+
+
+void Output4Vtk::OutputPVTU(const string& myFile, const vector<string>& pieces, const vector<VtuArray>& cellData)
+{
+    ofstream outVtu(myFile);
+    if (!outVtu.is_open()) {
+        OCP_WARNING("Can not open " + myFile);
+        return;
+    }
+
+    outVtu << "<?xml version=\"1.0\"?>\n";
+    outVtu << "<VTKFile type=\"PUnstructuredGrid\" version=\"1.0\" byte_order=\"" << VtuByteOrder()
+           << "\" header_type=\"UInt64\">\n";
+    outVtu << "  <PUnstructuredGrid GhostLevel=\"0\">\n";
+    outVtu << "    <PPoints>\n";
+    outVtu << "      <PDataArray type=\"" << VtuTypeName<OCP_SIN>() << "\" NumberOfComponents=\"3\"/>\n";
+    outVtu << "    </PPoints>\n";
+    outVtu << "    <PCellData>\n";
+    for (const auto& c : cellData) {
+        outVtu << "      <PDataArray type=\"" << c.type << "\" Name=\"" << c.name << "\"/>\n";
+    }
+    outVtu << "    </PCellData>\n";
+    for (const auto& p : pieces) {
+        outVtu << "    <Piece Source=\"" << p << "\"/>\n";
+    }
+    outVtu << "  </PUnstructuredGrid>\n";
+    outVtu << "</VTKFile>\n";
+    outVtu.close();
+}
+
+
+void Output4Vtk::OutputPVD(const string& myFile, const vector<pair<OCP_DBL, string>>& series)
+{
+    ofstream outVtu(myFile);
+    if (!outVtu.is_open()) {
+        OCP_WARNING("Can not open " + myFile);
+        return;
+    }
+
+    outVtu << "<?xml version=\"1.0\"?>\n";
+    outVtu << "<VTKFile type=\"Collection\" version=\"0.1\" byte_order=\"" << VtuByteOrder() << "\">\n";
+    outVtu << "  <Collection>\n";
+    for (const auto& s : series) {
+        outVtu << "    <DataSet timestep=\"" << setprecision(12) << s.first
+               << "\" group=\"\" part=\"0\" file=\"" << s.second << "\"/>\n";
+    }
+    outVtu << "  </Collection>\n";
+    outVtu << "</VTKFile>\n";
+    outVtu.close();
+}
+
+
 /*----------------------------------------------------------------------------*/
 /*  Brief Change History of This File                                         */
 /*----------------------------------------------------------------------------*/
@@ -103,12 +103,46 @@ void ParamControl::InputMETHOD(ifstream& ifs)
         method[0] = vbuf[0];
         lsFile[0] = vbuf[1];
     }
+    // SFI: linear solver of transport stage
+    if (vbuf.size() == 3) {
+        lsFileT = vbuf[2];
+    }
     // preconditioner exists
     if (vbuf.size() >= 4) {
         method.push_back(vbuf[2]);
         lsFile.push_back(vbuf[3]);
     }
 
+    // params of methods, one in a line until '/'
+    while (vbuf.back() != "/" && ReadLine(ifs, vbuf)) {
+        if (vbuf[0] == "/") break;
+        if (vbuf.size() < 2 || vbuf[1] == "/") {
+            OCP_ABORT("No value of " + vbuf[0] + " in METHOD!");
+        }
+
+        switch (Map_Str2Int(&vbuf[0][0], vbuf[0].size())) {
+            case Map_Str2Int("AIMCFL", 6):
+                aimCFL[0] = stod(vbuf[1]);
+                aimCFL[1] = (vbuf.size() > 2 && vbuf[2] != "/") ? stod(vbuf[2]) : aimCFL[0];
+                if (aimCFL[1] > aimCFL[0] || aimCFL[1] < 0) {
+                    OCP_ABORT("Wrong AIMCFL in METHOD!");
+                }
+                break;
+
+            case Map_Str2Int("AIMVE", 5):
+                aimVe = stod(vbuf[1]);
+                break;
+
+            case Map_Str2Int("AIMLAYER", 8):
+                aimLayer = OCP_MAX(stoi(vbuf[1]), 0);
+                break;
+
+            default:
+                OCP_ABORT("Unknown param " + vbuf[0] + " in METHOD!");
+                break;
+        }
+    }
+
     if (CURRENT_RANK == MASTER_PROCESS && PRINTINPUT) {
         cout << "\n---------------------" << endl
             << "METHOD"
@@ -116,7 +150,11 @@ void ParamControl::InputMETHOD(ifstream& ifs)
         for (USI i = 0; i < method.size(); i++) {
             cout << method[i] << "  " << lsFile[i] << "  ";
         }
+        cout << lsFileT;
         cout << endl;
+        cout << "AIMCFL    " << aimCFL[0] << "  " << aimCFL[1] << endl;
+        cout << "AIMVE     " << aimVe << endl;
+        cout << "AIMLAYER  " << aimLayer << endl;
     }
 }
 
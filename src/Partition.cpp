@@ -28,6 +28,12 @@ void Partition::SetPartition(const PreParamGridWell& grid)
 		return;
 	}
 	
+	if (grid.IfDistInput()) {
+		SetInitGraphDist(grid);
+		CalPartition(grid);
+		return;
+	}
+
 	if (CURRENT_RANK == MASTER_PROCESS)
 		OCP_INFO("Set Initial Partition -- begin");
 
@@ -131,6 +137,56 @@ void Partition::SetPartition(const PreParamGridWell& grid)
 }
 
 
+void Partition::SetInitGraphDist(const PreParamGridWell& grid)
+{
+	if (CURRENT_RANK == MASTER_PROCESS)
+		OCP_INFO("Set Initial Partition by All Processes -- begin");
+
+	///////////////////////////////////////////////////////
+	// Calculate vtxdist, each process owns the active grids
+	// in its slab, wells belong to the last process
+	///////////////////////////////////////////////////////
+
+	numElementLocal = grid.gNeighbor.size();
+	vtxdist         = new idx_t[numproc + 2]();
+	MPI_Allgather(&numElementLocal, 1, IDX_T, vtxdist + 1, 1, IDX_T, myComm);
+	for (OCP_INT p = 0; p < numproc; p++) {
+		if (vtxdist[p + 1] == 0) {
+			OCP_ABORT("No active grid in process " + to_string(p) + ", try fewer processes!");
+		}
+		vtxdist[p + 1] += vtxdist[p];
+	}
+	vtxdist[numproc + 1] = grid.numWell;
+
+	numElementTotal = vtxdist[numproc];
+	numWellTotal    = vtxdist[numproc + 1];
+
+	///////////////////////////////////////////////////////
+	// Calculate xadj adjncy adjwgt from local connections
+	///////////////////////////////////////////////////////
+
+	numEdgesLocal = 0;
+	for (const auto& gn : grid.gNeighbor) {
+		numEdgesLocal += gn.size();
+	}
+
+	xadj   = new idx_t[numElementLocal + 1 + 2 * numEdgesLocal](); // zero is first
+	adjncy = xadj + numElementLocal + 1;
+	adjwgt = adjncy + numEdgesLocal;
+	for (idx_t n = 0; n < numElementLocal; n++) {
+		const vector<ConnPair>& gNeigh = grid.gNeighbor[n];
+		xadj[n + 1] = xadj[n] + gNeigh.size();
+		for (USI i = 0; i < gNeigh.size(); i++) {
+			adjncy[xadj[n] + i] = gNeigh[i].ID();
+			adjwgt[xadj[n] + i] = gNeigh[i].WGT();
+		}
+	}
+
+	if (CURRENT_RANK == MASTER_PROCESS)
+		OCP_INFO("Set Initial Partition by All Processes -- end");
+}
+
+
 void Partition::CalPartition(const PreParamGridWell& grid)
 {
 	GetWallTime timer;
@@ -243,11 +299,35 @@ void Partition::CalPartitionParMetis()
 	}
 
 	InitParam();
-	ParMETIS_V3_PartKway(vtxdist, xadj, adjncy, vwgt, adjwgt, &wgtflag, &numflag, &ncon,
-		&nparts, tpwgts, &ubvec, options, &edgecut, part, &myComm);
+
+	if (!ptnInFile.empty()) {
+		ReadExternalPartition();
+	}
+	else {
+		// cached partition is keyed by the graph and the num of processes
+		string   cacheFile;
+		OCP_BOOL ifCached = OCP_FALSE;
+		uint64_t key      = 0;
+		if (!ptnCacheDir.empty()) {
+			key = CalGraphHash();
+			ostringstream name;
+			name << ptnCacheDir << "/ptn_" << hex << setw(16) << setfill('0') << key
+				 << dec << "_np" << numproc << ".bin";
+			cacheFile = name.str();
+			ifCached  = ReadCachedPartition(cacheFile, key);
+		}
+		if (!ifCached) {
+			ParMETIS_V3_PartKway(vtxdist, xadj, adjncy, vwgt, adjwgt, &wgtflag, &numflag, &ncon,
+				&nparts, tpwgts, &ubvec, options, &edgecut, part, &myComm);
+			if (!cacheFile.empty()) {
+				WriteCachedPartition(cacheFile, key);
+			}
+		}
+	}
 
 	delete[] tpwgts;
 	delete[] options;
+	vector<idx_t>().swap(vwgtLocal);
 
 	if (CURRENT_RANK == MASTER_PROCESS) {
 		OCP_INFO("ParMetis Partition -- end");
@@ -268,6 +348,211 @@ void Partition::InitParam()
 	ubvec   = 1.005;
 	options = new idx_t[3]();
 	part    = new idx_t[numElementLocal]();
+
+	if (!vwgtFile.empty()) {
+		SetVertexWeight();
+	}
+}
+
+
+void Partition::SetVertexWeight()
+{
+	const idx_t   numGrid = numElementTotal - numWellTotal;
+	const idx_t   end     = OCP_MIN(vtxdist[myrank + 1], numGrid);
+	const idx_t   begin   = OCP_MIN(vtxdist[myrank], end);
+	vector<OCP_INT> wgt;
+	OCP_INT flag = ReadVertexWeight(vwgtFile, numGrid, begin, end, wgt) ? 1 : 0;
+	// all processes use the weights, or none of them
+	MPI_Allreduce(MPI_IN_PLACE, &flag, 1, OCPMPI_INT, MPI_MIN, myComm);
+	if (flag == 0) {
+		if (CURRENT_RANK == MASTER_PROCESS) {
+			OCP_WARNING("Vertex weights are not used in partition");
+		}
+		return;
+	}
+
+	vwgtLocal.assign(numElementLocal, 1);
+	copy(wgt.begin(), wgt.end(), vwgtLocal.begin());
+	vwgt    = vwgtLocal.data();
+	wgtflag = 3;
+
+	if (CURRENT_RANK == MASTER_PROCESS) {
+		OCP_INFO("Vertex weights are read from " + vwgtFile);
+	}
+}
+
+
+uint64_t Partition::CalGraphHash() const
+{
+	// FNV-1a hash of each vertex, combined by XOR, which is independent of
+	// the distribution of vertices
+	auto fnv = [](uint64_t h, const uint64_t& v) {
+		for (USI b = 0; b < 8; b++) {
+			h ^= (v >> (8 * b)) & 0xff;
+			h *= 1099511628211ULL;
+		}
+		return h;
+	};
+
+	uint64_t keyLocal = 0;
+	for (idx_t i = 0; i < numElementLocal; i++) {
+		uint64_t h = 14695981039346656037ULL;
+		h = fnv(h, vtxdist[myrank] + i);
+		h = fnv(h, vwgt == nullptr ? 1 : vwgt[i]);
+		for (idx_t j = xadj[i]; j < xadj[i + 1]; j++) {
+			h = fnv(h, adjncy[j]);
+			h = fnv(h, adjwgt[j]);
+		}
+		keyLocal ^= h;
+	}
+	uint64_t key;
+	MPI_Allreduce(&keyLocal, &key, 1, MPI_UINT64_T, MPI_BXOR, myComm);
+	return fnv(key, numElementTotal);
+}
+
+
+OCP_BOOL Partition::ReadCachedPartition(const string& file, const uint64_t& key)
+{
+	OCP_INT flag = 1;
+
+	ifstream inF(file, ios::in | ios::binary);
+	if (!inF.is_open()) {
+		flag = 0;
+	}
+	else {
+		uint64_t keyF;
+		int32_t  numprocF;
+		int64_t  numElementF;
+		inF.read(reinterpret_cast<char*>(&keyF), sizeof(keyF));
+		inF.read(reinterpret_cast<char*>(&numprocF), sizeof(numprocF));
+		inF.read(reinterpret_cast<char*>(&numElementF), sizeof(numElementF));
+		if (!inF || keyF != key || numprocF != numproc || numElementF != numElementTotal) {
+			flag = 0;
+		}
+		else {
+			const auto     header = sizeof(keyF) + sizeof(numprocF) + sizeof(numElementF);
+			vector<int32_t> tmp(numElementLocal);
+			inF.seekg(header + vtxdist[myrank] * sizeof(int32_t), ios::beg);
+			inF.read(reinterpret_cast<char*>(tmp.data()), numElementLocal * sizeof(int32_t));
+			if (!inF)  flag = 0;
+			for (idx_t i = 0; i < numElementLocal && flag; i++) {
+				if (tmp[i] < 0 || tmp[i] >= numproc)  flag = 0;
+				part[i] = tmp[i];
+			}
+		}
+	}
+
+	MPI_Allreduce(MPI_IN_PLACE, &flag, 1, OCPMPI_INT, MPI_MIN, myComm);
+	if (CURRENT_RANK == MASTER_PROCESS && flag) {
+		OCP_INFO("Partition is read from " + file);
+	}
+	return flag == 1;
+}
+
+
+void Partition::WriteCachedPartition(const string& file, const uint64_t& key) const
+{
+	vector<OCP_INT> counts;
+	vector<OCP_INT> displs;
+	vector<idx_t>   gPart;
+	if (myrank == MASTER_PROCESS) {
+		counts.resize(numproc);
+		displs.resize(numproc);
+		for (OCP_INT p = 0; p < numproc; p++) {
+			displs[p] = vtxdist[p];
+			counts[p] = vtxdist[p + 1] - vtxdist[p];
+		}
+		gPart.resize(numElementTotal);
+	}
+	MPI_Gatherv(part, numElementLocal, IDX_T, gPart.data(), counts.data(), displs.data(),
+		        IDX_T, MASTER_PROCESS, myComm);
+
+	if (myrank != MASTER_PROCESS)  return;
+
+	ofstream outF(file, ios::out | ios::binary);
+	if (!outF.is_open()) {
+		OCP_WARNING("Can not open " + file + ", partition is not cached");
+		return;
+	}
+	const int32_t   numprocF    = numproc;
+	const int64_t   numElementF = numElementTotal;
+	vector<int32_t> tmp(gPart.begin(), gPart.end());
+	outF.write(reinterpret_cast<const char*>(&key), sizeof(key));
+	outF.write(reinterpret_cast<const char*>(&numprocF), sizeof(numprocF));
+	outF.write(reinterpret_cast<const char*>(&numElementF), sizeof(numElementF));
+	outF.write(reinterpret_cast<const char*>(tmp.data()), tmp.size() * sizeof(int32_t));
+	outF.close();
+
+	OCP_INFO("Partition is cached in " + file);
+}
+
+
+void Partition::ReadExternalPartition()
+{
+	const idx_t numGrid = numElementTotal - numWellTotal;
+
+	// master process reads the process id of each active grid in global order
+	vector<idx_t>   gPart;
+	vector<OCP_INT> counts;
+	vector<OCP_INT> displs;
+	if (myrank == MASTER_PROCESS) {
+		ifstream inF(ptnInFile);
+		if (!inF.is_open()) {
+			OCP_ABORT("Can not open " + ptnInFile);
+		}
+		gPart.reserve(numGrid);
+		idx_t p;
+		while (inF >> p) {
+			if (p < 0 || p >= numproc) {
+				OCP_ABORT("Wrong process id " + to_string(p) + " in " + ptnInFile);
+			}
+			gPart.push_back(p);
+		}
+		if (gPart.size() != static_cast<size_t>(numGrid)) {
+			OCP_ABORT("The num of entries in " + ptnInFile + " is " + to_string(gPart.size())
+				      + ", but the num of active grids is " + to_string(numGrid));
+		}
+		counts.resize(numproc);
+		displs.resize(numproc);
+		for (OCP_INT p = 0; p < numproc; p++) {
+			displs[p] = OCP_MIN(vtxdist[p], numGrid);
+			counts[p] = OCP_MIN(vtxdist[p + 1], numGrid) - displs[p];
+		}
+	}
+
+	// grids, which are placed in front of wells in each process
+	const idx_t numGridLocal = OCP_MIN(vtxdist[myrank + 1], numGrid) - OCP_MIN(vtxdist[myrank], numGrid);
+	MPI_Scatterv(gPart.data(), counts.data(), displs.data(), IDX_T, part, numGridLocal,
+		         IDX_T, MASTER_PROCESS, myComm);
+
+	// wells follow their first perforated grids
+	vector<idx_t> wellNeighbor;
+	for (idx_t i = numGridLocal; i < numElementLocal; i++) {
+		wellNeighbor.push_back(adjncy[xadj[i]]);
+	}
+	const OCP_INT numWellLocal = wellNeighbor.size();
+	if (myrank == MASTER_PROCESS) {
+		MPI_Gather(&numWellLocal, 1, OCPMPI_INT, counts.data(), 1, OCPMPI_INT, MASTER_PROCESS, myComm);
+		displs.assign(numproc + 1, 0);
+		for (OCP_INT p = 0; p < numproc; p++) {
+			displs[p + 1] = displs[p] + counts[p];
+		}
+	}
+	else {
+		MPI_Gather(&numWellLocal, 1, OCPMPI_INT, nullptr, 1, OCPMPI_INT, MASTER_PROCESS, myComm);
+	}
+	vector<idx_t> wellPart(myrank == MASTER_PROCESS ? displs[numproc] : 0);
+	MPI_Gatherv(wellNeighbor.data(), numWellLocal, IDX_T, wellPart.data(), counts.data(),
+		        displs.data(), IDX_T, MASTER_PROCESS, myComm);
+	for (auto& w : wellPart) {
+		w = gPart[w];
+	}
+	MPI_Scatterv(wellPart.data(), counts.data(), displs.data(), IDX_T, part + numGridLocal,
+		         numWellLocal, IDX_T, MASTER_PROCESS, myComm);
+
+	if (CURRENT_RANK == MASTER_PROCESS) {
+		OCP_INFO("Partition is read from " + ptnInFile);
+	}
 }
 
 
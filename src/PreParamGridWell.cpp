@@ -25,6 +25,25 @@ void PreParamGridWell::InputFile(const string& myFile, const string& myWorkdir)
 }
 
 
+void PreParamGridWell::InputFileDist(const string& myFile, const string& myWorkdir, MPI_Comm comm)
+{
+    if (CURRENT_RANK == MASTER_PROCESS) {
+        OCP_INFO("Input Grid File by All Processes -- begin");
+    }
+
+    distInput = OCP_TRUE;
+    distComm  = comm;
+    workdir   = myWorkdir;
+    Input(myFile);
+    CheckInput();
+    PostProcessInput();
+
+    if (CURRENT_RANK == MASTER_PROCESS) {
+        OCP_INFO("Input Grid File by All Processes -- end");
+    }
+}
+
+
 void PreParamGridWell::Input(const string& myFilename)
 {
     ifstream ifs(workdir + myFilename, ios::in);
@@ -32,7 +51,7 @@ void PreParamGridWell::Input(const string& myFilename)
         OCP_MESSAGE("Trying to open file: " << (workdir + myFilename));
         OCP_ABORT("Failed to open the input file!");
     }
-    else {
+    else if (CURRENT_RANK == MASTER_PROCESS) {
         cout << "Reading file: " << (workdir + myFilename) << endl;
     }
 
@@ -158,24 +177,34 @@ void PreParamGridWell::Input(const string& myFilename)
 
 void PreParamGridWell::CheckInput()
 {
-    cout << endl << "-------------------------------------" << endl;
-    cout << "Check Grid param ... begin" << endl;
+    if (CURRENT_RANK == MASTER_PROCESS) {
+        cout << endl << "-------------------------------------" << endl;
+        cout << "Check Grid param ... begin" << endl;
+    }
 
     if (model == OCPModel::none)           OCP_ABORT("WRONG MODEL!");
 
+    if (distInput) {
+        if (gridType != GridType::orthogonal)  OCP_ABORT("Only orthogonal grid is available for distributed input!");
+        if (DUALPORO)                          OCP_ABORT("DUALPORO is not available for distributed input!");
+        if (initR.type == InitType::PTN1)      OCP_ABORT("INITPTN1 is not available for distributed input!");
+        if (ifUseVtk)                          OCP_ABORT("VTKSCHED is not available for distributed input!");
+    }
+
+    const OCP_ULL nG = NumGridStored();
 
     if (gridType == GridType::corner) {
         if (nx == 0 || ny == 0 || nz == 0) OCP_ABORT("WRONG DIMENS!");
-        if (poro.size() != numGrid)        OCP_ABORT("WRONG PORO!");
+        if (poro.size() != nG)             OCP_ABORT("WRONG PORO!");
         if (zcorn.empty())                 OCP_ABORT("WRONG ZCORN!");
         if (coord.empty())                 OCP_ABORT("WRONG ZCORN!");
     }
     else if (gridType == GridType::orthogonal) {
         if (nx == 0 || ny == 0 || nz == 0) OCP_ABORT("WRONG DIMENS!");
-        if (poro.size() != numGrid)        OCP_ABORT("WRONG PORO!");
-        if (dx.size() != numGrid)          OCP_ABORT("WRONG DX!");
-        if (dy.size() != numGrid)          OCP_ABORT("WRONG DY!");
-        if (dz.size() != numGrid)          OCP_ABORT("WRONG DZ!");
+        if (poro.size() != nG)             OCP_ABORT("WRONG PORO!");
+        if (dx.size() != nG)               OCP_ABORT("WRONG DX!");
+        if (dy.size() != nG)               OCP_ABORT("WRONG DY!");
+        if (dz.size() != nG)               OCP_ABORT("WRONG DZ!");
         if (tops.size() != nx * ny)        OCP_ABORT("WRONG TOPS!");
     }
 #ifdef WITH_GMSH
@@ -186,32 +215,36 @@ void PreParamGridWell::CheckInput()
 #endif
     else                                  OCP_ABORT("WRONG Grid Type!");
 
-    cout << "Check Grid param ... done";
-    cout << endl << "-------------------------------------" << endl;
+    if (CURRENT_RANK == MASTER_PROCESS) {
+        cout << "Check Grid param ... done";
+        cout << endl << "-------------------------------------" << endl;
+    }
 }
 
 
 
 void PreParamGridWell::PostProcessInput()
 {
-    if (ntg.size() != numGrid) {
-        OCP_WARNING("NTG will be set to 1 !");
+    const OCP_ULL nG = NumGridStored();
+
+    if (ntg.size() != nG) {
+        if (CURRENT_RANK == MASTER_PROCESS)  OCP_WARNING("NTG will be set to 1 !");
         vector<OCP_DBL>().swap(ntg);
     }
     else {
-        for (OCP_ULL n = 0; n < numGrid; n++) {
+        for (OCP_ULL n = 0; n < nG; n++) {
             poro[n] *= ntg[n];
         }
     }
 
-    if (actGC.ACTNUM.size() != numGrid) {
-        OCP_WARNING("ACTNUM will be set to 1 !");
+    if (actGC.ACTNUM.size() != nG) {
+        if (CURRENT_RANK == MASTER_PROCESS)  OCP_WARNING("ACTNUM will be set to 1 !");
         vector<USI>().swap(actGC.ACTNUM);
         actGC.allAct = OCP_TRUE;
         
     }
-    if (!sigma.empty())  sigma.resize(numGrid, 0);
-    if (!dzMtrx.empty()) dzMtrx.resize(numGrid, 0);
+    if (!sigma.empty())  sigma.resize(nG, 0);
+    if (!dzMtrx.empty()) dzMtrx.resize(nG, 0);
 }
 
 
@@ -251,6 +284,23 @@ void PreParamGridWell::InputDIMENS(ifstream& ifs)
 
     numGrid = numGridM + numGridF;
 
+    if (distInput) {
+        // Each process owns a contiguous slab of grids (x -> y -> z), and also stores
+        // one layer above and below the slab for the connections across processes
+        OCP_INT numproc, myrank;
+        MPI_Comm_size(distComm, &numproc);
+        MPI_Comm_rank(distComm, &myrank);
+        const OCP_ULL nxny     = nx * ny;
+        const OCP_ULL numLocal = numGridM / numproc;
+        const OCP_ULL rest     = numGridM % numproc;
+        const OCP_ULL rank     = static_cast<OCP_ULL>(myrank);
+
+        slabBegin = rank * numLocal + (rank < rest ? rank : rest);
+        slabEnd   = slabBegin + numLocal + (rank < rest ? 1 : 0);
+        winBegin  = slabBegin > nxny ? slabBegin - nxny : 0;
+        winEnd    = slabEnd + nxny < numGridM ? slabEnd + nxny : numGridM;
+    }
+
     if (PRINTINPUT) {
         cout << "DIMENS" << endl;
         cout << setw(6) << nx << setw(6) << ny << setw(6) << nz << endl << endl;
@@ -310,7 +360,9 @@ void PreParamGridWell::InputEQUALS(ifstream& ifs)
                 if (objName == "TOPS") {
                     index[4] = index[5] = 0;
                 }
-                setVal(*objPtr, val, index);
+                OCP_ULL bId, eId;
+                GetStoredRange(objName, bId, eId);
+                setVal(*objPtr, val, index, bId, eId);
                 continue;
             }
         }
@@ -319,7 +371,9 @@ void PreParamGridWell::InputEQUALS(ifstream& ifs)
             auto objPtr = FindPtr(objName, (USI)0);
             if (objPtr != nullptr) {
                 objPtr->resize(objPtr->capacity());
-                setVal(*objPtr, (USI)val, index);
+                OCP_ULL bId, eId;
+                GetStoredRange(objName, bId, eId);
+                setVal(*objPtr, (USI)val, index, bId, eId);
                 continue;
             }
         }
@@ -372,7 +426,9 @@ void PreParamGridWell::InputCOPY(ifstream& ifs)
             auto objPtr = FindPtr(objName, (OCP_DBL)0);
             if (srcPtr != nullptr && objPtr != nullptr) {
                 objPtr->resize(srcPtr->size());
-                CopyVal(*objPtr, *srcPtr, index);
+                OCP_ULL bId, eId;
+                GetStoredRange(objName, bId, eId);
+                CopyVal(*objPtr, *srcPtr, index, bId, eId);
                 continue;
             }
         }
@@ -382,7 +438,9 @@ void PreParamGridWell::InputCOPY(ifstream& ifs)
             auto objPtr = FindPtr(objName, (USI)0);
             if (srcPtr != nullptr && objPtr != nullptr) {
                 objPtr->resize(srcPtr->size());
-                CopyVal(*objPtr, *srcPtr, index);
+                OCP_ULL bId, eId;
+                GetStoredRange(objName, bId, eId);
+                CopyVal(*objPtr, *srcPtr, index, bId, eId);
                 continue;
             }
         }
@@ -424,7 +482,9 @@ void PreParamGridWell::InputMULTIPLY(ifstream& ifs)
             if (objName == "TOPS") {
                 index[4] = index[5] = 0;
             }
-            MultiplyVal(*objPtr, val, index);
+            OCP_ULL bId, eId;
+            GetStoredRange(objName, bId, eId);
+            MultiplyVal(*objPtr, val, index, bId, eId);
         }
         else {
             OCP_ABORT("Wrong object name: " + objName);
@@ -445,6 +505,15 @@ void PreParamGridWell::InputGridParam(ifstream& ifs, string& keyword)
 {
     vector<string> vbuf;
 
+    // only values in [bId, eId) are stored in current process
+    OCP_ULL bId = 0;
+    OCP_ULL eId = numeric_limits<OCP_ULL>::max();
+    if (distInput) {
+        GetStoredRange(keyword, bId, eId);
+    }
+    // index of the next value
+    OCP_ULL id = 0;
+
     {
         auto objPtr = FindPtr(keyword, (OCP_DBL)0);
         if (objPtr != nullptr) {
@@ -455,13 +524,17 @@ void PreParamGridWell::InputGridParam(ifstream& ifs, string& keyword)
                     // if m*n occurs, then push back n  m times
                     auto pos = str.find('*');
                     if (pos == string::npos) {
-                        objPtr->push_back(stod(str));
+                        if (id >= bId && id < eId) objPtr->push_back(stod(str));
+                        id++;
                     }
                     else {
                         const USI     len = str.size();
                         const OCP_ULL num = stoi(str.substr(0, pos));
                         const OCP_DBL val = stod(str.substr(pos + 1, len - (pos + 1)));
-                        for (OCP_ULL i = 0; i < num; i++) objPtr->push_back(val);
+                        const OCP_ULL bi  = max(id, bId);
+                        const OCP_ULL ei  = min(id + num, eId);
+                        for (OCP_ULL i = bi; i < ei; i++) objPtr->push_back(val);
+                        id += num;
                     }
                 }
             }
@@ -479,13 +552,17 @@ void PreParamGridWell::InputGridParam(ifstream& ifs, string& keyword)
                     // if m*n occurs, then push back n  m times
                     auto pos = str.find('*');
                     if (pos == string::npos) {
-                        objPtr->push_back(stod(str));
+                        if (id >= bId && id < eId) objPtr->push_back(stod(str));
+                        id++;
                     }
                     else {
                         USI     len = str.size();
                         OCP_ULL num = stoi(str.substr(0, pos));
                         USI val = stoi(str.substr(pos + 1, len - (pos + 1)));
-                        for (OCP_ULL i = 0; i < num; i++) objPtr->push_back(val);
+                        const OCP_ULL bi = max(id, bId);
+                        const OCP_ULL ei = min(id + num, eId);
+                        for (OCP_ULL i = bi; i < ei; i++) objPtr->push_back(val);
+                        id += num;
                     }
                 }
             }
@@ -607,17 +684,17 @@ vector<OCP_DBL>* PreParamGridWell::FindPtr(const string& varName, const OCP_DBL&
     switch (Map_Str2Int(&varName[0], varName.size())) 
     {
     case Map_Str2Int("DX", 2):
-        dx.reserve(numGrid);
+        dx.reserve(NumGridStored());
         myPtr = &dx;
         break;
 
     case Map_Str2Int("DY", 2):
-        dy.reserve(numGrid);
+        dy.reserve(NumGridStored());
         myPtr = &dy;
         break;
 
     case Map_Str2Int("DZ", 2):
-        dz.reserve(numGrid);
+        dz.reserve(NumGridStored());
         myPtr = &dz;
         break;
 
@@ -639,52 +716,52 @@ vector<OCP_DBL>* PreParamGridWell::FindPtr(const string& varName, const OCP_DBL&
         break;
 
     case Map_Str2Int("PORO", 4):
-        poro.reserve(numGrid);
+        poro.reserve(NumGridStored());
         myPtr = &poro;
         break;
 
     case Map_Str2Int("NTG", 3):
-        ntg.reserve(numGrid);
+        ntg.reserve(NumGridStored());
         myPtr = &ntg;
         break;
 
     case Map_Str2Int("PERMX", 5):
-        kx.reserve(numGrid);
+        kx.reserve(NumGridStored());
         myPtr = &kx;
         break;
 
     case Map_Str2Int("PERMY", 5):
-        ky.reserve(numGrid);
+        ky.reserve(NumGridStored());
         myPtr = &ky;
         break;
 
     case Map_Str2Int("PERMZ", 5):
-        kz.reserve(numGrid);
+        kz.reserve(NumGridStored());
         myPtr = &kz;
         break;
 
     case Map_Str2Int("SIGMAV", 6):
-        sigma.reserve(numGrid);
+        sigma.reserve(NumGridStored());
         myPtr = &sigma;
         break;
 
     case Map_Str2Int("MULTZ", 5):
-        multZ.reserve(numGrid);
+        multZ.reserve(NumGridStored());
         myPtr = &multZ;
         break;
 
     case Map_Str2Int("DZMTRXV", 7):
-        dzMtrx.reserve(numGrid);
+        dzMtrx.reserve(NumGridStored());
         myPtr = &dzMtrx;
         break;
 
     case Map_Str2Int("SWAT", 4):
-        initR.swat.reserve(numGrid);
+        initR.swat.reserve(NumGridStored());
         myPtr = &initR.swat;
         break;
 
     case Map_Str2Int("SWATINIT", 8):
-        initR.swatInit.reserve(numGrid);
+        initR.swatInit.reserve(NumGridStored());
         myPtr = &initR.swatInit;
         initR.scalePcow = OCP_TRUE;
         break;
@@ -693,7 +770,7 @@ vector<OCP_DBL>* PreParamGridWell::FindPtr(const string& varName, const OCP_DBL&
         if (initR.type != InitType::PGSW) {
             OCP_ABORT("INITPGSW is not defined before PGAS!");
         }
-        initR.Pg.reserve(numGrid);
+        initR.Pg.reserve(NumGridStored());
         myPtr = &initR.Pg;
         break;
 
@@ -701,7 +778,7 @@ vector<OCP_DBL>* PreParamGridWell::FindPtr(const string& varName, const OCP_DBL&
         if (initR.type != InitType::PTN0 && initR.type != InitType::PTN1) {
             OCP_ABORT("INITPTN0 or INITPTN1 is not defined before PRESSURE!");
         }
-        initR.P.reserve(numGrid);
+        initR.P.reserve(NumGridStored());
         myPtr = &initR.P;
         break;
 
@@ -709,7 +786,7 @@ vector<OCP_DBL>* PreParamGridWell::FindPtr(const string& varName, const OCP_DBL&
         if (initR.type != InitType::PTN0 && initR.type != InitType::PTN1) {
             OCP_ABORT("INITPTN0 or INITPTN1 is not defined before TEMPER!");
         }
-        initR.T.reserve(numGrid);
+        initR.T.reserve(NumGridStored());
         myPtr = &initR.T;
         break;
 
@@ -720,7 +797,7 @@ vector<OCP_DBL>* PreParamGridWell::FindPtr(const string& varName, const OCP_DBL&
             OCP_ABORT("INITPTN0 or INITPTN1 is not defined before COMP-*!");
         }
         initR.Pj.push_back(vector<OCP_DBL>{});
-        initR.Pj.back().reserve(numGrid);
+        initR.Pj.back().reserve(NumGridStored());
         myPtr = &initR.Pj.back();
         break;
 
@@ -738,7 +815,7 @@ vector<OCP_DBL>* PreParamGridWell::FindPtr(const string& varName, const OCP_DBL&
             OCP_ABORT("INITPTN0 or INITPTN1 is not defined before COMP-*!");
         }
         initR.Ni.push_back(vector<OCP_DBL>{});
-        initR.Ni.back().reserve(numGrid);
+        initR.Ni.back().reserve(NumGridStored());
         myPtr = &initR.Ni.back();
         break;
     }
@@ -754,22 +831,22 @@ vector<USI>* PreParamGridWell::FindPtr(const string& varName, const USI&)
     switch (Map_Str2Int(&varName[0], varName.size())) 
     {
     case Map_Str2Int("ACTNUM", 6):
-        actGC.ACTNUM.reserve(numGrid);
+        actGC.ACTNUM.reserve(NumGridStored());
         myPtr = &actGC.ACTNUM;
         break;
 
     case Map_Str2Int("SATNUM", 6):
-        SATNUM.reserve(numGrid);
+        SATNUM.reserve(NumGridStored());
         myPtr = &SATNUM;
         break;
 
     case Map_Str2Int("PVTNUM", 6):
-        PVTNUM.reserve(numGrid);
+        PVTNUM.reserve(NumGridStored());
         myPtr = &PVTNUM;
         break;
 
     case Map_Str2Int("ROCKNUM", 7):
-        ROCKNUM.reserve(numGrid);
+        ROCKNUM.reserve(NumGridStored());
         myPtr = &ROCKNUM;
         break;
     }
@@ -778,16 +855,20 @@ vector<USI>* PreParamGridWell::FindPtr(const string& varName, const USI&)
 
 
 template <typename T>
-void PreParamGridWell::setVal(vector<T>& obj, const T& val, const vector<USI>& index)
+void PreParamGridWell::setVal(vector<T>& obj, const T& val, const vector<USI>& index,
+    const OCP_ULL& bId, const OCP_ULL& eId)
 {
     const OCP_ULL nxny = nx * ny;
     OCP_ULL id = 0;
 
-    for (USI k = index[4]; k <= index[5]; k++) {
+    const USI kb = max(static_cast<OCP_ULL>(index[4]), bId / nxny);
+    const USI ke = min(static_cast<OCP_ULL>(index[5]), (eId - 1) / nxny);
+    for (USI k = kb; k <= ke; k++) {
         for (USI j = index[2]; j <= index[3]; j++) {
             for (USI i = index[0]; i <= index[1]; i++) {
                 id = k * nxny + j * nx + i;
-                obj[id] = val;
+                if (id < bId || id >= eId) continue;
+                obj[id - bId] = val;
             }
         }
     }
@@ -797,17 +878,22 @@ void PreParamGridWell::setVal(vector<T>& obj, const T& val, const vector<USI>& i
 template <typename T>
 void PreParamGridWell::CopyVal(vector<T>& obj,
     const vector<T>& src,
-    const vector<USI>& index)
+    const vector<USI>& index,
+    const OCP_ULL& bId, 
+    const OCP_ULL& eId)
 {
 
     const OCP_ULL nxny = nx * ny;
     OCP_ULL id = 0;
 
-    for (USI k = index[4]; k <= index[5]; k++) {
+    const USI kb = max(static_cast<OCP_ULL>(index[4]), bId / nxny);
+    const USI ke = min(static_cast<OCP_ULL>(index[5]), (eId - 1) / nxny);
+    for (USI k = kb; k <= ke; k++) {
         for (USI j = index[2]; j <= index[3]; j++) {
             for (USI i = index[0]; i <= index[1]; i++) {
                 id = k * nxny + j * nx + i;
-                obj[id] = src[id];
+                if (id < bId || id >= eId) continue;
+                obj[id - bId] = src[id - bId];
             }
         }
     }
@@ -816,21 +902,43 @@ void PreParamGridWell::CopyVal(vector<T>& obj,
 
 void PreParamGridWell::MultiplyVal(vector<OCP_DBL>& obj,
     const OCP_DBL& val,
-    const vector<USI>& index)
+    const vector<USI>& index,
+    const OCP_ULL& bId,
+    const OCP_ULL& eId)
 {
     const OCP_ULL nxny = nx * ny;
     OCP_ULL id = 0;
 
-    for (USI k = index[4]; k <= index[5]; k++) {
+    const USI kb = max(static_cast<OCP_ULL>(index[4]), bId / nxny);
+    const USI ke = min(static_cast<OCP_ULL>(index[5]), (eId - 1) / nxny);
+    for (USI k = kb; k <= ke; k++) {
         for (USI j = index[2]; j <= index[3]; j++) {
             for (USI i = index[0]; i <= index[1]; i++) {
                 id = k * nxny + j * nx + i;
-                obj[id] *= val;
+                if (id < bId || id >= eId) continue;
+                obj[id - bId] *= val;
             }
         }
     }
 }
 
+
+void PreParamGridWell::GetStoredRange(const string& varName, OCP_ULL& bId, OCP_ULL& eId) const
+{
+    if (varName == "TOPS") {
+        bId = 0;
+        eId = nx * ny;
+    }
+    else if (distInput) {
+        bId = winBegin;
+        eId = winEnd;
+    }
+    else {
+        bId = 0;
+        eId = numGrid;
+    }
+}
+
 /////////////////////////////////////////////////////////////////////
 // check grid activity
 /////////////////////////////////////////////////////////////////////
@@ -895,6 +1003,71 @@ void ActiveGridCheck::CheckActivityT(const vector<OCP_DBL>& v, const vector<OCP_
 }
 
 
+OCP_ULL ActiveGridCheck::CheckActivitySlab(const OCPModel& Model, const OCP_DBL& ev, const OCP_DBL& ep,
+    const vector<OCP_DBL>& v, const vector<OCP_DBL>& poro,
+    const OCP_ULL& bId, const OCP_ULL& eId, MPI_Comm comm)
+{
+    model = Model;
+
+    if (model != OCPModel::isothermal && model != OCPModel::thermal) {
+        OCP_ABORT("INAVAILABLE MODEL!");
+    }
+
+    eV            = ev;
+    eP            = ep;
+    numGrid       = v.size();
+    map_Act2All.reserve(eId - bId);
+    map_All2Act.resize(numGrid, -1);
+
+    // num of active grids above slab(stored) and in slab
+    OCP_ULL numAbove = 0;
+    for (OCP_ULL n = 0; n < bId; n++) {
+        if (IfActive(n, v, poro))  numAbove++;
+    }
+    activeGridLocal = 0;
+    for (OCP_ULL n = bId; n < eId; n++) {
+        if (IfActive(n, v, poro))  activeGridLocal++;
+    }
+
+    OCP_INT myrank;
+    MPI_Comm_rank(comm, &myrank);
+    MPI_Exscan(&activeGridLocal, &activeGridBegin, 1, OCPMPI_ULL, MPI_SUM, comm);
+    if (myrank == 0)  activeGridBegin = 0;
+    MPI_Allreduce(&activeGridLocal, &activeGridNum, 1, OCPMPI_ULL, MPI_SUM, comm);
+
+    // active grids are numbered in natural order across processes
+    OCP_SLL activeCount = activeGridBegin - numAbove;
+    for (OCP_ULL n = 0; n < numGrid; n++) {
+        if (!IfActive(n, v, poro))  continue;
+
+        if (n >= bId && n < eId)  map_Act2All.push_back(n);
+        map_All2Act[n] = activeCount;
+        activeCount++;
+    }
+
+    OCP_ULL numGridSlab  = eId - bId;
+    OCP_ULL numGridTotal = 0;
+    MPI_Reduce(&numGridSlab, &numGridTotal, 1, OCPMPI_ULL, MPI_SUM, MASTER_PROCESS, comm);
+    if (myrank == MASTER_PROCESS) {
+        cout << "  Number of inactive cells is " << (numGridTotal - activeGridNum) << " ("
+            << (numGridTotal - activeGridNum) * 100.0 / numGridTotal << "%)" << endl;
+    }
+
+    vector<USI>().swap(ACTNUM);
+
+    return activeGridNum;
+}
+
+
+OCP_BOOL ActiveGridCheck::IfActive(const OCP_ULL& n, const vector<OCP_DBL>& v, const vector<OCP_DBL>& poro) const
+{
+    if (v[n] < eV)                                         return OCP_FALSE;
+    if (model == OCPModel::isothermal && poro[n] < eP)     return OCP_FALSE;
+    if (!allAct && ACTNUM[n] == 0)                         return OCP_FALSE;
+    return OCP_TRUE;
+}
+
+
 OCP_BOOL ActiveGridCheck::IfFluid(const OCP_ULL& n, const OCP_DBL& poro)
 {
     if (map_All2Act[n] >= 0 && poro > eP)  return OCP_TRUE;
@@ -979,6 +1152,36 @@ void PreParamGridWell::Setup()
 }
 
 
+void PreParamGridWell::SetupDist()
+{
+    if (CURRENT_RANK == MASTER_PROCESS) {
+        OCP_INFO("Setup Grid and Well by All Processes -- begin");
+    }
+
+#if OCPGRID_DXDYDZ
+    OCP_ABORT("OCPGRID_DXDYDZ mode is not available for distributed input");
+#endif // OCPGRID_DXDYDZ
+
+    CalDepthVOrthogonalGridDist();
+    activeGridNum = actGC.CheckActivitySlab(model, 1E-6, 1E-6, v, poro,
+                                            slabBegin - winBegin, slabEnd - winBegin, distComm);
+    SetupActiveConnOrthogonalGridDist();
+    OutputBaiscInfo();
+    SetLocationStructral();
+    SetupTransMultDist();
+    SetupConnWellGridDist();
+    actGC.FreeAll2Act();
+
+    OCP_DBL memUsage = OCPGetCurrentRSS();
+    MPI_Allreduce(MPI_IN_PLACE, &memUsage, 1, OCPMPI_DBL, MPI_MAX, distComm);
+
+    if (CURRENT_RANK == MASTER_PROCESS) {
+        cout << "Memory Usuage(max of processes): " << scientific << setprecision(6) << memUsage << " GB" << endl;
+        OCP_INFO("Setup Grid and Well by All Processes -- end");
+    }
+}
+
+
 void PreParamGridWell::SetupGrid()
 {
     OCP_INFO("Setup Grid -- begin");
@@ -1082,6 +1285,116 @@ void PreParamGridWell::CalDepthVOrthogonalGrid()
     OCP_INFO("Calculate Depth and Volume -- end");
 }
 
+void PreParamGridWell::CalDepthVOrthogonalGridDist()
+{
+    const OCP_ULL nxny = nx * ny;
+    const OCP_ULL nW   = winEnd - winBegin;
+
+    // depth of the top of slab in each column
+    vector<OCP_DBL> colDz(nxny, 0);
+    vector<OCP_DBL> colDepth(nxny, 0);
+    for (OCP_ULL n = slabBegin; n < slabEnd; n++) {
+        colDz[n % nxny] += dz[n - winBegin];
+    }
+    OCP_INT myrank;
+    MPI_Comm_rank(distComm, &myrank);
+    MPI_Exscan(colDz.data(), colDepth.data(), nxny, OCPMPI_DBL, MPI_SUM, distComm);
+    if (myrank == 0)  fill(colDepth.begin(), colDepth.end(), 0.0);
+
+    for (OCP_ULL n = 0; n < nxny; n++) {
+        colDepth[n] += tops[n];
+    }
+
+    depth.resize(nW, 0);
+    for (OCP_ULL n = slabBegin; n < slabEnd; n++) {
+        const OCP_ULL c = n % nxny;
+        const OCP_ULL w = n - winBegin;
+        depth[w]    = colDepth[c] + dz[w] / 2;
+        colDepth[c] += dz[w];
+    }
+
+    v.resize(nW);
+    for (OCP_ULL i = 0; i < nW; i++) v[i] = dx[i] * dy[i] * dz[i];
+
+    vector<OCP_DBL>().swap(tops);
+}
+
+
+void PreParamGridWell::SetupActiveConnOrthogonalGridDist()
+{
+    gNeighbor.resize(actGC.activeGridLocal);
+    // PreAllocate
+    for (auto& gn : gNeighbor) {
+        gn.reserve(6);
+    }
+
+    // The traversal is the same as SetupActiveConnOrthogonalGridSM, grids in the
+    // layer above slab are also traversed for their connections with slab, and only
+    // the connections of grids in slab are kept.
+    // Begin Id and End Id in Grid(natural index), bIdg < eIdg
+    OCP_ULL       bIdg, eIdg;
+    OCP_SLL       bIdb, eIdb;
+    OCP_DBL       areaB, areaE;
+    const OCP_ULL nxny     = nx * ny;
+    const OCP_ULL actBegin = actGC.activeGridBegin;
+    const auto&   all2act  = actGC.map_All2Act;
+
+    auto addConn = [&](const ConnDirect& directB, const ConnDirect& directE) {
+        if (bIdg >= slabBegin) {
+            gNeighbor[bIdb - actBegin].push_back(ConnPair(eIdb, WEIGHT_GG, directB, areaB, areaE));
+        }
+        if (eIdg >= slabBegin && eIdg < slabEnd) {
+            gNeighbor[eIdb - actBegin].push_back(ConnPair(bIdb, WEIGHT_GG, directE, areaE, areaB));
+        }
+    };
+
+    for (bIdg = winBegin; bIdg < slabEnd; bIdg++) {
+
+        const OCP_ULL bIdw = bIdg - winBegin;
+        bIdb = all2act[bIdw];
+        if (bIdb < 0)  continue;
+
+        const USI i = bIdg % nx;
+        const USI j = (bIdg / nx) % ny;
+        const USI k = bIdg / nxny;
+
+        // right  --  x-direction
+        if (i < nx - 1) {
+            eIdg = bIdg + 1;
+            eIdb = all2act[eIdg - winBegin];
+            if (eIdb < 0)  continue;
+
+            const OCP_ULL eIdw = eIdg - winBegin;
+            areaB = 2 * dy[bIdw] * dz[bIdw] / dx[bIdw];
+            areaE = 2 * dy[eIdw] * dz[eIdw] / dx[eIdw];
+            addConn(ConnDirect::xp, ConnDirect::xm);
+        }
+        // front  --  y-direction
+        if (j < ny - 1) {
+            eIdg = bIdg + nx;
+            eIdb = all2act[eIdg - winBegin];
+            if (eIdb < 0)  continue;
+
+            const OCP_ULL eIdw = eIdg - winBegin;
+            areaB = 2 * dz[bIdw] * dx[bIdw] / dy[bIdw];
+            areaE = 2 * dz[eIdw] * dx[eIdw] / dy[eIdw];
+            addConn(ConnDirect::yp, ConnDirect::ym);
+        }
+        // down --   z-direction
+        if (k < nz - 1) {
+            eIdg = bIdg + nxny;
+            eIdb = all2act[eIdg - winBegin];
+            if (eIdb < 0)  continue;
+
+            const OCP_ULL eIdw = eIdg - winBegin;
+            areaB = 2 * dx[bIdw] * dy[bIdw] / dz[bIdw];
+            areaE = 2 * dx[eIdw] * dy[eIdw] / dz[eIdw];
+            addConn(ConnDirect::zp, ConnDirect::zm);
+        }
+    }
+}
+
+
 void PreParamGridWell::SetupActiveConnOrthogonalGrid()
 {
     OCP_INFO("Setup Active Grid Connections -- begin");
@@ -1414,26 +1727,25 @@ void PreParamGridWell::SetupActiveConnCornerGrid(const OCP_COORD& CoTmp)
 void PreParamGridWell::SetupActiveConnCornerGridSM(const OCP_COORD& CoTmp)
 {
     gNeighbor.resize(activeGridNum);
-    // PreAllocate
-    for (OCP_ULL n = 0; n < activeGridNum; n++) {
-        gNeighbor[n].reserve(10);
-    }
-
-    OCP_SLL bIdg, eIdg, bIdb, eIdb;
-    OCP_DBL areaB, areaE;
-    for (OCP_ULL n = 0; n < CoTmp.numConn; n++) {
-        const GeneralConnect& ConnTmp = CoTmp.connect[n];
-
-        bIdg = ConnTmp.begin;
-        eIdg = ConnTmp.end;
 
+    // connections are grouped by their begin grids, so each grid gets its own
+    // neighbors independently
+    OCP_SLL bIdb, eIdb;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024) private(bIdb, eIdb)
+#endif
+    for (OCP_ULL bIdg = 0; bIdg < CoTmp.numGrid; bIdg++) {
         bIdb = actGC.map_All2Act[bIdg];
-        eIdb = actGC.map_All2Act[eIdg];
+        if (bIdb < 0)  continue;
 
-        if (bIdb >= 0 && eIdb >= 0) {          
-            areaB = ConnTmp.Ad_dd_begin;
-            areaE = ConnTmp.Ad_dd_end;
-            gNeighbor[bIdb].push_back(ConnPair(eIdb, WEIGHT_GG, ConnTmp.directionType, areaB, areaE));
+        gNeighbor[bIdb].reserve(10);
+        for (OCP_ULL n = CoTmp.connBegin[bIdg]; n < CoTmp.connBegin[bIdg + 1]; n++) {
+            const GeneralConnect& ConnTmp = CoTmp.connect[n];
+
+            eIdb = actGC.map_All2Act[ConnTmp.end];
+            if (eIdb >= 0) {
+                gNeighbor[bIdb].push_back(ConnPair(eIdb, WEIGHT_GG, ConnTmp.directionType, ConnTmp.Ad_dd_begin, ConnTmp.Ad_dd_end));
+            }
         }
     }
 }
@@ -1449,20 +1761,20 @@ void PreParamGridWell::SetupActiveConnCornerGridDP(const OCP_COORD& CoTmp)
     }
 
     OCP_SLL bIdg, eIdg, bIdb, eIdb;
-    OCP_DBL areaB, areaE;
-    for (OCP_ULL n = 0; n < CoTmp.numConn; n++) {
-        const GeneralConnect& ConnTmp = CoTmp.connect[n];
-
-        bIdg = ConnTmp.begin + numGridM;
-        eIdg = ConnTmp.end + numGridM;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024) private(bIdb, eIdb)
+#endif
+    for (OCP_ULL bIdm = 0; bIdm < CoTmp.numGrid; bIdm++) {
+        bIdb = actGC.map_All2Act[bIdm + numGridM];
+        if (bIdb < 0)  continue;
 
-        bIdb = actGC.map_All2Act[bIdg];
-        eIdb = actGC.map_All2Act[eIdg];
+        for (OCP_ULL n = CoTmp.connBegin[bIdm]; n < CoTmp.connBegin[bIdm + 1]; n++) {
+            const GeneralConnect& ConnTmp = CoTmp.connect[n];
 
-        if (bIdb >= 0 && eIdb >= 0) {
-            areaB = ConnTmp.Ad_dd_begin;
-            areaE = ConnTmp.Ad_dd_end;
-            gNeighbor[bIdb].push_back(ConnPair(eIdb, WEIGHT_GG, ConnTmp.directionType, areaB, areaE));
+            eIdb = actGC.map_All2Act[ConnTmp.end + numGridM];
+            if (eIdb >= 0) {
+                gNeighbor[bIdb].push_back(ConnPair(eIdb, WEIGHT_GG, ConnTmp.directionType, ConnTmp.Ad_dd_begin, ConnTmp.Ad_dd_end));
+            }
         }
     }
 
@@ -1674,17 +1986,22 @@ void PreParamGridWell::OutputPointsGmshGrid()
 
 void PreParamGridWell::SetLocationStructral()
 {
-    boundArea.resize(numGrid);
-    boundIndex.resize(numGrid);
-    const OCP_ULL uplim   = nx * ny;
-    const OCP_ULL downlim = nx * ny * (nz - 1);
-    for (OCP_ULL n = 0; n < uplim; n++) {
-        boundIndex[n] = 1;
-        boundArea[n]  = dx[n] * dy[n];
-    }
-    for (OCP_ULL n = downlim; n < nx * ny * nz; n++) {
-        boundIndex[n] = 2;
-        boundArea[n]  = dx[n] * dy[n];
+    const OCP_ULL nG = NumGridStored();
+    boundArea.resize(nG);
+    boundIndex.resize(nG);
+    // stored grids are [bId, eId) in natural index
+    const OCP_ULL bId     = distInput ? winBegin : 0;
+    const OCP_ULL eId     = bId + nG;
+    const OCP_ULL uplim   = min(nx * ny, eId);
+    const OCP_ULL downlim = max(nx * ny * (nz - 1), bId);
+    const OCP_ULL bottom  = min(nx * ny * nz, eId);
+    for (OCP_ULL n = bId; n < uplim; n++) {
+        boundIndex[n - bId] = 1;
+        boundArea[n - bId]  = dx[n - bId] * dy[n - bId];
+    }
+    for (OCP_ULL n = downlim; n < bottom; n++) {
+        boundIndex[n - bId] = 2;
+        boundArea[n - bId]  = dx[n - bId] * dy[n - bId];
     }
 }
 
@@ -1720,6 +2037,27 @@ void PreParamGridWell::SetupTransMult()
     vector<OCP_DBL>().swap(multZ);
 }
 
+
+void PreParamGridWell::SetupTransMultDist()
+{
+    if (!multZ.empty()) {
+        // multZ of the upper grid is applied to the connection in z-direction
+        const OCP_ULL nxny = nx * ny;
+        for (OCP_ULL n = 0; n < actGC.activeGridLocal; n++) {
+            const OCP_ULL nw = actGC.map_Act2All[n];
+            for (auto& c : gNeighbor[n]) {
+                if (c.Direct() == static_cast<USI>(ConnDirect::zp)) {
+                    c.SetTransMult(multZ[nw]);
+                }
+                else if (c.Direct() == static_cast<USI>(ConnDirect::zm)) {
+                    c.SetTransMult(multZ[nw - nxny]);
+                }
+            }
+        }
+    }
+    vector<OCP_DBL>().swap(multZ);
+}
+
 /////////////////////////////////////////////////////////////////////
 // Generate connections between active grids and wells
 /////////////////////////////////////////////////////////////////////
@@ -1762,6 +2100,69 @@ void PreParamGridWell::SetupConnWellGrid()
 }
 
 
+void PreParamGridWell::SetupConnWellGridDist()
+{
+    if (CURRENT_RANK == MASTER_PROCESS) {
+        OCP_INFO("Setup Connection between Grid and Well -- begin");
+    }
+
+    numWell = well.size();
+    connWellGrid.resize(numWell);
+
+    // global active index of perforations, -1 if it's inactive or out of slab
+    vector<OCP_USI> perfBegin(numWell + 1, 0);
+    for (USI w = 0; w < numWell; w++) {
+        perfBegin[w + 1] = perfBegin[w] + well[w].GetPerfNum();
+    }
+    vector<OCP_SLL> perfAct(perfBegin[numWell], -1);
+
+    const OCP_ULL actBegin = actGC.activeGridBegin;
+    for (USI w = 0; w < numWell; w++) {
+        const USI numPerf = well[w].GetPerfNum();
+        for (USI p = 0; p < numPerf; p++) {
+            const OCP_ULL pId = GetPerfLocation(well[w], p);
+            if (pId < slabBegin || pId >= slabEnd)  continue;
+
+            const OCP_ULL pIdw = pId - winBegin;
+            if (actGC.IfFluid(pIdw, poro[pIdw])) {
+                perfAct[perfBegin[w] + p] = actGC.map_All2Act[pIdw];
+                // for well-connection, areaB and areaE contains its active perforation index and trans if necessary
+                gNeighbor[actGC.map_All2Act[pIdw] - actBegin].push_back(ConnPair(w + activeGridNum, WEIGHT_GW, p, 0, 0));
+            }
+        }
+    }
+
+    MPI_Allreduce(MPI_IN_PLACE, perfAct.data(), perfAct.size(), OCPMPI_SLL, MPI_MAX, distComm);
+
+    for (USI w = 0; w < numWell; w++) {
+        for (OCP_USI p = perfBegin[w]; p < perfBegin[w + 1]; p++) {
+            if (perfAct[p] >= 0)  connWellGrid[w].push_back(perfAct[p]);
+        }
+        if (connWellGrid[w].empty()) {
+            OCP_ABORT("All perforations of Well " + well[w].name + " are in Inactive grid!");
+        }
+    }
+
+    // Wells belong to the last process
+    OCP_INT numproc, myrank;
+    MPI_Comm_size(distComm, &numproc);
+    MPI_Comm_rank(distComm, &myrank);
+    if (myrank == numproc - 1) {
+        gNeighbor.resize(actGC.activeGridLocal + numWell);
+        for (USI w = 0; w < numWell; w++) {
+            for (const auto& b : connWellGrid[w]) {
+                gNeighbor[w + actGC.activeGridLocal].push_back(ConnPair(b, WEIGHT_GW, ConnDirect::n, 0, 0));
+            }
+        }
+    }
+    gNeighbor.shrink_to_fit();
+
+    if (CURRENT_RANK == MASTER_PROCESS) {
+        OCP_INFO("Setup Connection between Grid and Well -- end");
+    }
+}
+
+
 OCP_ULL PreParamGridWell::GetPerfLocation(const WellParam& well, const USI& p)
 {
     if (gridType >= GridType::structured && gridType < GridType::unstructured) {
@@ -1811,7 +2212,14 @@ void PreParamGridWell::OutputBaiscInfo() const
     OCP_DBL dzMax = 0;
     OCP_DBL dzMin = 1E8;
 
-    for (OCP_ULL n = 0; n < numGrid; n++) {
+    OCP_ULL bId = 0;
+    OCP_ULL eId = numGrid;
+    if (distInput) {
+        bId = slabBegin - winBegin;
+        eId = slabEnd - winBegin;
+    }
+
+    for (OCP_ULL n = bId; n < eId; n++) {
         if (depthMax < depth[n]) {
             depthMax = depth[n];
         }
@@ -1838,6 +2246,18 @@ void PreParamGridWell::OutputBaiscInfo() const
         }
     }
 
+    if (distInput) {
+        OCP_DBL buffer[8] = { depthMax, -depthMin, dxMax, -dxMin, dyMax, -dyMin, dzMax, -dzMin };
+        MPI_Reduce(CURRENT_RANK == MASTER_PROCESS ? MPI_IN_PLACE : buffer, buffer, 8, 
+                   OCPMPI_DBL, MPI_MAX, MASTER_PROCESS, distComm);
+        if (CURRENT_RANK != MASTER_PROCESS)  return;
+
+        depthMax = buffer[0];  depthMin = -buffer[1];
+        dxMax    = buffer[2];  dxMin    = -buffer[3];
+        dyMax    = buffer[4];  dyMin    = -buffer[5];
+        dzMax    = buffer[6];  dzMin    = -buffer[7];
+    }
+
     cout << "\n---------------------" << endl
         << "GRID"
         << "\n---------------------" << endl;
@@ -12,21 +12,42 @@
 #include "PreProcess.hpp"
 
 
-PreProcess::PreProcess(const string& myFile)
+PreProcess::PreProcess(const USI& argc, const char* argv[])
 {  
     GetWallTime timer;
     timer.Start();
 
-    if (CURRENT_RANK == MASTER_PROCESS) {   
-        GetFile(myFile);
+    const FastControl fctrl(argc, argv);
+    if (fctrl.profile) {
+        OCP_PROFILER.Enable(fctrl.profileTrace);
+    }
+    if (fctrl.hwCounter) {
+        OCP_HWCOUNTER.Enable();
+    }
+    OCP_PROFILE("PreProcess");
+
+    OCP_INT numproc;
+    MPI_Comm_size(MPI_COMM_WORLD, &numproc);
+
+    if (fctrl.distGridInput && numproc > 1) {
+        // every process inputs and sets up its own slab of grid
+        GetFile(argv[1]);
+        preParamGridWell.InputFileDist(filename, workdir, MPI_COMM_WORLD);
+        preParamGridWell.SetupDist();
+    }
+    else if (CURRENT_RANK == MASTER_PROCESS) {   
+        GetFile(argv[1]);
         preParamGridWell.InputFile(filename, workdir);
         preParamGridWell.Setup();
     }
 
     MPI_Barrier(MPI_COMM_WORLD);
     partition.InitMPI(MPI_COMM_WORLD);
+    partition.SetVertexWeightFile(fctrl.vwgtInFile);
+    partition.SetPartitionFile(fctrl.ptnCacheDir, fctrl.ptnInFile);
     partition.SetPartition(preParamGridWell);
     partition.SetDistribution();
+    domain.SetReorderRCM(fctrl.reorderRCM);
     domain.Setup(partition, preParamGridWell);
 
     OCPTIME_PARTITION = timer.Stop();
@@ -31,6 +31,9 @@ void Reservoir::Setup(PreProcess& prepro, ParamRead& param)
 {
     SetupDomain(prepro.domain);
     SetupDistParamGrid(prepro.preParamGridWell);
+    if (domain.IfReordered()) {
+        conn.SortConn();
+    }
     SetupDistParamOthers(param);
 }
 
@@ -170,7 +173,10 @@ void Reservoir::SetupDistParamGrid(PreParamGridWell& mygrid)
 
 #endif // OCPGRID_NORMAL   
     
-    if (myrank == MASTER_PROCESS) {
+    if (grid.IfDistInput()) {
+        SetupDistParamGridSlab(mygrid, varInfo);
+    }
+    else if (myrank == MASTER_PROCESS) {
         
         // Calculate the number of kind of grid data needs to be sent to other process
         VarInfoGrid send_var;
@@ -452,12 +458,26 @@ void Reservoir::SetupDistParamGrid(PreParamGridWell& mygrid)
         usi_ptr += recv_var.numvar_usi * bulk.vs.nb;
 
         // Get Conn from recv_buffer, only Interior grids' neighbors are passed
-        OCP_DBL*     conn_ptr = (OCP_DBL*)usi_ptr;
         vector<BulkConnPair>* dst = &conn.iteratorConn;       
-        domain.neighborNum.reserve(domain.numGridInterior);
+        domain.neighborNum.resize(domain.numGridInterior);
         const auto  global_well_start = domain.numElementTotal - domain.numWellTotal;
         const auto& init2local = domain.init_global_to_local;
         OCP_USI           bId, eId;
+        // conns are passed in the order of local index of interior grids
+        vector<OCP_DBL*> conn_loc(domain.numGridInterior, nullptr);
+        for (const auto& e : domain.elementCSR) {
+            const auto&  ev      = e.second;
+            const idx_t* my_vtx  = &ev[2];
+            const idx_t* my_xadj = &ev[2 + ev[0]];
+            for (USI i = 0; i < ev[0]; i++) {
+                if (my_vtx[i] >= global_well_start)  continue;
+                domain.neighborNum[init2local.at(my_vtx[i])] = my_xadj[i + 1] - my_xadj[i] + 1;
+            }
+        }
+        conn_loc[0] = (OCP_DBL*)usi_ptr;
+        for (OCP_USI n = 1; n < domain.numGridInterior; n++) {
+            conn_loc[n] = conn_loc[n - 1] + (domain.neighborNum[n - 1] - 1) * varNumEdge;
+        }
         // Traverse elementCSR in ascending order of process number
 		for (const auto& e : domain.elementCSR) {
             const auto&  ev      = e.second;
@@ -468,8 +488,8 @@ void Reservoir::SetupDistParamGrid(PreParamGridWell& mygrid)
 				if (my_vtx[i] >= global_well_start) {
 					continue;  // well is excluded
 				}
-				domain.neighborNum.push_back(my_xadj[i + 1] - my_xadj[i] + 1);
 				bId = init2local.at(my_vtx[i]);
+				OCP_DBL* conn_ptr = conn_loc[bId];
 				for (USI j = my_xadj[i]; j < my_xadj[i + 1]; j++) {
 					const auto& iter = init2local.find(my_edge[j]);
 					if (iter != init2local.end()) {
@@ -596,6 +616,279 @@ void Reservoir::SetupDistParamGrid(PreParamGridWell& mygrid)
 }
 
 
+/// Exchange bytes among all processes like MPI_Alltoallv, but counts and displacements
+/// are 64-bit, and each message is split into pieces within the range of int
+static void AlltoallvByte(const vector<OCP_CHAR>& sendBuf, const vector<OCP_ULL>& sendCount,
+                          const vector<OCP_ULL>& sendDispls, vector<OCP_CHAR>& recvBuf,
+                          const vector<OCP_ULL>& recvCount, const vector<OCP_ULL>& recvDispls,
+                          MPI_Comm comm)
+{
+    const OCP_ULL       maxPiece = 1ULL << 30;
+    const OCP_INT       numproc  = sendCount.size();
+    vector<MPI_Request> request;
+    for (OCP_INT p = 0; p < numproc; p++) {
+        for (OCP_ULL b = 0; b < recvCount[p]; b += maxPiece) {
+            request.push_back(MPI_REQUEST_NULL);
+            MPI_Irecv(recvBuf.data() + recvDispls[p] + b, static_cast<OCP_INT>(min(maxPiece, recvCount[p] - b)),
+                      OCPMPI_BYTE, p, 0, comm, &request.back());
+        }
+    }
+    for (OCP_INT p = 0; p < numproc; p++) {
+        for (OCP_ULL b = 0; b < sendCount[p]; b += maxPiece) {
+            request.push_back(MPI_REQUEST_NULL);
+            MPI_Isend(sendBuf.data() + sendDispls[p] + b, static_cast<OCP_INT>(min(maxPiece, sendCount[p] - b)),
+                      OCPMPI_BYTE, p, 0, comm, &request.back());
+        }
+    }
+    // pieces between two processes arrive in order
+    MPI_Waitall(request.size(), request.data(), MPI_STATUSES_IGNORE);
+}
+
+
+void Reservoir::SetupDistParamGridSlab(PreParamGridWell& mygrid, const VarInfoGrid& varInfo)
+{
+    const PreParamGridWell& grid = mygrid;
+
+    MPI_Comm      myComm  = domain.global_comm;
+    const OCP_INT numproc = domain.global_numproc;
+
+#if OCPGRID_NORMAL
+    const USI varNumEdge = 4;
+#elif OCPGRID_DXDYDZ
+    const USI varNumEdge = 1;
+#endif // OCPGRID_NORMAL 
+
+    // Calculate the kind of grid data needs to be sent, which is the same in all slabs
+    VarInfoGrid   send_var;
+    const OCP_INT send_var_info = GetSendVarInfo(varInfo, send_var);
+    OCP_INT       var_info_check[2] = { send_var_info, -send_var_info };
+    MPI_Allreduce(MPI_IN_PLACE, var_info_check, 2, OCPMPI_INT, MPI_MAX, myComm);
+    if (var_info_check[0] != -var_info_check[1]) {
+        OCP_ABORT("Grid params are inconsistent among processes!");
+    }
+
+    // Active grids in slab of each process
+    vector<OCP_ULL> slabdist(numproc + 1, 0);
+    const OCP_ULL   numLocal = grid.actGC.activeGridLocal;
+    MPI_Allgather(&numLocal, 1, OCPMPI_ULL, &slabdist[1], 1, OCPMPI_ULL, myComm);
+    for (OCP_INT p = 0; p < numproc; p++) {
+        slabdist[p + 1] += slabdist[p];
+    }
+
+    /////////////////////////////////////////////////////////////////////////
+    // Request grids from the processes owning them, interior grids first
+    /////////////////////////////////////////////////////////////////////////
+
+    vector<vector<OCP_USI>> req_loc(numproc);          ///< local index of requested grids
+    vector<OCP_INT>         req_num(2 * numproc, 0);   ///< num of interior grid, num of ghost grid
+    for (OCP_USI n = 0; n < bulk.vs.nb; n++) {
+        const OCP_INT p = upper_bound(slabdist.begin(), slabdist.end(), domain.grid[n]) - slabdist.begin() - 1;
+        req_loc[p].push_back(n);
+        if (n < bulk.vs.nbI)  req_num[2 * p]++;
+        else                  req_num[2 * p + 1]++;
+    }
+    vector<OCP_INT> ask_num(2 * numproc, 0);
+    MPI_Alltoall(req_num.data(), 2, OCPMPI_INT, ask_num.data(), 2, OCPMPI_INT, myComm);
+
+    vector<OCP_INT> req_count(numproc), req_displs(numproc + 1, 0);
+    vector<OCP_INT> ask_count(numproc), ask_displs(numproc + 1, 0);
+    for (OCP_INT p = 0; p < numproc; p++) {
+        req_count[p]      = req_num[2 * p] + req_num[2 * p + 1];
+        ask_count[p]      = ask_num[2 * p] + ask_num[2 * p + 1];
+        req_displs[p + 1] = req_displs[p] + req_count[p];
+        ask_displs[p + 1] = ask_displs[p] + ask_count[p];
+    }
+
+    vector<OCP_ULL> req_id(req_displs[numproc]);
+    for (OCP_INT p = 0; p < numproc; p++) {
+        for (OCP_INT i = 0; i < req_count[p]; i++) {
+            req_id[req_displs[p] + i] = domain.grid[req_loc[p][i]];
+        }
+    }
+    vector<OCP_ULL> ask_id(ask_displs[numproc]);
+    MPI_Alltoallv(req_id.data(), req_count.data(), req_displs.data(), OCPMPI_ULL,
+                  ask_id.data(), ask_count.data(), ask_displs.data(), OCPMPI_ULL, myComm);
+    vector<OCP_ULL>().swap(req_id);
+
+    /////////////////////////////////////////////////////////////////////////
+    // Reply the grid-based vars and the connections of interior grids
+    // send_var_value(dbl), send_edge(direction, areaB, areaE, transmult), send_var_value(usi)
+    /////////////////////////////////////////////////////////////////////////
+
+    const OCP_ULL          actBegin = grid.actGC.activeGridBegin;
+    const vector<OCP_ULL>& act2all  = grid.actGC.map_Act2All;
+
+    // bytes of replies may exceed the range of int
+    vector<OCP_ULL> reply_count(numproc, 0), reply_displs(numproc + 1, 0);
+    for (OCP_INT p = 0; p < numproc; p++) {
+        OCP_ULL numEdge = 0;
+        for (OCP_INT i = 0; i < ask_num[2 * p]; i++) {
+            numEdge += grid.gNeighbor[ask_id[ask_displs[p] + i] - actBegin].size();
+        }
+        OCP_ULL numByte = static_cast<OCP_ULL>(ask_count[p]) * send_var.numByte_total +
+                          numEdge * varNumEdge * sizeof(OCP_DBL);
+        // keep the alignment of OCP_DBL
+        numByte           = (numByte + sizeof(OCP_DBL) - 1) / sizeof(OCP_DBL) * sizeof(OCP_DBL);
+        reply_count[p]    = numByte;
+        reply_displs[p + 1] = reply_displs[p] + reply_count[p];
+    }
+
+    vector<OCP_CHAR> reply_buffer(reply_displs[numproc]);
+    for (OCP_INT p = 0; p < numproc; p++) {
+        const OCP_ULL* ids = ask_id.data() + ask_displs[p];
+        const OCP_INT  nG  = ask_count[p];
+        // dbl
+        OCP_DBL* dbl_ptr = (OCP_DBL*)(reply_buffer.data() + reply_displs[p]);
+        for (USI s = 0; s < static_cast<USI>(send_var.numvar_dbl); s++) {
+            const OCP_DBL* src = send_var.var_dbl[s].src_ptr->data();
+            OCP_DBL*       dst = dbl_ptr + s * nG;
+            for (OCP_INT n = 0; n < nG; n++) {
+                dst[n] = src[act2all[ids[n] - actBegin]];
+            }
+        }
+        dbl_ptr += send_var.numvar_dbl * nG;
+        // grid-conn
+        for (OCP_INT n = 0; n < ask_num[2 * p]; n++) {
+            for (const auto& gn : grid.gNeighbor[ids[n] - actBegin]) {
+                *dbl_ptr++ = static_cast<OCP_DBL>(gn.Direct());
+#if OCPGRID_NORMAL
+                *dbl_ptr++ = gn.AreaB();
+                *dbl_ptr++ = gn.AreaE();
+                *dbl_ptr++ = gn.TransMult();
+#endif
+            }
+        }
+        // usi
+        OCP_USI* usi_ptr = (OCP_USI*)dbl_ptr;
+        for (USI s = 0; s < static_cast<USI>(send_var.numvar_usi); s++) {
+            const OCP_USI* src = send_var.var_usi[s].src_ptr->data();
+            OCP_USI*       dst = usi_ptr + s * nG;
+            for (OCP_INT n = 0; n < nG; n++) {
+                dst[n] = src[act2all[ids[n] - actBegin]];
+            }
+        }
+    }
+    vector<OCP_ULL>().swap(ask_id);
+
+    vector<OCP_ULL> recv_count(numproc), recv_displs(numproc + 1, 0);
+    MPI_Alltoall(reply_count.data(), 1, OCPMPI_ULL, recv_count.data(), 1, OCPMPI_ULL, myComm);
+    for (OCP_INT p = 0; p < numproc; p++) {
+        recv_displs[p + 1] = recv_displs[p] + recv_count[p];
+    }
+    vector<OCP_CHAR> recv_buffer(recv_displs[numproc]);
+    AlltoallvByte(reply_buffer, reply_count, reply_displs, recv_buffer, recv_count, recv_displs, myComm);
+    vector<OCP_CHAR>().swap(reply_buffer);
+
+    /////////////////////////////////////////////////////////////////////////
+    // Get grid-based vars and conn-based vars
+    /////////////////////////////////////////////////////////////////////////
+
+    const auto  global_well_start = domain.numElementTotal - domain.numWellTotal;
+    const auto& init2local        = domain.init_global_to_local;
+
+    // num of edges of interior grids
+    vector<OCP_USI> numEdge(bulk.vs.nbI, 0);
+    for (const auto& e : domain.elementCSR) {
+        const auto&  ev      = e.second;
+        const idx_t* my_vtx  = &ev[2];
+        const idx_t* my_xadj = &ev[2 + ev[0]];
+        for (USI i = 0; i < ev[0]; i++) {
+            if (my_vtx[i] >= global_well_start)  continue;
+            numEdge[init2local.at(my_vtx[i])] = my_xadj[i + 1] - my_xadj[i];
+        }
+    }
+
+    for (auto& s : send_var.var_dbl)  s.dst_ptr->resize(bulk.vs.nb);
+    for (auto& s : send_var.var_usi)  s.dst_ptr->resize(bulk.vs.nb);
+
+    vector<const OCP_DBL*> conn_loc(bulk.vs.nbI, nullptr);
+    for (OCP_INT p = 0; p < numproc; p++) {
+        const auto&   loc = req_loc[p];
+        const OCP_INT nG  = req_count[p];
+        // dbl
+        const OCP_DBL* dbl_ptr = (const OCP_DBL*)(recv_buffer.data() + recv_displs[p]);
+        for (USI s = 0; s < static_cast<USI>(send_var.numvar_dbl); s++) {
+            const OCP_DBL* src = dbl_ptr + s * nG;
+            OCP_DBL*       dst = send_var.var_dbl[s].dst_ptr->data();
+            for (OCP_INT n = 0; n < nG; n++) {
+                dst[loc[n]] = src[n];
+            }
+        }
+        dbl_ptr += send_var.numvar_dbl * nG;
+        // grid-conn
+        for (OCP_INT n = 0; n < req_num[2 * p]; n++) {
+            conn_loc[loc[n]] = dbl_ptr;
+            dbl_ptr += numEdge[loc[n]] * varNumEdge;
+        }
+        // usi
+        const OCP_USI* usi_ptr = (const OCP_USI*)dbl_ptr;
+        for (USI s = 0; s < static_cast<USI>(send_var.numvar_usi); s++) {
+            const OCP_USI* src = usi_ptr + s * nG;
+            OCP_USI*       dst = send_var.var_usi[s].dst_ptr->data();
+            for (OCP_INT n = 0; n < nG; n++) {
+                dst[loc[n]] = src[n];
+            }
+        }
+    }
+
+    // Get Conn, only Interior grids' neighbors are passed
+    vector<BulkConnPair>* dst = &conn.iteratorConn;
+    domain.neighborNum.resize(domain.numGridInterior);
+    OCP_USI bId, eId;
+    // Traverse elementCSR in ascending order of process number
+    for (const auto& e : domain.elementCSR) {
+        const auto&  ev      = e.second;
+        const idx_t* my_vtx  = &ev[2];
+        const idx_t* my_xadj = &ev[2 + ev[0]];
+        const idx_t* my_edge = &ev[2 + ev[0] + ev[0] + 1];
+        for (USI i = 0; i < ev[0]; i++) {
+            if (my_vtx[i] >= global_well_start) {
+                continue;  // well is excluded
+            }
+            bId = init2local.at(my_vtx[i]);
+            domain.neighborNum[bId] = my_xadj[i + 1] - my_xadj[i] + 1;
+            const OCP_DBL* conn_ptr = conn_loc[bId];
+            for (USI j = my_xadj[i]; j < my_xadj[i + 1]; j++) {
+                const auto& iter = init2local.find(my_edge[j]);
+                if (iter != init2local.end()) {
+                    // bulk connection
+                    eId = iter->second;
+                    if (eId > bId) {
+#if OCPGRID_NORMAL
+                        dst->push_back(BulkConnPair(bId, eId, static_cast<ConnDirect>(conn_ptr[0]), conn_ptr[1], conn_ptr[2], conn_ptr[3]));
+#elif OCPGRID_DXDYDZ
+                        OCP_ABORT("OCPGRID_DXDYDZ mode is not available for distributed input");
+#endif
+                    }
+                }
+                else {
+                    // well connection
+                    const USI wIndex = my_edge[j] - global_well_start;
+                    const USI len    = domain.wellWPB.size();
+                    USI w = 0;
+                    for (w = 0; w < len; w++) {
+                        if (wIndex == domain.wellWPB[w][0]) {
+                            domain.wellWPB[w].push_back(static_cast<OCP_USI>(conn_ptr[0]));
+                            domain.wellWPB[w].push_back(bId);
+                            break;
+                        }
+                    }
+                    if (w == len) {
+                        domain.wellWPB.push_back(vector<OCP_USI>{
+                            wIndex, static_cast<OCP_USI>(conn_ptr[0]), bId});
+                    }
+                }
+                conn_ptr += varNumEdge;
+            }
+        }
+    }
+    conn.numConn = conn.iteratorConn.size();
+
+    // Free grid Memory
+    mygrid.FreeMemory();
+}
+
+
 void Reservoir::SetupDistParamOthers(const ParamRead& param)
 {
     if (CURRENT_RANK == MASTER_PROCESS) {
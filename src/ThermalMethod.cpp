@@ -41,6 +41,18 @@ void T_FIM::InitReservoir(Reservoir& rs)
 
 void T_FIM::Prepare(Reservoir& rs, const OCPControl& ctrl)
 {
+    // Extrapolate initial guess from converged states
+    if (ctrl.NR.GetGuess() != OCPNRGuess::last) {
+        NR.SaveHistory(rs, ctrl.time.GetCurrentTime(), ctrl.time.GetWellChangeTime());
+        const USI order = ctrl.NR.GetGuess() == OCPNRGuess::linear ? 1 : 2;
+        if (NR.Extrapolate(rs, ctrl.time.GetCurrentDt(), order, ctrl.NR.DPmax())) {
+            CalRock(rs.bulk);
+            CalFlash(rs.bulk);
+            CalKrPc(rs.bulk);
+            rs.conn.optMs.heatConduct.CalConductCoeff(rs.bulk.vs);
+            rs.bulk.BOUNDm.heatLoss.CalHeatLoss(rs.bulk.vs, ctrl.time.GetCurrentTime() + ctrl.time.GetCurrentDt(), ctrl.time.GetCurrentDt());
+        }
+    }
     rs.allWells.PrepareWell(rs.bulk);
     CalRes(rs, ctrl.time.GetCurrentDt(), OCP_TRUE);
     NR.InitStep(rs.bulk.GetVarSet());
@@ -344,6 +356,8 @@ void T_FIM::InitFlash(Bulk& bk)
 
 void T_FIM::CalFlash(Bulk& bk)
 {
+    OCP_PROFILE("Flash");
+    OCP_HWCOUNT(flash);
     const BulkVarSet& bvs = bk.vs;
     const OCP_USI&    nb  = bvs.nb;
 
@@ -571,6 +585,8 @@ void T_FIM::UpdateLastTimeStep(Reservoir& rs) const
 
 void T_FIM::CalRes(Reservoir& rs, const OCP_DBL& dt, const OCP_BOOL& initRes0)
 {
+    OCP_PROFILE("Residual");
+    OCP_HWCOUNT(flux);
     const Bulk& bk   = rs.bulk;
     const BulkVarSet& bvs = bk.vs;
     const USI   nb   = bvs.nbI;
@@ -692,6 +708,8 @@ void T_FIM::AssembleMatBulks(LinearSystem&    ls,
                              const Reservoir& rs,
                              const OCP_DBL&   dt) const
 {
+    OCP_PROFILE("AssembleBulk");
+    OCP_HWCOUNT(assembleBulk);
     const USI numWell = rs.GetNumOpenWell();
 
     const Bulk&     bk     = rs.bulk;
@@ -773,6 +791,8 @@ void T_FIM::AssembleMatWells(LinearSystem&    ls,
                              const Reservoir& rs,
                              const OCP_DBL&   dt) const
 {
+    OCP_PROFILE("AssembleWell");
+    OCP_HWCOUNT(assembleWell);
     for (auto& wl : rs.allWells.wells) {
         wl->AssembleMatFIM(ls, rs.bulk, dt);
     }
@@ -783,6 +803,7 @@ void T_FIM::GetSolution(Reservoir&       rs,
                         vector<OCP_DBL>& u,
                         const ControlNR& ctrlNR)
 {
+    OCP_PROFILE("GetSolution");
 
     const Domain&   domain = rs.domain;
     Bulk&           bk     = rs.bulk;
@@ -22,6 +22,7 @@ void ThermalSolver::InitReservoir(Reservoir& rs) { fim.InitReservoir(rs); }
 
 void ThermalSolver::Prepare(Reservoir& rs, const OCPControl& ctrl)
 {
+    OCP_PROFILE("Prepare");
     fim.Prepare(rs, ctrl);
 }
 
@@ -33,6 +34,7 @@ const OCPNRsuite& ThermalSolver::GoOneStep(Reservoir& rs, OCPControl& ctrl)
 
     // Time marching with adaptive time stepsize
     while (OCP_TRUE) {
+        OCP_PROFILE("Newton");
         if (ctrl.time.GetCurrentDt() < MIN_TIME_CURSTEP) {
             if (CURRENT_RANK == MASTER_PROCESS)
                 OCP_WARNING("Time stepsize is too small: " + to_string(ctrl.time.GetCurrentDt()) + TIMEUNIT);
@@ -60,6 +62,7 @@ const OCPNRsuite& ThermalSolver::GoOneStep(Reservoir& rs, OCPControl& ctrl)
 
 void ThermalSolver::AssembleMat(const Reservoir& rs, OCPControl& ctrl)
 {
+    OCP_PROFILE("Assemble");
     GetWallTime timer;
     timer.Start();
 
@@ -70,12 +73,14 @@ void ThermalSolver::AssembleMat(const Reservoir& rs, OCPControl& ctrl)
 
 OCP_BOOL ThermalSolver::SolveLinearSystem(Reservoir& rs, OCPControl& ctrl)
 {
+    OCP_PROFILE("LinearSolver");
     return fim.SolveLinearSystem(LSolver, rs, ctrl);
 }
 
 /// Update properties of fluid.
 OCP_BOOL ThermalSolver::UpdateProperty(Reservoir& rs, OCPControl& ctrl)
 {
+    OCP_PROFILE("UpdateProperty");
     GetWallTime timer;
     timer.Start();
     OCP_BOOL flag = fim.UpdateProperty(rs, ctrl);
@@ -87,12 +92,14 @@ OCP_BOOL ThermalSolver::UpdateProperty(Reservoir& rs, OCPControl& ctrl)
 /// Finish the Newton-Raphson iteration.
 OCP_BOOL ThermalSolver::FinishNR(Reservoir& rs, OCPControl& ctrl)
 {
+    OCP_PROFILE("FinishNR");
     return fim.FinishNR(rs, ctrl);
 }
 
 /// Finish the current time step.
 void ThermalSolver::FinishStep(Reservoir& rs, OCPControl& ctrl)
 {
+    OCP_PROFILE("FinishStep");
     fim.FinishStep(rs, ctrl);
 }
 
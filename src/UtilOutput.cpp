@@ -26,6 +26,27 @@ string GetIJKformat(const USI& i, const USI& j, const USI& k, const USI& s)
     return GetIJKformat(to_string(i), to_string(j), to_string(k), s);
 }
 
+
+void OCPAsyncWriter::Launch(function<void()> task)
+{
+    // the run stalls only if the previous task is not finished
+    Wait();
+    if (ifAsync) {
+        running = async(launch::async, move(task));
+    }
+    else {
+        task();
+    }
+}
+
+
+void OCPAsyncWriter::Wait()
+{
+    if (running.valid()) {
+        running.get();
+    }
+}
+
 /*----------------------------------------------------------------------------*/
 /*  Brief Change History of This File                                         */
 /*----------------------------------------------------------------------------*/
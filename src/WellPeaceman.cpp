@@ -241,6 +241,16 @@ OCP_DBL PeacemanWell::CalMaxChangeNR()
 }
 
 
+void PeacemanWell::SetBHP(const OCP_DBL& p, const OCP_DBL& NRp)
+{
+    if (opt.state != WellState::open)  return;
+
+    bhp   = p;
+    NRbhp = NRp;
+    CalPerfP();
+}
+
+
 void PeacemanWell::ResetToLastTimeStep(const Bulk& bk)
 {
     if (opt.state != WellState::open)  return;
@@ -1592,6 +1602,151 @@ void PeacemanWellIsoT::AssembleMatProdFIM(LinearSystem& ls, const Bulk& bk, cons
 }
 
 
+/// Total volume flow rates of perforations from the pressure stage are fixed, the
+/// perforation pressure of producers is shifted to keep them.
+void PeacemanWellIsoT::CalFluxSFI(const Bulk& bk)
+{
+    // flow rates of injectors are fixed with the injected fluid
+    if (opt.state != WellState::open || opt.type == WellType::injector)  return;
+
+    const BulkVarSet& bvs = bk.vs;
+
+    CalTrans(bk);
+    fill(qi_lbmol.begin(), qi_lbmol.end(), 0.0);
+
+    for (USI p = 0; p < numPerf; p++) {
+        const OCP_USI k = perf[p].location;
+        fill(perf[p].qi_lbmol.begin(), perf[p].qi_lbmol.end(), 0.0);
+        fill(perf[p].qj_ft3.begin(), perf[p].qj_ft3.end(), 0.0);
+
+        OCP_DBL lambdaT = 0;
+        OCP_DBL qt      = 0;
+        for (USI j = 0; j < np; j++) {
+            const OCP_USI id = k * np + j;
+            if (bvs.phaseExist[id]) {
+                perf[p].qj_ft3[j] = perf[p].transj[j] * (bvs.Pj[id] - perf[p].P);
+                qt      += perf[p].qj_ft3[j];
+                lambdaT += perf[p].transj[j];
+            }
+        }
+        if (lambdaT <= 0)  continue;
+
+        const OCP_DBL s = (perf[p].qt_ft3 - qt) / lambdaT;
+        for (USI j = 0; j < np; j++) {
+            const OCP_USI id = k * np + j;
+            if (bvs.phaseExist[id]) {
+                perf[p].qj_ft3[j] += perf[p].transj[j] * s;
+                const OCP_DBL xi = bvs.xi[id];
+                for (USI i = 0; i < nc; i++) {
+                    perf[p].qi_lbmol[i] += perf[p].qj_ft3[j] * xi * bvs.xij[id * nc + i];
+                }
+            }
+        }
+        for (USI i = 0; i < nc; i++) qi_lbmol[i] += perf[p].qi_lbmol[i];
+    }
+}
+
+
+/// Derivatives of producers with fixed total volume flow rates are the ones of FIM at
+/// the shifted perforation pressure Pw, minus ci * dQt/dX, where dPw/dX = dQt/dX / lambdaT
+/// and ci = sum_j transj * xi_j * xij / lambdaT. Only the bulk diagonal is needed since
+/// pressure and BHP are not unknowns of transport.
+void PeacemanWellIsoT::AssembleMatSFI(LinearSystem& ls, const Bulk& bk, const OCP_DBL& dt) const
+{
+    if (opt.state != WellState::open)  return;
+
+    const BulkVarSet& bvs = bk.vs;
+
+    const USI ncol   = nc + 1;
+    const USI ncol2  = np * nc + np;
+    const USI bsize  = ncol * ncol;
+    const USI bsize2 = ncol * ncol2;
+
+    vector<OCP_DBL> bmat(bsize, 0);
+    vector<OCP_DBL> dQdXsB(bsize2, 0);
+    vector<OCP_DBL> dQtdXs(ncol2, 0);
+    vector<OCP_DBL> ci(nc, 0);
+
+    // The row of well is dropped in the reduction of transport
+    const OCP_USI wId = ls.AddDim(1) - 1;
+    ls.NewDiag(wId, bmat);
+
+    if (opt.type == WellType::injector)  return;
+
+    OCP_DBL xij, xi, mu, dP, tmp;
+
+    for (USI p = 0; p < numPerf; p++) {
+        const OCP_USI n = perf[p].location;
+        fill(dQdXsB.begin(), dQdXsB.end(), 0.0);
+        fill(dQtdXs.begin(), dQtdXs.end(), 0.0);
+        fill(ci.begin(), ci.end(), 0.0);
+
+        OCP_DBL lambdaT = 0;
+        OCP_DBL shift   = perf[p].qt_ft3;
+        for (USI j = 0; j < np; j++) {
+            const OCP_USI n_np_j = n * np + j;
+            if (bvs.phaseExist[n_np_j]) {
+                lambdaT += perf[p].transj[j];
+                shift   -= perf[p].transj[j] * (bvs.Pj[n_np_j] - perf[p].P);
+            }
+        }
+        if (lambdaT <= 0)  continue;
+        shift /= lambdaT;
+
+        for (USI j = 0; j < np; j++) {
+            const OCP_USI n_np_j = n * np + j;
+            if (!bvs.phaseExist[n_np_j]) continue;
+
+            // shifted pressure difference
+            dP = bvs.Pj[n_np_j] - perf[p].P + shift;
+            xi = bvs.xi[n_np_j];
+            mu = bvs.mu[n_np_j];
+
+            // dQt / dS
+            for (USI k = 0; k < np; k++) {
+                dQtdXs[k] += perf[p].WI * perf[p].multiplier * dP / mu * bvs.dKrdS[n_np_j * np + k]
+                           + perf[p].transj[j] * bvs.dPcdS[n_np_j * np + k];
+            }
+            // dQt / dCij
+            for (USI k = 0; k < nc; k++) {
+                dQtdXs[np + j * nc + k] -= dP * perf[p].transj[j] / mu * bvs.mux[n_np_j * nc + k];
+            }
+
+            for (USI i = 0; i < nc; i++) {
+                xij    = bvs.xij[n_np_j * nc + i];
+                ci[i] += perf[p].transj[j] * xi * xij / lambdaT;
+                // dQ / dS
+                for (USI k = 0; k < np; k++) {
+                    tmp = perf[p].WI * perf[p].multiplier * dP / mu * xi *
+                        xij * bvs.dKrdS[n_np_j * np + k];
+                    // capillary pressure
+                    tmp += perf[p].transj[j] * xi * xij * bvs.dPcdS[n_np_j * np + k];
+                    dQdXsB[(i + 1) * ncol2 + k] += tmp;
+                }
+                // dQ / dCij
+                for (USI k = 0; k < nc; k++) {
+                    tmp = dP * perf[p].transj[j] * xij *
+                        (bvs.xix[n_np_j * nc + k] - xi / mu * bvs.mux[n_np_j * nc + k]);
+                    dQdXsB[(i + 1) * ncol2 + np + j * nc + k] += tmp;
+                }
+                dQdXsB[(i + 1) * ncol2 + np + j * nc + i] +=
+                    perf[p].transj[j] * xi * dP;
+            }
+        }
+        // total volume flow rate is fixed
+        for (USI i = 0; i < nc; i++) {
+            Daxpy(ncol2, -ci[i], dQtdXs.data(), &dQdXsB[(i + 1) * ncol2]);
+        }
+
+        // Bulk - Bulk -- add
+        fill(bmat.begin(), bmat.end(), 0.0);
+        DaABpbC(ncol, ncol, ncol2, dt, dQdXsB.data(), &bvs.dSec_dPri[n * bsize2], 1,
+            bmat.data());
+        ls.AddDiag(n, bmat);
+    }
+}
+
+
 void PeacemanWellIsoT::AssembleMatIMPEC(LinearSystem& ls, const Bulk& bk, const OCP_DBL& dt) const
 {
     if (opt.state == WellState::open) {